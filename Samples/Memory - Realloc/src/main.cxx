@@ -0,0 +1,104 @@
+#include <srl.hpp>
+
+extern "C" {
+    #include <sega_tim.h>
+}
+
+// Using to shorten names for HighColor
+using namespace SRL::Types;
+
+// Number of times the list grows
+constexpr size_t Steps = 128;
+
+// Number of bytes list grows by in each step
+constexpr size_t StepSize = 24;
+
+// Grows list with Realloc, block can grow into free space right after it
+uint16_t GrowWithRealloc(uint8_t** blockers)
+{
+    uint8_t* list = reinterpret_cast<uint8_t*>(SRL::Memory::HighWorkRam::Malloc(StepSize));
+
+    TIM_FRT_SET_16(0);
+
+    for (size_t step = 2; step <= Steps; step++)
+    {
+        list = reinterpret_cast<uint8_t*>(SRL::Memory::HighWorkRam::Realloc(list, step * StepSize));
+
+        // Some other object gets allocated every few frames
+        if ((step & 15) == 0)
+        {
+            blockers[step >> 4] = reinterpret_cast<uint8_t*>(SRL::Memory::HighWorkRam::Malloc(32));
+        }
+    }
+
+    uint16_t ticks = TIM_FRT_GET_16();
+    SRL::Memory::HighWorkRam::Free(list);
+    return ticks;
+}
+
+// Grows list by allocating new block, copying old data into it and freeing old block
+uint16_t GrowWithCopy(uint8_t** blockers)
+{
+    uint8_t* list = reinterpret_cast<uint8_t*>(SRL::Memory::HighWorkRam::Malloc(StepSize));
+
+    TIM_FRT_SET_16(0);
+
+    for (size_t step = 2; step <= Steps; step++)
+    {
+        uint8_t* larger = reinterpret_cast<uint8_t*>(SRL::Memory::HighWorkRam::Malloc(step * StepSize));
+        slDMACopy(list, larger, (step - 1) * StepSize);
+        slDMAWait();
+        SRL::Memory::HighWorkRam::Free(list);
+        list = larger;
+
+        // Some other object gets allocated every few frames
+        if ((step & 15) == 0)
+        {
+            blockers[step >> 4] = reinterpret_cast<uint8_t*>(SRL::Memory::HighWorkRam::Malloc(32));
+        }
+    }
+
+    uint16_t ticks = TIM_FRT_GET_16();
+    SRL::Memory::HighWorkRam::Free(list);
+    return ticks;
+}
+
+// Free objects allocated during the test
+void FreeBlockers(uint8_t** blockers)
+{
+    for (size_t blocker = 0; blocker <= (Steps >> 4); blocker++)
+    {
+        SRL::Memory::HighWorkRam::Free(blockers[blocker]);
+        blockers[blocker] = nullptr;
+    }
+}
+
+// Main program entry
+int main()
+{
+    SRL::Core::Initialize(HighColor(20, 10, 50));
+    SRL::Debug::Print(1, 1, "Realloc benchmark");
+    SRL::Debug::Print(1, 2, "%d steps, %d bytes each", Steps, StepSize);
+
+    // Count in 128 cycle steps
+    TIM_FRT_INIT(TIM_CKS_128);
+
+    uint8_t* blockers[(Steps >> 4) + 1] = { nullptr };
+    uint16_t copyTicks = GrowWithCopy(blockers);
+    FreeBlockers(blockers);
+
+    uint16_t reallocTicks = GrowWithRealloc(blockers);
+    FreeBlockers(blockers);
+
+    SRL::Debug::Print(1, 4, "Malloc+copy+free: %d ticks", copyTicks);
+    SRL::Debug::Print(1, 5, "Realloc:          %d ticks", reallocTicks);
+    SRL::Debug::Print(1, 7, "1 tick = 128 CPU cycles");
+
+    // Main program loop
+    while (1)
+    {
+        SRL::Core::Synchronize();
+    }
+
+    return 0;
+}
@@ -5,6 +5,7 @@
 #include "vector.h"
 //#include "string.h"
 #include "algorithm.h"
+#include "memory_resource.h"
 
 using namespace SRL::Types;
 using namespace SRL::Math::Types;
@@ -20,6 +21,7 @@ int main()
   test_vector();
   //test_string();
   test_algorithm();
+  test_memory_resource();
 
   while (1)
   {
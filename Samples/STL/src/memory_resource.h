@@ -0,0 +1,32 @@
+#pragma once
+
+// Memory resources bound to SRL memory zones
+#include <srl_memory_resource.hpp>
+#include <vector>
+#include <list>
+
+static void test_memory_resource()
+{
+
+  // Cold data in low work RAM instead of the default high work RAM
+  std::pmr::vector<int> history(&SRL::LowWorkRamResource);
+
+  for (int i = 0; i < 32; i++)
+  {
+
+    history.push_back(i);
+  }
+
+  // List nodes come from a pool, allocations the pool cannot serve go to low work RAM
+  SRL::PoolResource<16> nodes(64, SRL::Memory::Zone::LWRam, &SRL::LowWorkRamResource);
+  std::pmr::list<int> queue(&nodes);
+
+  for (auto i : history)
+  {
+
+    queue.push_back(i);
+  }
+
+  SRL::Debug::Print(1, 3, "pmr vector in LWRam: %d", SRL::Memory::LowWorkRam::InRange(history.data()));
+  SRL::Debug::Print(1, 4, "pmr list nodes in pool: %d", nodes.GetCount());
+}
@@ -87,6 +87,151 @@ extern "C"
         mu_assert(exists, buffer);
     }
 
+    // Completion callback of asynchronous read test
+    static int32_t cd_test_async_completed = 0;
+
+    static void cd_test_async_on_completed(SRL::Cd::ReadRequest& request)
+    {
+        cd_test_async_completed = request.GetResult();
+    }
+
+    // Test: Verify that a file can be read in the background and completion is reported.
+    MU_TEST(cd_test_read_file_async)
+    {
+        const char *filename = "CD_UT.TXT";
+
+        SRL::Cd::File file(filename);
+        SRL::Cd::ReadRequest request;
+        alignas(4) char byteBuffer[2048];
+        SRL::Memory::MemSet(byteBuffer, '\0', sizeof(byteBuffer));
+
+        cd_test_async_completed = 0;
+        request.OnCompleted += cd_test_async_on_completed;
+
+        bool started = file.LoadBytesAsync(request, 0, file.Size.Bytes, byteBuffer);
+        snprintf(buffer, buffer_size, "File '%s' : Async read did not start", filename);
+        mu_assert(started, buffer);
+
+        // Pump requests like the game loop would
+        for (int32_t frame = 0; frame < 600 && !request.IsDone(); frame++)
+        {
+            SRL::Cd::Update();
+        }
+
+        snprintf(buffer, buffer_size, "File '%s' : Async read did not complete : %d", filename, request.GetResult());
+        mu_assert(request.GetStatus() == SRL::Cd::ReadRequest::Status::Completed, buffer);
+
+        snprintf(buffer, buffer_size, "File '%s' : Completion callback got %d", filename, cd_test_async_completed);
+        mu_assert(cd_test_async_completed == file.Size.Bytes, buffer);
+
+        snprintf(buffer, buffer_size, "File '%s' : Async read returned wrong data", filename);
+        mu_assert(strncmp(byteBuffer, "UT1\nUT12\nUT123", 14) == 0, buffer);
+        mu_assert(!SRL::Cd::IsBusy(), "Read queue is not empty");
+    }
+
+    // Trace handler of file access trace test
+    static SRL::Cd::TraceEvent cd_test_trace_events[4];
+    static int32_t cd_test_trace_count = 0;
+
+    static void cd_test_trace_handler(const SRL::Cd::TraceEvent& event)
+    {
+        if (cd_test_trace_count < 4)
+        {
+            cd_test_trace_events[cd_test_trace_count] = event;
+        }
+
+        cd_test_trace_count++;
+    }
+
+    // Test: Verify that background load from given offset does not move file access pointer.
+    MU_TEST(cd_test_load_async_keeps_position)
+    {
+        const char *filename = "CD_UT.TXT";
+
+        SRL::Cd::File file(filename);
+        mu_assert(file.Open(), "File did not open");
+
+        char line[16] = { 0 };
+        mu_assert(file.Read(4, line) == 4, "First read failed");
+
+        SRL::Cd::ReadRequest request;
+        alignas(4) char byteBuffer[2048];
+        mu_assert(file.LoadBytesAsync(request, 0, file.Size.Bytes, byteBuffer), "Async load did not start");
+
+        for (int32_t frame = 0; frame < 600 && !request.IsDone(); frame++)
+        {
+            SRL::Cd::Update();
+        }
+
+        mu_assert(request.GetStatus() == SRL::Cd::ReadRequest::Status::Completed, "Async load did not complete");
+
+        snprintf(buffer, buffer_size, "File '%s' : Access pointer moved to %d", filename, file.GetCurrentPosition());
+        mu_assert(file.GetCurrentPosition() == 4, buffer);
+
+        int32_t read = file.Read(5, line);
+        snprintf(buffer, buffer_size, "File '%s' : Read after async load failed: %d bytes '%s'", filename, read, line);
+        mu_assert(read == 5 && strncmp(line, "UT12\n", 5) == 0, buffer);
+    }
+
+    // Test: Verify that destroying a file cancels its queued request, even when the file was never opened.
+    MU_TEST(cd_test_close_cancels_queued_request)
+    {
+        SRL::Cd::ReadRequest request;
+        alignas(4) char byteBuffer[2048];
+
+        {
+            SRL::Cd::File file("CD_UT.TXT");
+            mu_assert(file.LoadBytesAsync(request, 0, file.Size.Bytes, byteBuffer), "Async load was not queued");
+            mu_assert(file.Handle == nullptr, "File was opened by queueing a request");
+        }
+
+        snprintf(buffer, buffer_size, "Request of destroyed file was not cancelled: status %d", static_cast<int32_t>(request.GetStatus()));
+        mu_assert(request.GetStatus() == SRL::Cd::ReadRequest::Status::Failed, buffer);
+        mu_assert(!SRL::Cd::IsBusy(), "Read queue is not empty");
+
+        // Queue must not reference the destroyed file anymore
+        SRL::Cd::Update();
+    }
+
+    // Test: Verify that background reads into buffer that is not 4 byte aligned are rejected.
+    MU_TEST(cd_test_async_unaligned_destination)
+    {
+        SRL::Cd::File file("CD_UT.TXT");
+        SRL::Cd::ReadRequest request;
+        alignas(4) char byteBuffer[2048 + 4];
+
+        mu_assert(!file.LoadBytesAsync(request, 0, file.Size.Bytes, byteBuffer + 1), "Async load into unaligned buffer was queued");
+        mu_assert(!SRL::Cd::IsBusy(), "Read queue is not empty");
+    }
+
+    // Test: Verify that open, seek and read of a file are reported to the trace handler.
+    MU_TEST(cd_test_trace_file)
+    {
+        const char *filename = "CD_UT.TXT";
+        char byteBuffer[16];
+
+        cd_test_trace_count = 0;
+        SRL::Cd::SetTraceHandler(cd_test_trace_handler);
+
+        SRL::Cd::File file(filename);
+        file.Open();
+        file.Seek(4);
+        file.Read(5, byteBuffer);
+        file.Close();
+
+        SRL::Cd::SetTraceHandler(nullptr);
+
+        snprintf(buffer, buffer_size, "File '%s' : %d accesses traced instead of 3", filename, cd_test_trace_count);
+        mu_assert(cd_test_trace_count == 3, buffer);
+
+        mu_assert(cd_test_trace_events[0].Operation == SRL::Cd::TraceOperation::Open, "First traced access is not open");
+        mu_assert(cd_test_trace_events[1].Operation == SRL::Cd::TraceOperation::Seek && cd_test_trace_events[1].Offset == 4, "Second traced access is not seek to 4");
+        mu_assert(cd_test_trace_events[2].Operation == SRL::Cd::TraceOperation::Read && cd_test_trace_events[2].Offset == 4 && cd_test_trace_events[2].Size == 5, "Third traced access is not read of 5 bytes at 4");
+
+        snprintf(buffer, buffer_size, "File '%s' : Traced name is '%s'", filename, cd_test_trace_events[0].Name);
+        mu_assert(cd_test_trace_events[0].Name != nullptr && strncmp(cd_test_trace_events[0].Name, filename, 9) == 0, buffer);
+    }
+
     // Test: Verify that a file can be read and its contents match expected values.
     MU_TEST(cd_test_read_file)
     {
@@ -159,6 +304,137 @@ extern "C"
         mu_assert(accessPointer > 0, buffer);
     }
 
+    // Test: Verify entries of a pack built from cd/packs/UTPACK can be found and loaded.
+    MU_TEST(cd_pack_test_load)
+    {
+        const char *filename = "UTPACK.PAK";
+        Cd::Pack pack(filename);
+
+        bool valid = pack.IsValid();
+        snprintf(buffer, buffer_size, "Pack '%s' did not open", filename);
+        mu_assert(valid, buffer);
+
+        uint32_t count = pack.GetCount();
+        snprintf(buffer, buffer_size, "Pack '%s' has %d entries instead of 2", filename, count);
+        mu_assert(count == 2, buffer);
+
+        char data[3072];
+        SRL::Memory::MemSet(data, '\0', sizeof(data));
+
+        // Lookup is case insensitive
+        int32_t size = pack.Load("hello.txt", data);
+        snprintf(buffer, buffer_size, "Pack entry HELLO.TXT was not loaded: %d", size);
+        mu_assert(size == 11 && strncmp(data, "Hello pack", 10) == 0, buffer);
+
+        constexpr uint32_t linesHash = Cd::Pack::Hash("DATA/LINES.TXT");
+        const Cd::Pack::Entry* entry = pack.Find(linesHash);
+        snprintf(buffer, buffer_size, "Pack entry DATA/LINES.TXT was not found");
+        mu_assert(entry != nullptr && entry->Size == 3000, buffer);
+
+        size = pack.Load(*entry, data);
+        snprintf(buffer, buffer_size, "Pack entry DATA/LINES.TXT was not loaded: %d", size);
+        mu_assert(size == 3000, buffer);
+
+        // Line 50 is in the second sector of the entry
+        snprintf(buffer, buffer_size, "Pack entry DATA/LINES.TXT has wrong data: %.20s", data + (50 * 30));
+        mu_assert(strncmp(data + (50 * 30), "Line 050", 8) == 0, buffer);
+
+        const Cd::Pack::Entry* missing = pack.Find("MISSING.TXT");
+        snprintf(buffer, buffer_size, "Pack entry MISSING.TXT was found but should not");
+        mu_assert(missing == nullptr, buffer);
+    }
+
+    // Test: Verify compressed file is decompressed correctly by both CPUs.
+    MU_TEST(cd_lz4_test_load)
+    {
+        const char *filename = "LINES.LZ4";
+        Cd::File file(filename);
+
+        bool exists = file.Exists();
+        snprintf(buffer, buffer_size, "File '%s' does not exist but should", filename);
+        mu_assert(exists, buffer);
+
+        for (int32_t useSlave = 0; useSlave < 2; useSlave++)
+        {
+            int32_t size;
+            char* data = reinterpret_cast<char*>(Lz4::Load(file, size, Memory::Zone::HWRam, useSlave != 0));
+
+            snprintf(buffer, buffer_size, "File '%s' decompressed to %d bytes instead of 3000 (slave %d)", filename, size, useSlave);
+            mu_assert(data != nullptr && size == 3000, buffer);
+
+            // File was made from cd/packs/UTPACK/DATA/LINES.TXT
+            snprintf(buffer, buffer_size, "File '%s' has wrong data: %.20s (slave %d)", filename, data + (99 * 30), useSlave);
+            mu_assert(strncmp(data, "Line 000", 8) == 0 && strncmp(data + (99 * 30), "Line 099", 8) == 0, buffer);
+
+            delete[] data;
+        }
+    }
+
+    // Test: Verify that interleaved stream sends every channel into its own ring buffer.
+    MU_TEST(cd_stream_test_channels)
+    {
+        const char *filename = "STREAM.ILV";
+        Cd::File file(filename);
+        Stream stream(file);
+
+        // File was made from cd/packs/UTPACK/DATA/LINES.TXT (channel 0), cd/packs/UTPACK/HELLO.TXT (channel 3) and CD_UT.TXT (channel 5)
+        snprintf(buffer, buffer_size, "Stream '%s' did not open", filename);
+        mu_assert(stream.IsValid(), buffer);
+
+        Stream::Channel* lines = stream.OpenChannel(0, 4096);
+        Stream::Channel* hello = stream.OpenChannel(3, 2048, Memory::Zone::LWRam);
+        mu_assert(lines != nullptr && hello != nullptr, "Channel buffers were not allocated");
+        mu_assert(stream.Start(), "Stream did not start");
+
+        for (int32_t pass = 0; pass < 100000 && stream.GetStatistics().Sectors + stream.GetStatistics().Skipped < 4; pass++)
+        {
+            Stream::Update();
+        }
+
+        stream.Stop();
+
+        const Stream::Statistics& statistics = stream.GetStatistics();
+        snprintf(buffer, buffer_size, "Stream '%s' : %d sectors transferred, %d skipped", filename, statistics.Sectors, statistics.Skipped);
+        mu_assert(statistics.Sectors == 3 && statistics.Skipped == 1, buffer);
+
+        char data[3000];
+        int32_t size = lines->Read(sizeof(data), data);
+        snprintf(buffer, buffer_size, "Channel 0 has wrong data: %d bytes, %.20s", size, data + (99 * 30));
+        mu_assert(size == 3000 && strncmp(data, "Line 000", 8) == 0 && strncmp(data + (99 * 30), "Line 099", 8) == 0, buffer);
+
+        size = hello->Read(sizeof(data), data);
+        mu_assert(size == 11 && strncmp(data, "Hello pack\n", 11) == 0, "Channel 3 has wrong data");
+        mu_assert(lines->IsEnded() && hello->IsEnded(), "Channels did not end");
+    }
+
+    // Test: Verify that stream opens file from other directory through the path index.
+    MU_TEST(cd_stream_test_subdirectory)
+    {
+        // Copy of STREAM.ILV, its identifier is valid only in ROOT directory
+        const char *path = "ROOT/STREAM.ILV";
+        Cd::File file(path);
+        Stream stream(file);
+
+        snprintf(buffer, buffer_size, "Stream '%s' did not open", path);
+        mu_assert(stream.IsValid(), buffer);
+
+        Stream::Channel* hello = stream.OpenChannel(3, 2048, Memory::Zone::LWRam);
+        mu_assert(hello != nullptr, "Channel buffer was not allocated");
+        mu_assert(stream.Start(), "Stream did not start");
+
+        for (int32_t pass = 0; pass < 100000 && stream.GetStatistics().Sectors + stream.GetStatistics().Skipped < 4; pass++)
+        {
+            Stream::Update();
+        }
+
+        stream.Stop();
+
+        char data[16];
+        int32_t size = hello->Read(sizeof(data), data);
+        snprintf(buffer, buffer_size, "Stream '%s' channel 3 has wrong data: %d bytes", path, size);
+        mu_assert(size == 11 && strncmp(data, "Hello pack\n", 11) == 0, buffer);
+    }
+
     // Test: File reading
     MU_TEST(cd_test_read_file2)
     {
@@ -241,6 +517,161 @@ extern "C"
         mu_assert(accessPointer > 0, buffer);
     }
 
+    // Test: Verify files in other directories open by path through the path index.
+    MU_TEST(cd_path_index_test_open)
+    {
+        const char *path = "ROOT/FILE.TXT";
+        mu_assert(Cd::PathIndex::IsEnabled(), "Path index was not built");
+
+        Cd::File file(path);
+        snprintf(buffer, buffer_size, "File '%s' does not exist but should", path);
+        mu_assert(file.Exists(), buffer);
+
+        // GFS loads whole sectors
+        char* data = new char[2048];
+        int32_t size = file.LoadBytes(0, 15, data);
+        bool matches = strncmp(data, "ExpectedContent", 15) == 0;
+        delete[] data;
+        snprintf(buffer, buffer_size, "File '%s' has wrong data: %d bytes", path, size);
+        mu_assert(size == 15 && matches, buffer);
+
+        // Same file from its own directory, root directory file by absolute path
+        Cd::ChangeDir("ROOT");
+        Cd::File local("file.txt");
+        Cd::File absolute("/CD_UT.TXT");
+        mu_assert(local.Exists() && local.Size.Bytes == file.Size.Bytes, "File was not found relative to current directory");
+        mu_assert(absolute.Exists(), "File was not found by absolute path");
+    }
+
+    MU_TEST(cd_handle_pool_test_alternate)
+    {
+        const char *filename = "CD_UT.TXT";
+        const char *path = "ROOT/FILE.TXT";
+        Cd::HandlePool::ResetStatistics();
+
+        Cd::File file(filename);
+        Cd::File other(path);
+        mu_assert(file.Open(), "File did not open");
+
+        char line[16] = { 0 };
+        int32_t read = file.Read(4, line);
+        snprintf(buffer, buffer_size, "First read from '%s' failed: %d bytes '%s'", filename, read, line);
+        mu_assert(read == 4 && strncmp(line, "UT1\n", 4) == 0, buffer);
+
+        // Loading other file may take the handle, but must not move access pointer of the open file
+        char* data = new char[2048];
+        int32_t size = other.LoadBytes(0, 15, data);
+        bool matches = strncmp(data, "ExpectedContent", 15) == 0;
+        delete[] data;
+        snprintf(buffer, buffer_size, "File '%s' has wrong data: %d bytes", path, size);
+        mu_assert(size == 15 && matches, buffer);
+
+        snprintf(buffer, buffer_size, "File '%s' lost its position: %d", filename, file.GetCurrentPosition());
+        mu_assert(file.IsOpen() && file.GetCurrentPosition() == 4, buffer);
+
+        read = file.Read(5, line);
+        snprintf(buffer, buffer_size, "Second read from '%s' failed: %d bytes '%s'", filename, read, line);
+        mu_assert(read == 5 && strncmp(line, "UT12\n", 5) == 0, buffer);
+
+        const Cd::HandlePool::Statistics& statistics = Cd::HandlePool::GetStatistics();
+        snprintf(buffer, buffer_size, "Unexpected pool statistics: %d opens, %d evictions", statistics.Opens, statistics.Evictions);
+        mu_assert(statistics.Opens >= 2 && statistics.Opens <= 3, buffer);
+        mu_assert(Cd::HandlePool::Capacity > 1 || statistics.Evictions > 0, buffer);
+        mu_assert(Cd::HandlePool::GetOpenCount() <= Cd::HandlePool::Capacity, "Pool holds more handles than it can");
+    }
+
+    // Test: Verify that stream takes its handle out of the pool, file gets it back after the stream is closed.
+    MU_TEST(cd_handle_pool_test_reserve)
+    {
+        const char *filename = "CD_UT.TXT";
+        Cd::File file(filename);
+        mu_assert(file.Open(), "File did not open");
+
+        char line[16] = { 0 };
+        int32_t read = file.Read(4, line);
+        mu_assert(read == 4 && strncmp(line, "UT1\n", 4) == 0, "First read failed");
+
+        {
+            // With a single handle, stream can open only after the file gives its handle away
+            Cd::File streamFile("STREAM.ILV");
+            Stream stream(streamFile);
+            mu_assert(stream.IsValid(), "Stream did not open while pool held a handle");
+            mu_assert(Cd::HandlePool::Capacity > 1 || Cd::HandlePool::GetOpenCount() == 0, "Pool kept reserved handle");
+        }
+
+        read = file.Read(5, line);
+        snprintf(buffer, buffer_size, "Read from '%s' after stream failed: %d bytes '%s'", filename, read, line);
+        mu_assert(read == 5 && strncmp(line, "UT12\n", 5) == 0, buffer);
+    }
+
+    // Test: Verify that closing a pinned file lets its next handle be taken away again.
+    MU_TEST(cd_handle_pool_test_close_pinned)
+    {
+        const char *filename = "CD_UT.TXT";
+        const char *path = "ROOT/FILE.TXT";
+        Cd::File file(filename);
+        Cd::File other(path);
+
+        mu_assert(file.Open() && Cd::HandlePool::Pin(file), "File did not get pinned handle");
+        file.Close();
+
+        char line[16] = { 0 };
+        mu_assert(file.Open() && file.Read(4, line) == 4, "File did not open again");
+        Cd::HandlePool::ResetStatistics();
+
+        char* data = new char[2048];
+        int32_t size = other.LoadBytes(0, 15, data);
+        delete[] data;
+        snprintf(buffer, buffer_size, "File '%s' was not loaded: %d bytes", path, size);
+        mu_assert(size == 15, buffer);
+
+        const Cd::HandlePool::Statistics& statistics = Cd::HandlePool::GetStatistics();
+        snprintf(buffer, buffer_size, "Handle of '%s' stayed pinned: %d evictions", filename, statistics.Evictions);
+        mu_assert(Cd::HandlePool::Capacity > 1 || statistics.Evictions == 1, buffer);
+    }
+
+    MU_TEST(cd_asset_loader_test_read_file)
+    {
+        const char *filename = "CD_UT.TXT";
+        Cd::File file(filename);
+        AssetLoader::ReadFileJob job(file);
+        mu_assert(AssetLoader::Enqueue(job), "Job was not queued");
+        mu_assert(!AssetLoader::Enqueue(job), "Job was queued twice");
+
+        // Drive the loader the same way SRL::Core::Synchronize() does
+        for (int32_t frame = 0; frame < 600 && !job.IsDone(); frame++)
+        {
+            Cd::Update();
+            AssetLoader::Update();
+        }
+
+        snprintf(buffer, buffer_size, "Job did not complete: status %d, %d of %d bytes", static_cast<int32_t>(job.GetStatus()), job.GetProgress(), job.GetTotal());
+        mu_assert(job.GetStatus() == AssetLoader::Job::Status::Completed && job.GetProgress() == job.GetTotal(), buffer);
+
+        snprintf(buffer, buffer_size, "File '%s' has wrong data: '%s'", filename, job.GetData());
+        mu_assert(strcmp(reinterpret_cast<const char*>(job.GetData()), "UT1\nUT12\nUT123\n") == 0, buffer);
+        mu_assert(AssetLoader::IsIdle(), "Loader queue is not empty");
+    }
+
+    MU_TEST(cd_asset_loader_test_read_file_unaligned)
+    {
+        Cd::File file("CD_UT.TXT");
+        uint32_t* data = new uint32_t[(file.Size.Bytes / sizeof(uint32_t)) + 2];
+        AssetLoader::ReadFileJob job(file, reinterpret_cast<uint8_t*>(data) + 1);
+        mu_assert(AssetLoader::Enqueue(job), "Job was not queued");
+
+        for (int32_t frame = 0; frame < 600 && !job.IsDone(); frame++)
+        {
+            Cd::Update();
+            AssetLoader::Update();
+        }
+
+        delete[] data;
+        snprintf(buffer, buffer_size, "Job with unaligned buffer did not fail: status %d", static_cast<int32_t>(job.GetStatus()));
+        mu_assert(job.GetStatus() == AssetLoader::Job::Status::Failed, buffer);
+        mu_assert(AssetLoader::IsIdle(), "Loader queue is not empty");
+    }
+
     // Test: Verify behavior when attempting to open a null file.
     MU_TEST(cd_test_null_file)
     {
@@ -428,6 +859,162 @@ extern "C"
         mu_assert(result == Cd::ErrorCode::ErrorSeek, buffer);
     }
 
+    // Test: Verify reads going through work buffer and reads of whole sectors return same data.
+    MU_TEST(cd_file_read_test_sector_aligned)
+    {
+        const char *filename = "TESTFILE.UTS";
+        const int32_t length = 8 * 2048 + 100;
+
+        Cd::ChangeDir("ROOT");
+        Cd::File file(filename);
+
+        bool open = file.Open();
+        snprintf(buffer, buffer_size, "File '%s' does not open but should", filename);
+        mu_assert(open, buffer);
+
+        uint8_t* data = new uint8_t[length];
+        const int32_t offsets[] = { 100, 12 * 2048, 150, 12 * 2048 + 1 };
+
+        for (int32_t offset : offsets)
+        {
+            SRL::Memory::MemSet(data, 0xFF, length);
+
+            int32_t result = file.Seek(offset);
+            snprintf(buffer, buffer_size, "Seek to offset failed: %d != %d", result, offset);
+            mu_assert(result == offset, buffer);
+
+            int32_t bytesRead = file.Read(length, data);
+            snprintf(buffer, buffer_size, "Read at %d failed: %d != %d", offset, bytesRead, length);
+            mu_assert(bytesRead == length, buffer);
+
+            // File contains byte sequence 0, 1, ... 255, 0, 1, ...
+            int32_t mismatch = -1;
+
+            for (int32_t byte = 0; byte < length && mismatch < 0; byte++)
+            {
+                if (data[byte] != static_cast<uint8_t>(offset + byte))
+                {
+                    mismatch = byte;
+                }
+            }
+
+            snprintf(buffer, buffer_size, "Read at %d returned wrong data at byte %d", offset, mismatch);
+            mu_assert(mismatch < 0, buffer);
+        }
+
+        delete[] data;
+    }
+
+    // Test: Verify that repeated loads are served from sector cache and return same data.
+    MU_TEST(cd_sector_cache_test_reload)
+    {
+        const char *filename = "TESTFILE.UTS";
+        const int32_t length = 6 * 2048 + 100;
+
+        Cd::ChangeDir("ROOT");
+        Cd::File file(filename);
+
+        bool cached = Cd::SectorCache::Initialize(16, Memory::Zone::LWRam);
+        mu_assert(cached, "Sector cache was not created");
+
+        uint8_t* data = new uint8_t[length];
+
+        for (int32_t pass = 0; pass < 2; pass++)
+        {
+            Cd::SectorCache::ResetStatistics();
+            SRL::Memory::MemSet(data, 0xFF, length);
+
+            int32_t bytesRead = file.LoadBytes(3, length, data);
+            snprintf(buffer, buffer_size, "Load %d failed: %d != %d", pass, bytesRead, length);
+            mu_assert(bytesRead == length, buffer);
+
+            // File contains byte sequence 0, 1, ... 255, 0, 1, ...
+            int32_t mismatch = -1;
+
+            for (int32_t byte = 0; byte < length && mismatch < 0; byte++)
+            {
+                if (data[byte] != static_cast<uint8_t>(byte))
+                {
+                    mismatch = byte;
+                }
+            }
+
+            snprintf(buffer, buffer_size, "Load %d returned wrong data at byte %d", pass, mismatch);
+            mu_assert(mismatch < 0, buffer);
+        }
+
+        // Second load is served from the cache except the partially loaded last sector
+        const Cd::SectorCache::Statistics& statistics = Cd::SectorCache::GetStatistics();
+        snprintf(buffer, buffer_size, "Second load: %d hits, %d misses", statistics.Hits, statistics.Misses);
+        mu_assert(statistics.Hits == 6 && statistics.Misses == 1, buffer);
+
+        // Sectors are shared with file reads
+        file.Open();
+        file.Seek(3 * 2048 + 10);
+        int32_t bytesRead = file.Read(100, data);
+        mu_assert(bytesRead == 100 && data[0] == 10 && data[99] == 109, "Read from cached sectors returned wrong data");
+
+        delete[] data;
+        Cd::SectorCache::Release();
+    }
+
+    // Test: Verify stream reader returns file data in order while buffers are refilled in the background.
+    MU_TEST(cd_stream_reader_test_sequential)
+    {
+        const char *filename = "TESTFILE.UTS";
+        const int32_t length = 40000;
+
+        Cd::ChangeDir("ROOT");
+        Cd::File file(filename);
+
+        bool exists = file.Exists();
+        snprintf(buffer, buffer_size, "File '%s' does not exist but should", filename);
+        mu_assert(exists, buffer);
+
+        Cd::StreamReader stream(file, 2, 3, Memory::Zone::LWRam);
+        int32_t position = 0;
+        int32_t mismatch = -1;
+        uint8_t data[300];
+
+        while (position < length && mismatch < 0)
+        {
+            // Odd read size, so reads cross buffer bounds at different places
+            int32_t bytesRead = stream.Read(sizeof(data) - 3, data);
+            snprintf(buffer, buffer_size, "Stream read at %d failed: %d", position, bytesRead);
+            mu_assert(bytesRead == sizeof(data) - 3, buffer);
+
+            // File contains byte sequence 0, 1, ... 255, 0, 1, ...
+            for (int32_t byte = 0; byte < bytesRead && mismatch < 0; byte++)
+            {
+                if (data[byte] != static_cast<uint8_t>(position + byte))
+                {
+                    mismatch = position + byte;
+                }
+            }
+
+            position += bytesRead;
+        }
+
+        snprintf(buffer, buffer_size, "Stream returned wrong data at byte %d", mismatch);
+        mu_assert(mismatch < 0, buffer);
+
+        snprintf(buffer, buffer_size, "Stream position %d != %d", stream.GetPosition(), position);
+        mu_assert(stream.GetPosition() == position, buffer);
+
+        const Cd::StreamReader::Statistics& statistics = stream.GetStatistics();
+        snprintf(buffer, buffer_size, "Stream statistics bytes %d != %d", statistics.BytesRead, position);
+        mu_assert(statistics.BytesRead == static_cast<uint32_t>(position), buffer);
+
+        // Reading from the middle of the file
+        bool restarted = stream.Restart(100);
+        snprintf(buffer, buffer_size, "Stream did not restart at sector 100");
+        mu_assert(restarted, buffer);
+
+        int32_t bytesRead = stream.Read(1, data);
+        snprintf(buffer, buffer_size, "Stream read after restart failed: %d, %d", bytesRead, data[0]);
+        mu_assert(bytesRead == 1 && data[0] == static_cast<uint8_t>(100 * 2048), buffer);
+    }
+
     // Test: Verify changing to a valid directory.
     // MU_TEST(cd_test_change_to_valid_directory)
     // {
@@ -507,7 +1094,22 @@ extern "C"
         // Run individual test cases
         MU_RUN_TEST(cd_test_file_exists);
         MU_RUN_TEST(cd_test_read_file);
+        MU_RUN_TEST(cd_pack_test_load);
+        MU_RUN_TEST(cd_lz4_test_load);
+        MU_RUN_TEST(cd_stream_test_channels);
+        MU_RUN_TEST(cd_stream_test_subdirectory);
         MU_RUN_TEST(cd_test_read_file2);
+        MU_RUN_TEST(cd_path_index_test_open);
+        MU_RUN_TEST(cd_handle_pool_test_alternate);
+        MU_RUN_TEST(cd_handle_pool_test_reserve);
+        MU_RUN_TEST(cd_handle_pool_test_close_pinned);
+        MU_RUN_TEST(cd_asset_loader_test_read_file);
+        MU_RUN_TEST(cd_asset_loader_test_read_file_unaligned);
+        MU_RUN_TEST(cd_test_read_file_async);
+        MU_RUN_TEST(cd_test_load_async_keeps_position);
+        MU_RUN_TEST(cd_test_close_cancels_queued_request);
+        MU_RUN_TEST(cd_test_async_unaligned_destination);
+        MU_RUN_TEST(cd_test_trace_file);
         MU_RUN_TEST(cd_test_null_file);
         MU_RUN_TEST(cd_test_missing_file);
         MU_RUN_TEST(cd_file_seek_test_beginning);
@@ -515,6 +1117,9 @@ extern "C"
         MU_RUN_TEST(cd_file_seek_test_relative);
         MU_RUN_TEST(cd_file_seek_test_invalid_negative);
         MU_RUN_TEST(cd_file_seek_test_invalid_beyond);
+        MU_RUN_TEST(cd_file_read_test_sector_aligned);
+        MU_RUN_TEST(cd_sector_cache_test_reload);
+        MU_RUN_TEST(cd_stream_reader_test_sequential);
         //MU_RUN_TEST(cd_test_change_to_valid_directory);       // New test
         //MU_RUN_TEST(cd_test_change_to_invalid_directory);     // New test
         //MU_RUN_TEST(cd_test_navigate_to_parent_directory);    // New test
@@ -132,6 +132,277 @@ extern "C"
         mu_assert(SRL::Memory::CartRam::GetSize() > 0, "CartRam initialization failed");
     }
 
+    /**
+     * @brief Test allocator report consistency
+     *
+     * Verifies that report of the configured allocator (SIMPLE, SEGREGATED or TLSF)
+     * reflects allocation and release of a block.
+     */
+    MU_TEST(memory_test_report_consistency)
+    {
+        Memory::Report before = Memory::HighWorkRam::GetReport();
+        mu_assert(before.FreeSize + before.AllocationHeaders <= before.TotalSize, "Report free size exceeds zone size");
+
+        void* ptr = Memory::HighWorkRam::Malloc(100);
+        mu_assert(ptr != nullptr, "Allocation failed");
+
+        Memory::Report allocated = Memory::HighWorkRam::GetReport();
+        mu_assert(allocated.UsedBlocks == before.UsedBlocks + 1, "Report does not count allocated block");
+        mu_assert(allocated.FreeSize + 100 <= before.FreeSize, "Report free size did not shrink");
+
+        Memory::HighWorkRam::Free(ptr);
+
+        Memory::Report after = Memory::HighWorkRam::GetReport();
+        mu_assert(after.UsedBlocks == before.UsedBlocks, "Report does not reflect released block");
+        mu_assert(after.FreeSize == before.FreeSize, "Report free size was not restored");
+    }
+
+    /**
+     * @brief Test linear arena allocation and reset
+     *
+     * Verifies that arena allocations are aligned, fail when arena is full
+     * and that reset makes the whole arena available again.
+     */
+    MU_TEST(memory_test_arena)
+    {
+        void* block = Memory::Malloc(256, Memory::Zone::LWRam);
+        mu_assert(block != nullptr, "Arena block allocation failed");
+
+        Memory::Arena arena(block, 256);
+
+        void* first = arena.Malloc(3);
+        void* second = arena.Malloc(16, 8);
+        mu_assert(first == block, "Arena does not start at block start");
+        mu_assert(second != nullptr && (reinterpret_cast<uint32_t>(second) & 7) == 0, "Arena allocation is not aligned");
+        mu_assert(arena.Malloc(256) == nullptr, "Arena allocation over its size did not fail");
+
+        arena.Reset();
+        mu_assert(arena.GetUsedSpace() == 0, "Arena reset failed");
+        mu_assert(arena.Malloc(256) == block, "Arena space was not released on reset");
+        mu_assert(arena.GetPeakUsage() == 256, "Arena peak usage is wrong");
+
+        Memory::Free(block);
+    }
+
+    /**
+     * @brief Test double buffered per-frame arena
+     *
+     * Verifies that memory allocated in one frame survives the next frame
+     * and gets reused the frame after.
+     */
+    MU_TEST(memory_test_frame_arena)
+    {
+        mu_assert(Memory::FrameArena::Initialize(1024, Memory::Zone::HWRam, 2), "Frame arena initialization failed");
+
+        uint8_t* frame0 = framenew uint8_t[100];
+        mu_assert(frame0 != nullptr, "Frame arena allocation failed");
+
+        Memory::FrameArena::NextFrame();
+        uint8_t* frame1 = framenew uint8_t[100];
+        mu_assert(frame1 != nullptr && frame1 != frame0, "Double buffered frame arena reused live buffer");
+
+        // Deleting arena memory must be ignored
+        delete[] frame1;
+
+        Memory::FrameArena::NextFrame();
+        uint8_t* frame2 = framenew uint8_t[100];
+        mu_assert(frame2 == frame0, "Frame arena buffer was not reset");
+
+        Memory::FrameArena::Release();
+        mu_assert(framenew uint8_t[100] == nullptr, "Released frame arena still allocates");
+    }
+
+    /**
+     * @brief Test object pool
+     *
+     * Verifies that pool hands out slots until full, reuses released slots and iterates only over live objects.
+     */
+    MU_TEST(memory_test_pool)
+    {
+        Memory::Pool<uint32_t, 40> pool;
+        uint32_t* objects[40];
+
+        for (uint32_t i = 0; i < 40; i++)
+        {
+            objects[i] = pool.Acquire(i);
+            mu_assert(objects[i] != nullptr, "Pool allocation failed");
+        }
+
+        mu_assert(pool.IsFull() && pool.Acquire(0U) == nullptr, "Full pool returned an object");
+
+        for (uint32_t i = 0; i < 40; i += 2)
+        {
+            pool.Release(objects[i]);
+        }
+
+        // Releasing twice must be ignored
+        pool.Release(objects[0]);
+
+        size_t live = 0;
+
+        for (uint32_t& object : pool)
+        {
+            mu_assert((object & 1) == 1, "Pool iterated over released object");
+            live++;
+        }
+
+        mu_assert(live == 20 && pool.GetCount() == 20, "Pool live object count mismatch");
+        mu_assert(pool.Acquire(100U) == objects[38], "Pool did not reuse released slot");
+
+        Memory::DynamicPool<uint32_t> dynamicPool(10, Memory::Zone::LWRam);
+        uint32_t* object = dynamicPool.Acquire(5U);
+        mu_assert(object != nullptr && Memory::LowWorkRam::InRange(object), "Dynamic pool storage is not in selected zone");
+        mu_assert(dynamicPool.Owns(object) && *object == 5, "Dynamic pool allocation failed");
+    }
+
+    /**
+     * @brief Test memory telemetry
+     *
+     * Verifies that zone statistics, high-water marks and tag statistics follow allocations and frees.
+     */
+    MU_TEST(memory_test_telemetry)
+    {
+        Memory::Statistics statistics = Memory::Telemetry::GetStatistics(Memory::Zone::LWRam);
+        Memory::TagStatistics tagStatistics = Memory::Telemetry::GetTagStatistics(3);
+        size_t allocations = statistics.Allocations;
+        size_t used = statistics.UsedSize;
+        size_t tagged = tagStatistics.UsedSize;
+
+        uint8_t* data = new (Memory::Zone::LWRam, 3) uint8_t[100];
+        mu_assert(data != nullptr, "Tagged allocation failed");
+
+        // Statistics are snapshots, take new ones after each step
+        statistics = Memory::Telemetry::GetStatistics(Memory::Zone::LWRam);
+        tagStatistics = Memory::Telemetry::GetTagStatistics(3);
+        mu_assert(statistics.Allocations == allocations + 1, "Allocation was not counted");
+        mu_assert(statistics.UsedSize >= used + 100, "Used size was not updated");
+        mu_assert(statistics.PeakUsedSize >= statistics.UsedSize, "High-water mark is lower than used size");
+        mu_assert(tagStatistics.UsedSize >= tagged + 100 && tagStatistics.Allocations > 0, "Tag statistics were not updated");
+
+        size_t peak = statistics.PeakUsedSize;
+        delete[] data;
+
+        statistics = Memory::Telemetry::GetStatistics(Memory::Zone::LWRam);
+        tagStatistics = Memory::Telemetry::GetTagStatistics(3);
+        mu_assert(statistics.Allocations == allocations && statistics.UsedSize == used, "Free was not counted");
+        mu_assert(statistics.PeakUsedSize == peak, "High-water mark changed on free");
+        mu_assert(tagStatistics.UsedSize == tagged, "Tag statistics were not updated on free");
+
+        // Incremental free space must match full zone walk
+        mu_assert(Memory::LowWorkRam::GetFreeSpace() == Memory::LowWorkRam::GetReport().FreeSize, "Free space does not match report");
+        mu_assert(Memory::LowWorkRam::GetLargestFreeBlock() <= Memory::LowWorkRam::GetFreeSpace(), "Largest free block is larger than free space");
+        mu_assert(Memory::Telemetry::GetFragmentation(Memory::Zone::LWRam) <= 100, "Fragmentation is out of range");
+
+        size_t failed = statistics.FailedAllocations;
+        mu_assert(Memory::LowWorkRam::Malloc(Memory::LowWorkRam::GetSize() * 2) == nullptr, "Oversized allocation succeeded");
+
+        statistics = Memory::Telemetry::GetStatistics(Memory::Zone::LWRam);
+        mu_assert(statistics.FailedAllocations == failed + 1, "Failed allocation was not counted");
+    }
+
+    /**
+     * @brief Test memory copy and fill
+     *
+     * Verifies both CPU and DMA paths with aligned and misaligned addresses.
+     */
+    MU_TEST(memory_test_copy_fill)
+    {
+        const size_t sizes[] = { 3, 64, Memory::DmaThreshold + 5, 4096 };
+        uint8_t* source = new (Memory::Zone::HWRam) uint8_t[4100];
+        uint8_t* destination = new (Memory::Zone::LWRam) uint8_t[4100];
+        mu_assert(source != nullptr && destination != nullptr, "Allocation failed");
+
+        for (size_t i = 0; i < 4100; i++)
+        {
+            source[i] = static_cast<uint8_t>(i * 7);
+        }
+
+        for (size_t size : sizes)
+        {
+            for (size_t offset = 0; offset < 4; offset++)
+            {
+                Memory::Fill(destination, 0xAA, 4100);
+                Memory::Copy(destination + offset, source + 1, size);
+
+                for (size_t i = 0; i < size; i++)
+                {
+                    mu_assert(destination[offset + i] == static_cast<uint8_t>((i + 1) * 7), "Copied data do not match");
+                }
+
+                mu_assert(destination[offset + size] == 0xAA, "Copy wrote past the end");
+            }
+        }
+
+        Memory::Transfer transfer = Memory::FillAsync(destination + 1, 0x55, 4096);
+        transfer.Wait();
+        mu_assert(transfer.IsComplete(), "Transfer did not complete");
+        mu_assert(destination[0] == 0xAA && destination[4097] == 0xAA, "Fill wrote outside of the range");
+
+        for (size_t i = 1; i <= 4096; i++)
+        {
+            mu_assert(destination[i] == 0x55, "Filled data do not match");
+        }
+
+        delete[] source;
+        delete[] destination;
+    }
+
+    /**
+     * @brief Task allocating and freeing memory on slave CPU
+     */
+    class MemorySlaveTask : public Types::ITask
+    {
+    protected:
+        void Do() override
+        {
+            void* blocks[32];
+
+            for (size_t round = 0; round < 64; round++)
+            {
+                for (size_t i = 0; i < 32; i++)
+                {
+                    blocks[i] = Memory::HighWorkRam::Malloc(16 + ((i * 13) & 127));
+                }
+
+                for (size_t i = 0; i < 32; i++)
+                {
+                    Memory::HighWorkRam::Free(blocks[i]);
+                }
+            }
+        }
+    };
+
+    /**
+     * @brief Test allocation from both CPUs at the same time
+     *
+     * Master and slave allocate from the same zone, no block may be lost or corrupted.
+     */
+    MU_TEST(memory_test_slave_allocation)
+    {
+        size_t usedBlocks = Memory::HighWorkRam::GetReport().UsedBlocks;
+        MemorySlaveTask task;
+        Slave::ExecuteOnSlave(task);
+
+        void* blocks[32];
+
+        while (!task.IsDone())
+        {
+            for (size_t i = 0; i < 32; i++)
+            {
+                blocks[i] = Memory::HighWorkRam::Malloc(8 + ((i * 7) & 63));
+                mu_assert(blocks[i] != nullptr, "Allocation failed");
+                Memory::Fill(blocks[i], 0xA5, 8);
+            }
+
+            for (size_t i = 0; i < 32; i++)
+            {
+                Memory::HighWorkRam::Free(blocks[i]);
+            }
+        }
+
+        mu_assert(Memory::HighWorkRam::GetReport().UsedBlocks == usedBlocks, "Blocks were lost");
+    }
+
     /**
      * @brief Test cross-zone memory allocation
      *
@@ -308,6 +579,13 @@ extern "C"
         MU_RUN_TEST(memory_test_placement_malloc_cartram);
         MU_RUN_TEST(memory_test_placement_malloc_invalid);
         MU_RUN_TEST(memory_test_initialize_zones);
+        MU_RUN_TEST(memory_test_report_consistency);
+        MU_RUN_TEST(memory_test_arena);
+        MU_RUN_TEST(memory_test_frame_arena);
+        MU_RUN_TEST(memory_test_pool);
+        MU_RUN_TEST(memory_test_telemetry);
+        MU_RUN_TEST(memory_test_copy_fill);
+        MU_RUN_TEST(memory_test_slave_allocation);
         MU_RUN_TEST(memory_test_cross_zone_allocation);
         MU_RUN_TEST(memory_test_boundary_conditions);
         MU_RUN_TEST(memory_test_move_memory_blocks); // Register the new test case
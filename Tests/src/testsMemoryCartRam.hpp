@@ -103,6 +103,26 @@ extern "C"
         mu_assert(usedSpace >= 0, "Failed to get used space");
     }
 
+    /**
+     * @brief Test used memory space in CartRam follows allocations
+     *
+     * Verifies that Memory::GetUsedSpace() returns (does not take the zone lock twice)
+     * and that it grows when memory is allocated in CartRam.
+     */
+    MU_TEST(memory_CartRam_test_used_space_tracks_allocation)
+    {
+        size_t before = Memory::GetUsedSpace(Memory::Zone::CartRam);
+        void* ptr = Memory::CartRam::Malloc(1024);
+        mu_assert(ptr != nullptr, "Failed to allocate memory in CartRam");
+
+        size_t after = Memory::GetUsedSpace(Memory::Zone::CartRam);
+        mu_assert(after >= before + 1024, "Used space did not grow after allocation");
+        mu_assert(after == Memory::CartRam::GetSize() - Memory::CartRam::GetFreeSpace(), "Used space does not match free space");
+
+        Memory::CartRam::Free(ptr);
+        mu_assert(Memory::GetUsedSpace(Memory::Zone::CartRam) == before, "Used space did not return after free");
+    }
+
     /**
      * @brief Test getting memory zone size in CartRam
      *
@@ -155,6 +175,41 @@ extern "C"
         mu_assert(report.TotalSize > 0, "Failed to get memory report for CartRam");
     }
 
+    /**
+     * @brief Test expansion cart detection
+     *
+     * Verifies that detected cart type matches size of the CartRam zone
+     * and that allocated memory lies within the cart RAM.
+     */
+    MU_TEST(memory_CartRam_test_cart_detection)
+    {
+        Memory::CartRam::CartType type = Memory::CartRam::GetCartType();
+        size_t size = Memory::CartRam::GetSize();
+
+        switch (type)
+        {
+        case Memory::CartRam::CartType::Ram1MB:
+            mu_assert(size == 0x100000, "1MB cart zone size mismatch");
+            break;
+
+        case Memory::CartRam::CartType::Ram4MB:
+            mu_assert(size == 0x400000, "4MB cart zone size mismatch");
+            break;
+
+        default:
+            mu_assert(size == 0, "CartRam zone exists without a RAM cart");
+            mu_assert(Memory::CartRam::Malloc(100) == nullptr, "CartRam allocation without a RAM cart");
+            return;
+        }
+
+        void *ptr = Memory::CartRam::Malloc(100);
+        mu_assert(ptr != nullptr, "CartRam memory allocation failed");
+        mu_assert(Memory::CartRam::InRange(ptr), "CartRam allocation is outside of the cart RAM");
+        mu_assert(!Memory::HighWorkRam::InRange(ptr), "CartRam allocation is inside HighWorkRam");
+
+        Memory::CartRam::Free(ptr);
+    }
+
     /**
      * @brief Test CartRam memory allocation and deallocation
      *
@@ -628,6 +683,7 @@ extern "C"
                                        &memory_CartRam_test_teardown,
                                        &memory_CartRam_test_output_header);
 
+        MU_RUN_TEST(memory_CartRam_test_cart_detection);
         MU_RUN_TEST(memory_CartRam_test_malloc_free);
         MU_RUN_TEST(memory_CartRam_test_multiple_sizes_malloc_free);
         MU_RUN_TEST(memory_CartRam_test_multiple_array_sizes);
@@ -638,6 +694,7 @@ extern "C"
 
         MU_RUN_TEST(memory_CartRam_test_get_free_space);
         MU_RUN_TEST(memory_CartRam_test_get_used_space);
+        MU_RUN_TEST(memory_CartRam_test_used_space_tracks_allocation);
         MU_RUN_TEST(memory_CartRam_test_get_size);
         MU_RUN_TEST(memory_CartRam_test_get_report_cartram);
         MU_RUN_TEST(memory_CartRam_test_cartram_get_free_space);
@@ -331,6 +331,48 @@ extern "C"
         delete[] ptr;
     }
 
+    /**
+     * @brief Test reallocating without moving the block
+     *
+     * Verifies that block grows into free neighbor and shrinks in place, and that data survive when block has to move.
+     */
+    MU_TEST(memory_HWRam_test_realloc_in_place)
+    {
+        size_t usedBlocksBefore = Memory::HighWorkRam::GetReport().UsedBlocks;
+        uint8_t *ptr = reinterpret_cast<uint8_t*>(Memory::HighWorkRam::Malloc(64));
+        uint8_t *neighbor = reinterpret_cast<uint8_t*>(Memory::HighWorkRam::Malloc(64));
+        uint8_t *guard = reinterpret_cast<uint8_t*>(Memory::HighWorkRam::Malloc(64));
+        mu_assert(ptr != nullptr && neighbor != nullptr && guard != nullptr, "Initial allocation failed");
+
+        for (size_t i = 0; i < 64; i++)
+        {
+            ptr[i] = static_cast<uint8_t>(i);
+        }
+
+        // Neighbor follows our block right after its header
+        bool adjacent = neighbor > ptr && neighbor <= ptr + 64 + 8;
+        Memory::HighWorkRam::Free(neighbor);
+
+        uint8_t *grown = reinterpret_cast<uint8_t*>(Memory::HighWorkRam::Realloc(ptr, 100));
+        mu_assert(grown != nullptr, "Reallocation to larger size failed");
+        mu_assert(!adjacent || grown == ptr, "Block did not grow into free neighbor");
+
+        uint8_t *shrunk = reinterpret_cast<uint8_t*>(Memory::HighWorkRam::Realloc(grown, 16));
+        mu_assert(shrunk == grown, "Block did not shrink in place");
+
+        uint8_t *moved = reinterpret_cast<uint8_t*>(Memory::HighWorkRam::Realloc(shrunk, 4096));
+        mu_assert(moved != nullptr, "Reallocation to much larger size failed");
+
+        for (size_t i = 0; i < 16; i++)
+        {
+            mu_assert(moved[i] == static_cast<uint8_t>(i), "Data were not preserved by reallocation");
+        }
+
+        Memory::HighWorkRam::Free(moved);
+        Memory::HighWorkRam::Free(guard);
+        mu_assert(Memory::HighWorkRam::GetReport().UsedBlocks == usedBlocksBefore, "Reallocation leaked memory");
+    }
+
     /**
      * @brief Test allocating and freeing very large blocks of memory
      *
@@ -366,6 +408,44 @@ extern "C"
         delete[] ptr4;
     }
 
+    /**
+     * @brief Test merging of freed neighboring blocks
+     *
+     * Verifies that blocks freed out of order are merged back together,
+     * so the whole free space can be allocated again as one block.
+     */
+    MU_TEST(memory_HWRam_test_free_merge_out_of_order)
+    {
+        const size_t count = 64;
+        void *ptrs[count];
+        size_t freeSpaceBefore = Memory::HighWorkRam::GetFreeSpace();
+
+        for (size_t i = 0; i < count; i++)
+        {
+            ptrs[i] = Memory::HighWorkRam::Malloc(8 + (i * 24));
+            mu_assert(ptrs[i] != nullptr, "Small block allocation failed");
+        }
+
+        // Free every odd block first, then the rest, so each free has to merge with both neighbors
+        for (size_t i = 1; i < count; i += 2)
+        {
+            Memory::HighWorkRam::Free(ptrs[i]);
+        }
+
+        for (size_t i = 0; i < count; i += 2)
+        {
+            Memory::HighWorkRam::Free(ptrs[i]);
+        }
+
+        size_t freeSpaceAfter = Memory::HighWorkRam::GetFreeSpace();
+        mu_assert(freeSpaceAfter == freeSpaceBefore, "Freed blocks were not merged");
+
+        void *ptr = Memory::HighWorkRam::Malloc(freeSpaceAfter);
+        mu_assert(ptr != nullptr, "Merged free space cannot be allocated as one block");
+
+        Memory::HighWorkRam::Free(ptr);
+    }
+
     /**
      * @brief Test handling of allocation failures
      *
@@ -398,6 +478,34 @@ extern "C"
         SRL::Memory::Free(ptr); // Should not crash or cause issues
     }
 
+    /**
+     * @brief Test freeing block merged into its neighbor and pointers inside of a block
+     *
+     * Verifies that a second free of a block merged into the preceding free block,
+     * or free of a pointer that does not point to the start of a block, does not change the free space.
+     */
+    MU_TEST(memory_HWRam_test_free_merged_and_interior)
+    {
+        char* first = new (SRL::Memory::Zone::HWRam) char[100];
+        char* second = new (SRL::Memory::Zone::HWRam) char[100];
+        char* third = new (SRL::Memory::Zone::HWRam) char[100];
+        mu_assert(first != nullptr && second != nullptr && third != nullptr, "Allocation failed");
+
+        delete[] first;
+        delete[] second;
+        size_t freeSpace = SRL::Memory::HighWorkRam::GetFreeSpace();
+
+        SRL::Memory::Free(second);
+        SRL::Memory::Free(third + 16);
+        SRL::Memory::Free(third + 64);
+
+        snprintf(buffer, buffer_size,
+            "Free space changed from %d to %d", freeSpace, SRL::Memory::HighWorkRam::GetFreeSpace());
+        mu_assert(SRL::Memory::HighWorkRam::GetFreeSpace() == freeSpace, buffer);
+
+        delete[] third;
+    }
+
     /**
      * @brief Test stress testing with high memory usage and frequent allocations/deallocations
      *
@@ -650,6 +758,7 @@ extern "C"
         MU_RUN_TEST(memory_HWRam_test_highworkram_malloc_free);
         MU_RUN_TEST(memory_HWRam_test_highworkram_realloc);
         MU_RUN_TEST(memory_HWRam_test_realloc_larger);
+        MU_RUN_TEST(memory_HWRam_test_realloc_in_place);
 
         // 2. Memory Information Tests
         MU_RUN_TEST(memory_HWRam_test_get_free_space);
@@ -665,12 +774,14 @@ extern "C"
         MU_RUN_TEST(memory_HWRam_test_malloc_zero);
         MU_RUN_TEST(memory_HWRam_test_free_null);
         MU_RUN_TEST(memory_HWRam_test_free_unallocated);
+        MU_RUN_TEST(memory_HWRam_test_free_merged_and_interior);
         MU_RUN_TEST(memory_HWRam_test_allocation_failure);
         MU_RUN_TEST(memory_HWRam_test_memory_leaks);
 
         // 4. Memory Management Tests
         MU_RUN_TEST(memory_HWRam_test_large_block);
         MU_RUN_TEST(memory_HWRam_test_fragmentation);
+        MU_RUN_TEST(memory_HWRam_test_free_merge_out_of_order);
         MU_RUN_TEST(memory_HWRam_test_boundary_conditions);
         MU_RUN_TEST(memory_HWRam_test_deplete_highworkram);
 
@@ -366,6 +366,63 @@ extern "C"
         delete[] ptr4;
     }
 
+    /**
+     * @brief Test compaction of movable heap
+     *
+     * Verifies that compaction merges free space, keeps block data and does not move pinned blocks.
+     */
+    MU_TEST(memory_LWRam_test_movable_heap)
+    {
+        SRL::Memory::MovableHeap heap(8192, 16);
+        SRL::Memory::MovableHeap::Handle handles[8];
+
+        for (size_t i = 0; i < 8; i++)
+        {
+            handles[i] = heap.Malloc(900);
+            mu_assert(handles[i] != SRL::Memory::MovableHeap::InvalidHandle, "Movable block allocation failed");
+            SRL::Memory::Fill(heap.Get(handles[i]), static_cast<uint8_t>(i + 1), 900);
+        }
+
+        // Leave holes between blocks, keep one block pinned
+        void* pinned = heap.Pin(handles[3]);
+
+        for (size_t i = 0; i < 8; i += 2)
+        {
+            heap.Free(handles[i]);
+        }
+
+        mu_assert(heap.GetLargestFreeBlock() < 2000, "Free space is not fragmented");
+
+        while (!heap.Compact(1024))
+        {
+            // Compact over several frames
+        }
+
+        mu_assert(heap.Get(handles[3]) == pinned, "Pinned block was moved");
+        heap.Unpin(handles[3]);
+
+        while (!heap.Compact(1024))
+        {
+            // Compact over several frames
+        }
+
+        mu_assert(heap.GetLargestFreeBlock() >= 4 * 900, "Free space was not merged");
+
+        for (size_t i = 1; i < 8; i += 2)
+        {
+            uint8_t* data = reinterpret_cast<uint8_t*>(heap.Get(handles[i]));
+
+            for (size_t byte = 0; byte < 900; byte++)
+            {
+                mu_assert(data[byte] == static_cast<uint8_t>(i + 1), "Movable block data were corrupted");
+            }
+
+            heap.Free(handles[i]);
+        }
+
+        mu_assert(heap.GetCount() == 0, "Movable blocks were not freed");
+    }
+
     /**
      * @brief Test handling of allocation failures
      *
@@ -673,6 +730,7 @@ extern "C"
         MU_RUN_TEST(memory_LWRam_test_fragmentation);
         MU_RUN_TEST(memory_LWRam_test_boundary_conditions);
         MU_RUN_TEST(memory_LWRam_test_deplete_lowworkram);
+        MU_RUN_TEST(memory_LWRam_test_movable_heap);
 
         // 5. Stress and Performance Tests
         MU_RUN_TEST(memory_LWRam_test_stress);
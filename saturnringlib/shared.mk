@@ -58,6 +58,10 @@ ifeq ($(strip ${SRL_MAX_CD_FILES}),)
 	SRL_MAX_CD_FILES=255
 endif
 
+ifeq ($(strip ${SRL_MAX_CD_STREAMS}),)
+	SRL_MAX_CD_STREAMS=2
+endif
+
 ifeq ($(strip ${SRL_MAX_CD_RETRIES}),)
 	SRL_MAX_CD_RETRIES=5
 endif
@@ -99,6 +103,46 @@ ifneq ($(strip ${SRL_MODE}),PAL)
 	endif
 endif
 
+ifneq ($(strip ${SRL_FRAME_ARENA_SIZE}),)
+	ifeq ($(strip ${SRL_FRAME_ARENA_ZONE}),)
+		SRL_FRAME_ARENA_ZONE = HWRam
+	endif
+
+	ifeq ($(strip ${SRL_FRAME_ARENA_BUFFERS}),)
+		SRL_FRAME_ARENA_BUFFERS = 1
+	endif
+
+	CCFLAGS += -DSRL_FRAME_ARENA_SIZE=$(strip ${SRL_FRAME_ARENA_SIZE}) \
+		-DSRL_FRAME_ARENA_ZONE=$(strip ${SRL_FRAME_ARENA_ZONE}) \
+		-DSRL_FRAME_ARENA_BUFFERS=$(strip ${SRL_FRAME_ARENA_BUFFERS})
+endif
+
+ifneq ($(strip ${SRL_CD_CACHE_SECTORS}),)
+	ifeq ($(strip ${SRL_CD_CACHE_ZONE}),)
+		SRL_CD_CACHE_ZONE = LWRam
+	endif
+
+	CCFLAGS += -DSRL_CD_CACHE_SECTORS=$(strip ${SRL_CD_CACHE_SECTORS}) \
+		-DSRL_CD_CACHE_ZONE=$(strip ${SRL_CD_CACHE_ZONE})
+endif
+
+ifeq ($(strip ${SRL_CD_PATH_INDEX}),)
+	SRL_CD_PATH_INDEX = 1
+endif
+
+ifneq ($(strip ${SRL_CD_PATH_INDEX}),0)
+	ifeq ($(strip ${SRL_CD_PATH_INDEX_ZONE}),)
+		SRL_CD_PATH_INDEX_ZONE = LWRam
+	endif
+
+	CCFLAGS += -DSRL_CD_PATH_INDEX=$(strip ${SRL_CD_PATH_INDEX}) \
+		-DSRL_CD_PATH_INDEX_ZONE=$(strip ${SRL_CD_PATH_INDEX_ZONE})
+endif
+
+ifneq ($(strip ${SRL_MEMORY_TAG_SLOTS}),)
+	CCFLAGS += -DSRL_MEMORY_TAG_SLOTS=$(strip ${SRL_MEMORY_TAG_SLOTS})
+endif
+
 ifeq ($(strip ${SRL_DEBUG_MAX_PRINT_LENGTH}),)
 	SRL_DEBUG_MAX_PRINT_LENGTH = 45
 endif
@@ -111,6 +155,7 @@ CCFLAGS += -DSRL_MODE_$(strip ${SRL_MODE}) \
 	-DSRL_MAX_TEXTURES=$(strip ${SRL_MAX_TEXTURES}) \
 	-DSRL_MAX_CD_BACKGROUND_JOBS=$(strip ${SRL_MAX_CD_BACKGROUND_JOBS}) \
 	-DSRL_MAX_CD_FILES=$(strip ${SRL_MAX_CD_FILES}) \
+	-DSRL_MAX_CD_STREAMS=$(strip ${SRL_MAX_CD_STREAMS}) \
 	-DSRL_MAX_CD_RETRIES=$(strip ${SRL_MAX_CD_RETRIES}) \
 	-DSRL_DEBUG_MAX_PRINT_LENGTH=$(strip ${SRL_DEBUG_MAX_PRINT_LENGTH}) \
 	-DSRL_DEBUG_MAX_LOG_LENGTH=$(strip ${SRL_DEBUG_MAX_LOG_LENGTH}) \
@@ -119,6 +164,14 @@ CCFLAGS += -DSRL_MODE_$(strip ${SRL_MODE}) \
 ASSETS_DIR = ./cd/data
 MUSIC_DIR = ./cd/music
 
+# Every directory in PACKS_DIR is packed into $(ASSETS_DIR)/<NAME>.PAK (see SRL::Cd::Pack)
+PACKS_DIR = ./cd/packs
+PACKER = python3 $(SDK_ROOT)/../tools/scripts/srl_packer.py
+PACK_DIRS = $(patsubst ./%,%,$(shell find $(PACKS_DIR) -mindepth 1 -maxdepth 1 -type d 2>/dev/null))
+
+# Optional file order on the disc, generated from access traces by srl_disc_order.py (see SRL::Cd::SetTraceHandler)
+SORT_FILE = ./cd/sort.txt
+
 # Handle work area
 ifneq ($(strip ${SGL_MAX_VERTICES}),)
 	SYSFLAGS += -DSGL_MAX_VERTICES=$(strip ${SGL_MAX_VERTICES})
@@ -162,9 +215,14 @@ SATURNMATHPPDIR = $(MODDIR)/SaturnMathPP
 SYSSOURCES += $(SGLLDIR)/../SRC/workarea.c
 
 ifdef SRL_MALLOC_METHOD
-	ifeq ($(SRL_MALLOC_METHOD), TLSF)
+	ifeq ($(strip $(SRL_MALLOC_METHOD)), TLSF)
 		SYSSOURCES += $(TLSFDIR)/tlsf.c
 		USE_TLSF_ALLOCATOR := TRUE
+		CCFLAGS += -DUSE_TLSF_ALLOCATOR
+	endif
+
+	ifeq ($(strip $(SRL_MALLOC_METHOD)), SIMPLE)
+		CCFLAGS += -DUSE_SIMPLE_ALLOCATOR
 	endif
 endif
 
@@ -229,7 +287,13 @@ compile_objects : $(OBJECTS) $(SYSOBJECTS)
 convert_binary : compile_objects
 	$(OBJCOPY) -O binary $(BUILD_ELF) ./cd/data/0.bin
 
-create_iso : convert_binary
+# Pack file name is upper case directory name, it must fit ISO 8.3 file names
+build_packs :
+	for dir in $(PACK_DIRS); do \
+		$(PACKER) $$dir $(ASSETS_DIR)/$$(basename $$dir | tr a-z A-Z).PAK || exit 1; \
+	done
+
+create_iso : convert_binary build_packs
 ifeq ($(strip ${SRL_USE_SGL_SOUND_DRIVER}),1)
 	cp -r $(SGLDIR)/DRV/. ./cd/data/
 ifeq ($(strip ${SRL_ENABLE_FREQ_ANALYSIS}), 1)
@@ -239,7 +303,7 @@ endif
 	xorrisofs --norock -quiet -sysid "SEGA SATURN" -volid "SaturnApp" -volset "SaturnApp" \
 	-publisher "SEGA ENTERPRISES, LTD." -preparer "SEGA ENTERPRISES, LTD." -appid "SaturnApp" \
 	-abstract "$(ASSETS_DIR)/ABS.TXT" -copyright "$(ASSETS_DIR)/CPY.TXT" -biblio "$(ASSETS_DIR)/BIB.TXT" -generic-boot $(IPFILE) \
-	-full-iso9660-filenames -o $(BUILD_ISO) $(ASSETS_DIR) $(ENTRYPOINT)
+	-full-iso9660-filenames $(if $(wildcard $(SORT_FILE)),-sort $(SORT_FILE)) -o $(BUILD_ISO) $(ASSETS_DIR) $(ENTRYPOINT)
 
 # Create CUE sheet
 create_bin_cue: create_iso
@@ -339,6 +403,9 @@ clean:
 	rm -f $(SGLLDIR)/../SRC/*.o
 	rm -f $(OBJECTS) $(BUILD_ELF) $(BUILD_ISO) $(BUILD_MAP) $(ASSETS_DIR)/0.bin
 	rm -f $(AUDIO_FILES_RAW)
+	for dir in $(PACK_DIRS); do \
+		rm -f $(ASSETS_DIR)/$$(basename $$dir | tr a-z A-Z).PAK; \
+	done
 ifeq ($(strip ${SRL_USE_SGL_SOUND_DRIVER}),1)
 	rm -f $(ASSETS_DIR)/SDDRVS.DAT $(ASSETS_DIR)/SDDRVS.TSK $(ASSETS_DIR)/BOOTSND.MAP
 ifeq ($(strip ${SRL_ENABLE_FREQ_ANALYSIS}), 1)
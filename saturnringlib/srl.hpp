@@ -13,5 +13,7 @@ static_assert(SGL_MAX_POLYGONS > 4,
 #include "srl_core.hpp"
 #include "srl_datetime.hpp"
 #include "srl_tga.hpp"
+#include "srl_lz4.hpp"
+#include "srl_movie.hpp"
 #include "srl_scene2d.hpp"
 #include "srl_scene3d.hpp"
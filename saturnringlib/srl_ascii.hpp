@@ -3,7 +3,8 @@
 #include "srl_tv.hpp"
 #include "srl_cram.hpp"
 #include "srl_bitmap.hpp" // for IBit
-#include "srl_string.hpp" // for memset
+#include "srl_memory.hpp"
+#include "srl_string.hpp"
 
 namespace SRL
 {
@@ -200,7 +201,7 @@ namespace SRL
         }
 
         /** @brief Clears the ASCII tile map.
-         *  @returns false if tileMap is null or memset fails, true otherwise
+         *  @returns false if tileMap is null, true otherwise
          */
         inline static bool Clear()
         {
@@ -212,11 +213,7 @@ namespace SRL
             }
             else
             {
-                void *result = memset(ASCII::tileMap, 0, 64 * 64 * sizeof(uint16_t)); // Clear the tile map
-                if (result == nullptr)
-                {
-                    status = false;
-                }
+                Memory::Fill(ASCII::tileMap, 0, 64 * 64 * sizeof(uint16_t)); // Clear the tile map
             }
 
             return status;
@@ -0,0 +1,657 @@
+#pragma once
+
+#include "srl_base.hpp"
+#include "srl_memory.hpp"
+#include "srl_event.hpp"
+#include "srl_cd.hpp"
+#include "srl_tga.hpp"
+#include "srl_vdp1.hpp"
+#include "srl_tilemap.hpp"
+
+extern "C" {
+    #include <sega_tim.h>
+}
+
+namespace SRL
+{
+    /** @brief Background asset loader
+     * @details Jobs (read a file, decode TGA image, upload texture to VDP1, load tilemap to VDP2 screen) are queued and done one after another
+     * in AssetLoader::Update(), which is called from SRL::Core::Synchronize(). Every frame loader works only until its time budget runs out,
+     * so loading screen animations and gameplay keep running while assets arrive.<br/>
+     * Files are read in the background by Cd::ReadRequest, waiting for the drive costs no time. Decoding and uploading are done in one step,
+     * loader does not start next step when budget is already spent, but a single large image can take longer than the budget.<br/>
+     * Job objects must stay alive until they are done, destroying a job removes it from the queue.
+     * Time is measured by the SH2 free running timer (FRT), its clock setting is not changed.
+     * @code {.cpp}
+     * SRL::Cd::File file("LOGO.TGA");
+     * SRL::AssetLoader::ReadFileJob read(file);
+     * SRL::AssetLoader::DecodeTgaJob decode(read);
+     * SRL::AssetLoader::UploadTextureJob upload(decode);
+     *
+     * upload.OnCompleted += OnLogoLoaded;
+     * SRL::AssetLoader::SetBudget(3000);
+     * SRL::AssetLoader::Enqueue(read);
+     * SRL::AssetLoader::Enqueue(decode);
+     * SRL::AssetLoader::Enqueue(upload);
+     *
+     * while (!upload.IsDone())
+     * {
+     *     DrawSpinner(read.GetProgress(), read.GetTotal());
+     *     SRL::Core::Synchronize();
+     * }
+     *
+     * int32_t texture = upload.GetTexture();
+     * @endcode
+     */
+    class AssetLoader
+    {
+    public:
+        /** @brief Default time budget per frame in microseconds
+         */
+        static constexpr uint32_t DefaultBudget = 2000;
+
+        /** @brief Queued piece of work
+         */
+        class Job
+        {
+        public:
+            /** @brief State of the job
+             */
+            enum class Status : uint8_t
+            {
+                /** @brief Job was not queued yet
+                 */
+                Idle,
+
+                /** @brief Job waits for other jobs to finish
+                 */
+                Queued,
+
+                /** @brief Job is being worked on
+                 */
+                Running,
+
+                /** @brief Job is done
+                 */
+                Completed,
+
+                /** @brief Job failed or was cancelled
+                 */
+                Failed
+            };
+
+            /** @brief Event invoked from AssetLoader::Update() when progress of the job changes
+             * @note Job can be cancelled from the event, but must not be destroyed
+             */
+            SRL::Types::Event<Job&> OnProgress;
+
+            /** @brief Event invoked from AssetLoader::Update() when job is done (completed or failed)
+             */
+            SRL::Types::Event<Job&> OnCompleted;
+
+        private:
+            /** @brief Loader needs to be able to process jobs
+             */
+            friend class AssetLoader;
+
+            /** @brief State of the job
+             */
+            Status status;
+
+            /** @brief Next job in the queue
+             */
+            Job* next;
+
+        protected:
+            /** @brief Amount of work done
+             */
+            int32_t progress;
+
+            /** @brief Amount of work to be done
+             */
+            int32_t total;
+
+            /** @brief Construct idle job
+             * @param total Amount of work to be done
+             */
+            Job(const int32_t total) : status(Status::Idle), next(nullptr), progress(0), total(total) { }
+
+            /** @brief Prepare job when it gets to the front of the queue
+             * @return false if job cannot be done
+             */
+            virtual bool Start()
+            {
+                return true;
+            }
+
+            /** @brief Do next piece of work
+             * @return Status::Running to continue in next frame, Status::Completed or Status::Failed when done
+             */
+            virtual Status Step() = 0;
+
+        public:
+            /** @brief Remove job from the queue if it was not done yet
+             */
+            virtual ~Job()
+            {
+                this->Cancel();
+            }
+
+            Job(const Job&) = delete;
+            Job& operator=(const Job&) = delete;
+
+            /** @brief Remove the job from the queue
+             * @note OnCompleted event is not invoked for cancelled job
+             */
+            void Cancel()
+            {
+                AssetLoader::Remove(*this);
+            }
+
+            /** @brief Gets state of the job
+             * @return Job state
+             */
+            Status GetStatus() const
+            {
+                return this->status;
+            }
+
+            /** @brief Check whether job is done
+             * @return true if job completed or failed
+             */
+            bool IsDone() const
+            {
+                return this->status == Status::Completed || this->status == Status::Failed;
+            }
+
+            /** @brief Gets amount of work done
+             * @return Number of bytes read for ReadFileJob, 1 for other jobs once done
+             */
+            int32_t GetProgress() const
+            {
+                return this->progress;
+            }
+
+            /** @brief Gets amount of work to be done
+             * @return Size of the file for ReadFileJob, 1 for other jobs
+             */
+            int32_t GetTotal() const
+            {
+                return this->total;
+            }
+        };
+
+        /** @brief Read whole file into memory
+         */
+        class ReadFileJob : public Job
+        {
+        private:
+            /** @brief File to read
+             */
+            Cd::File* file;
+
+            /** @brief Buffer to read into
+             */
+            uint8_t* data;
+
+            /** @brief Buffer was allocated by the job
+             */
+            bool ownsData;
+
+            /** @brief Memory zone to allocate buffer in
+             */
+            Memory::Zone zone;
+
+            /** @brief Background read of the file
+             */
+            Cd::ReadRequest request;
+
+            /** @brief Start reading the file
+             * @return false if buffer could not be allocated, is not 4 byte aligned or read could not be queued
+             */
+            bool Start() override
+            {
+                this->progress = 0;
+
+                // CD block transfers data in 32bit words
+                if ((reinterpret_cast<uintptr_t>(this->data) & 3) != 0)
+                {
+                    return false;
+                }
+
+                if (this->data == nullptr)
+                {
+                    this->data = reinterpret_cast<uint8_t*>(Memory::Malloc(this->total + 1, this->zone));
+                    this->ownsData = this->data != nullptr;
+
+                    if (this->ownsData)
+                    {
+                        // Byte after the data keeps the buffer usable as a string
+                        this->data[this->total] = 0;
+                    }
+                }
+
+                return this->data != nullptr && (this->total == 0 || this->file->LoadBytesAsync(this->request, 0, this->total, this->data));
+            }
+
+            /** @brief Check how much data arrived
+             * @return Status::Running while data are still being read
+             */
+            Status Step() override
+            {
+                if (this->total == 0)
+                {
+                    return Status::Completed;
+                }
+
+                this->progress = this->request.GetProgress();
+
+                if (!this->request.IsDone())
+                {
+                    return Status::Running;
+                }
+
+                this->progress = SRL::Math::Max<int32_t>(this->request.GetResult(), 0);
+                return this->request.GetStatus() == Cd::ReadRequest::Status::Completed && this->progress >= this->total ? Status::Completed : Status::Failed;
+            }
+
+        public:
+            /** @brief Read file into a buffer allocated by the job
+             * @param file File to read
+             * @param zone Memory zone to allocate buffer in (buffer is freed with the job)
+             */
+            ReadFileJob(Cd::File& file, const Memory::Zone zone = Memory::Zone::HWRam) :
+                Job(file.Size.Bytes), file(&file), data(nullptr), ownsData(false), zone(zone) { }
+
+            /** @brief Read file into a buffer
+             * @note Job fails when destination is not 4 byte aligned
+             * @param file File to read
+             * @param destination Buffer to read into (must be 4 byte aligned)
+             */
+            ReadFileJob(Cd::File& file, void* destination) :
+                Job(file.Size.Bytes), file(&file), data(reinterpret_cast<uint8_t*>(destination)), ownsData(false), zone(Memory::Zone::HWRam) { }
+
+            /** @brief Stop reading and free buffer allocated by the job
+             */
+            ~ReadFileJob()
+            {
+                this->request.Cancel();
+
+                if (this->ownsData)
+                {
+                    Memory::Free(this->data);
+                }
+            }
+
+            /** @brief Gets file data
+             * @return Buffer with file data (nullptr if job was not started yet)
+             */
+            uint8_t* GetData()
+            {
+                return this->data;
+            }
+
+            /** @brief Gets size of the file
+             * @return Number of bytes
+             */
+            int32_t GetSize() const
+            {
+                return this->total;
+            }
+        };
+
+        /** @brief Decode TGA image read by ReadFileJob
+         */
+        class DecodeTgaJob : public Job
+        {
+        private:
+            /** @brief Job reading the image file
+             */
+            ReadFileJob* source;
+
+            /** @brief TGA loader settings
+             */
+            Bitmap::TGA::LoaderSettings settings;
+
+            /** @brief Decoded image
+             */
+            Bitmap::TGA* image;
+
+            /** @brief Decode the image
+             * @return Status::Completed when image was decoded
+             */
+            Status Step() override
+            {
+                if (this->source->GetStatus() != Status::Completed || this->source->GetSize() == 0)
+                {
+                    return Status::Failed;
+                }
+
+                delete this->image;
+                this->image = new Bitmap::TGA(this->source->GetData(), this->settings);
+                this->progress = 1;
+                return Status::Completed;
+            }
+
+        public:
+            /** @brief Decode image once it is read
+             * @param source Job reading the image file (must be queued before this job)
+             * @param settings TGA loader settings
+             */
+            DecodeTgaJob(ReadFileJob& source, const Bitmap::TGA::LoaderSettings& settings = Bitmap::TGA::LoaderSettings()) :
+                Job(1), source(&source), settings(settings), image(nullptr) { }
+
+            /** @brief Free decoded image
+             */
+            ~DecodeTgaJob()
+            {
+                delete this->image;
+            }
+
+            /** @brief Gets decoded image
+             * @return Decoded image (nullptr if job is not completed)
+             */
+            Bitmap::TGA* GetImage()
+            {
+                return this->image;
+            }
+        };
+
+        /** @brief Upload image into VDP1 texture heap
+         */
+        class UploadTextureJob : public Job
+        {
+        private:
+            /** @brief Image to upload
+             */
+            Bitmap::IBitmap* bitmap;
+
+            /** @brief Job decoding the image (nullptr when image was given directly)
+             */
+            DecodeTgaJob* source;
+
+            /** @brief Palette loader for paletted images
+             */
+            int16_t (*paletteHandler)(Bitmap::BitmapInfo*);
+
+            /** @brief Index of the loaded texture
+             */
+            int32_t texture;
+
+            /** @brief Upload the image
+             * @return Status::Completed when texture was loaded
+             */
+            Status Step() override
+            {
+                if (this->source != nullptr)
+                {
+                    this->bitmap = this->source->GetImage();
+                }
+
+                if (this->bitmap == nullptr)
+                {
+                    return Status::Failed;
+                }
+
+                this->texture = VDP1::TryLoadTexture(this->bitmap, this->paletteHandler);
+                this->progress = 1;
+                return this->texture >= 0 ? Status::Completed : Status::Failed;
+            }
+
+        public:
+            /** @brief Upload image
+             * @param bitmap Image to upload
+             * @param paletteHandler Palette loader (see VDP1::TryLoadTexture(), only needed for paletted image)
+             */
+            UploadTextureJob(Bitmap::IBitmap& bitmap, int16_t (*paletteHandler)(Bitmap::BitmapInfo*) = nullptr) :
+                Job(1), bitmap(&bitmap), source(nullptr), paletteHandler(paletteHandler), texture(-1) { }
+
+            /** @brief Upload image once it is decoded
+             * @param source Job decoding the image (must be queued before this job)
+             * @param paletteHandler Palette loader (see VDP1::TryLoadTexture(), only needed for paletted image)
+             */
+            UploadTextureJob(DecodeTgaJob& source, int16_t (*paletteHandler)(Bitmap::BitmapInfo*) = nullptr) :
+                Job(1), bitmap(nullptr), source(&source), paletteHandler(paletteHandler), texture(-1) { }
+
+            /** @brief Gets index of the loaded texture
+             * @return Texture index, -1 if texture was not loaded
+             */
+            int32_t GetTexture() const
+            {
+                return this->texture;
+            }
+        };
+
+        /** @brief Load tilemap into VDP2 scroll screen
+         * @code {.cpp}
+         * SRL::AssetLoader::LoadTilemapJob job(tilemap, SRL::VDP2::NBG0::LoadTilemap);
+         * @endcode
+         */
+        class LoadTilemapJob : public Job
+        {
+        public:
+            /** @brief Scroll screen tilemap loader (e.g. VDP2::NBG0::LoadTilemap)
+             */
+            using Loader = void (*)(Tilemap::ITilemap&);
+
+        private:
+            /** @brief Tilemap to load
+             */
+            Tilemap::ITilemap* tilemap;
+
+            /** @brief Scroll screen tilemap loader
+             */
+            Loader loader;
+
+            /** @brief Load the tilemap
+             * @return Status::Completed
+             */
+            Status Step() override
+            {
+                this->loader(*this->tilemap);
+                this->progress = 1;
+                return Status::Completed;
+            }
+
+        public:
+            /** @brief Load tilemap into scroll screen
+             * @param tilemap Tilemap to load
+             * @param loader Scroll screen tilemap loader (e.g. VDP2::NBG0::LoadTilemap)
+             */
+            LoadTilemapJob(Tilemap::ITilemap& tilemap, const Loader loader) : Job(1), tilemap(&tilemap), loader(loader) { }
+        };
+
+    private:
+        /** @brief First job in the queue
+         */
+        inline static Job* head = nullptr;
+
+        /** @brief Last job in the queue
+         */
+        inline static Job* tail = nullptr;
+
+        /** @brief Time budget per frame in microseconds
+         */
+        inline static uint32_t budget = AssetLoader::DefaultBudget;
+
+        /** @brief Remove first job from the queue and notify listeners
+         * @param status Final state of the job
+         */
+        inline static void Finish(const Job::Status status)
+        {
+            Job* job = AssetLoader::head;
+            AssetLoader::head = job->next;
+
+            if (AssetLoader::head == nullptr)
+            {
+                AssetLoader::tail = nullptr;
+            }
+
+            job->next = nullptr;
+            job->status = status;
+
+            // Job can be destroyed or queued again from the event
+            job->OnCompleted.Invoke(*job);
+        }
+
+        /** @brief Remove job from the queue
+         * @param job Job to remove
+         */
+        inline static void Remove(Job& job)
+        {
+            if (job.status != Job::Status::Queued && job.status != Job::Status::Running)
+            {
+                return;
+            }
+
+            Job* previous = nullptr;
+
+            for (Job* current = AssetLoader::head; current != nullptr; previous = current, current = current->next)
+            {
+                if (current == &job)
+                {
+                    if (previous != nullptr)
+                    {
+                        previous->next = current->next;
+                    }
+                    else
+                    {
+                        AssetLoader::head = current->next;
+                    }
+
+                    if (AssetLoader::tail == current)
+                    {
+                        AssetLoader::tail = previous;
+                    }
+
+                    break;
+                }
+            }
+
+            job.next = nullptr;
+            job.status = Job::Status::Failed;
+        }
+
+    public:
+        /** @brief disable default constructor
+         */
+        AssetLoader() = delete;
+
+        /** @brief Add job to the end of the queue
+         * @param job Job to add (must stay alive until it is done)
+         * @return false if job is already queued
+         */
+        inline static bool Enqueue(Job& job)
+        {
+            if (job.status == Job::Status::Queued || job.status == Job::Status::Running)
+            {
+                return false;
+            }
+
+            job.status = Job::Status::Queued;
+            job.progress = 0;
+            job.next = nullptr;
+
+            if (AssetLoader::tail != nullptr)
+            {
+                AssetLoader::tail->next = &job;
+            }
+            else
+            {
+                AssetLoader::head = &job;
+            }
+
+            AssetLoader::tail = &job;
+            return true;
+        }
+
+        /** @brief Remove all jobs from the queue
+         */
+        inline static void CancelAll()
+        {
+            while (AssetLoader::head != nullptr)
+            {
+                AssetLoader::Remove(*AssetLoader::head);
+            }
+        }
+
+        /** @brief Check whether all jobs are done
+         * @return true if queue is empty
+         */
+        inline static bool IsIdle()
+        {
+            return AssetLoader::head == nullptr;
+        }
+
+        /** @brief Set time loader can spend working in each frame
+         * @param microseconds Time budget in microseconds
+         */
+        inline static void SetBudget(const uint32_t microseconds)
+        {
+            AssetLoader::budget = microseconds;
+        }
+
+        /** @brief Gets time loader can spend working in each frame
+         * @return Time budget in microseconds
+         */
+        inline static uint32_t GetBudget()
+        {
+            return AssetLoader::budget;
+        }
+
+        /** @brief Work on queued jobs until time budget runs out
+         * @details Each job gets at most one step per frame, next job is started only when previous job is done.
+         * @note Called from SRL::Core::Synchronize()
+         */
+        inline static void Update()
+        {
+            if (AssetLoader::head == nullptr)
+            {
+                return;
+            }
+
+            // Timer is 16 bit, longer budgets are cut to what it can measure
+            const uint16_t start = TIM_FRT_GET_16();
+            const uint32_t ticks = SRL::Math::Min<uint32_t>(static_cast<uint32_t>(TIM_FRT_MCR_TO_CNT(AssetLoader::budget)), 0xffff);
+
+            do
+            {
+                Job* job = AssetLoader::head;
+
+                if (job->status == Job::Status::Queued)
+                {
+                    job->status = Job::Status::Running;
+
+                    if (!job->Start())
+                    {
+                        AssetLoader::Finish(Job::Status::Failed);
+                        continue;
+                    }
+                }
+
+                const int32_t progress = job->progress;
+                const Job::Status status = job->Step();
+
+                if (job->progress != progress)
+                {
+                    job->OnProgress.Invoke(*job);
+
+                    if (job->status != Job::Status::Running)
+                    {
+                        // Job was cancelled from the event
+                        continue;
+                    }
+                }
+
+                if (status == Job::Status::Running)
+                {
+                    // Job continues in next frame
+                    return;
+                }
+
+                AssetLoader::Finish(status);
+            }
+            while (AssetLoader::head != nullptr && static_cast<uint16_t>(TIM_FRT_GET_16() - start) < ticks);
+        }
+    };
+}
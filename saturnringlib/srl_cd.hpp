@@ -2,6 +2,8 @@
 
 #include "srl_base.hpp"
 #include "srl_debug.hpp"
+#include "srl_event.hpp"
+#include "srl_memory.hpp"
 
 namespace SRL
 {
@@ -197,423 +199,2973 @@ namespace SRL
                 GFS_GetFileSize(handle, &this->SectorSize, &this->Sectors, &this->LastSectorSize);
                 this->Bytes = (this->SectorSize * (this->Sectors - 1)) + this->LastSectorSize;
             }
+
+            /** @brief Construct a new File Size object
+             * @param bytes Number of bytes the file takes
+             * @param sectorSize Size of the sector
+             */
+            FileSize(int32_t bytes, int32_t sectorSize) : Bytes(bytes), Sectors((bytes + sectorSize - 1) / sectorSize), SectorSize(sectorSize)
+            {
+                this->LastSectorSize = this->Sectors > 0 ? bytes - (sectorSize * (this->Sectors - 1)) : 0;
+            }
         };
 
-        /** @brief Disk file
+        /** @brief Traced file access
          */
-        struct File
+        enum class TraceOperation : uint8_t
         {
-        private:
-            /** @brief Maximal number of sectors to be read in a single pass
+            /** @brief Current directory was changed
              */
-            inline static const uint16_t SectorsToReadAtOnce = 5;
+            ChangeDir,
+
+            /** @brief File was opened
+             */
+            Open,
+
+            /** @brief File access pointer was moved
+             */
+            Seek,
+
+            /** @brief Data were read from open file
+             */
+            Read,
+
+            /** @brief Data were loaded without opening the file
+             */
+            Load
+        };
+
+        /** @brief Traced file access
+         */
+        struct TraceEvent
+        {
+            /** @brief Access type
+             */
+            TraceOperation Operation;
+
+            /** @brief Number of frames since start
+             */
+            uint32_t Frame;
 
             /** @brief File identifier
              */
-            int32_t identifier;
+            int32_t Identifier;
 
-            /** @brief Number of bytes read in total
+            /** @brief File or directory name (nullptr for root directory),
+             * full path from root directory for files opened through Cd::PathIndex
              */
-            int32_t readBytes;
+            const char* Name;
 
-            /** @brief File read buffer
+            /** @brief Byte offset from the start of the file
              */
-            uint8_t *workBuffer;
+            int32_t Offset;
+
+            /** @brief Number of bytes requested (file size for Open)
+             */
+            int32_t Size;
+        };
+
+        /** @brief Function receiving traced file accesses
+         */
+        using TraceHandler = void (*)(const TraceEvent& event);
+
+        struct File;
+
+        /** @brief Asynchronous read request
+         * @details Request is started by File::ReadSectorsAsync() or File::LoadBytesAsync() and processed in the background
+         * by Cd::Update(), which is called from SRL::Core::Synchronize(). Requests are served one by one in the order they were started.<br/>
+         * Request object must stay alive until it is done, destroying it cancels the read.
+         * @code {.cpp}
+         * SRL::Cd::File file("LEVEL1.BIN");
+         * SRL::Cd::ReadRequest request;
+         *
+         * // Get notified when data arrive
+         * request.OnCompleted += OnLevelLoaded;
+         * file.LoadBytesAsync(request, 0, file.Size.Bytes, levelData);
+         *
+         * // Game keeps running while data stream in
+         * while (!request.IsDone())
+         * {
+         *     DrawLoadingScreen();
+         *     SRL::Core::Synchronize();
+         * }
+         * @endcode
+         */
+        class ReadRequest
+        {
+        public:
+            /** @brief State of the request
+             */
+            enum class Status : uint8_t
+            {
+                /** @brief Request was not started yet
+                 */
+                Idle,
+
+                /** @brief Request waits for other requests to finish
+                 */
+                Queued,
+
+                /** @brief Data are being read
+                 */
+                Reading,
+
+                /** @brief All data were read
+                 */
+                Completed,
+
+                /** @brief Read failed or was cancelled
+                 */
+                Failed
+            };
+
+            /** @brief Event invoked from Cd::Update() when request is done (completed or failed)
+             */
+            SRL::Types::Event<ReadRequest&> OnCompleted;
+
+        private:
+            /** @brief Cd needs to be able to process requests
+             */
+            friend class Cd;
+
+            /** @brief File to read from
+             */
+            File* file;
+
+            /** @brief Buffer to read into
+             */
+            void* destination;
+
+            /** @brief Number of sectors to read
+             */
+            int32_t sectorCount;
+
+            /** @brief Number of bytes to read
+             */
+            int32_t size;
+
+            /** @brief Sector to start at (negative to continue from current position)
+             */
+            int32_t sectorOffset;
+
+            /** @brief Request continues from file access pointer and moves it behind data that were read
+             */
+            bool sequential;
+
+            /** @brief Number of bytes read or error code
+             */
+            int32_t result;
+
+            /** @brief Number of bytes already transferred into the buffer
+             */
+            int32_t progress;
+
+            /** @brief State of the request
+             */
+            volatile Status status;
+
+            /** @brief Next request in the queue
+             */
+            ReadRequest* next;
+
+        public:
+            /** @brief Construct idle request
+             */
+            ReadRequest() : file(nullptr), destination(nullptr), sectorCount(0), size(0), sectorOffset(-1), sequential(false), result(0), progress(0), status(Status::Idle), next(nullptr) { }
+
+            /** @brief Cancel request if it is still running
+             */
+            ~ReadRequest()
+            {
+                this->Cancel();
+            }
+
+            ReadRequest(const ReadRequest&) = delete;
+            ReadRequest& operator=(const ReadRequest&) = delete;
+
+            /** @brief Stop the request and remove it from the queue
+             * @note OnCompleted event is not invoked for cancelled request
+             */
+            void Cancel()
+            {
+                Cd::CancelRequest(*this);
+            }
+
+            /** @brief Gets state of the request
+             * @return Request state
+             */
+            Status GetStatus() const
+            {
+                return this->status;
+            }
+
+            /** @brief Check whether request is done
+             * @return true if request completed or failed
+             */
+            bool IsDone() const
+            {
+                return this->status == Status::Completed || this->status == Status::Failed;
+            }
+
+            /** @brief Gets result of the request
+             * @return Number of bytes read, negative Cd::ErrorCode on failure
+             */
+            int32_t GetResult() const
+            {
+                return this->result;
+            }
+
+            /** @brief Gets number of bytes already transferred into the buffer
+             * @details Updated by Cd::Update(), data before this offset can be used while the rest is still being read
+             * @return Number of bytes
+             */
+            int32_t GetProgress() const
+            {
+                return this->progress;
+            }
 
-            /** @brief Get the byte offset inside current work buffer
-             * @param absolute Absolute position
-             * @param workBufferSize Size of a work buffer
-             * @return size_t Position within work buffer
+            /** @brief Block until request is done
+             * @return Number of bytes read, negative Cd::ErrorCode on failure
              */
-            int32_t GetOffsetInWorkBuffer(int32_t absolute, int32_t workBufferSize)
+            int32_t Wait()
             {
-                if (absolute >= workBufferSize)
+                while (this->status == Status::Queued || this->status == Status::Reading)
                 {
-                    return absolute % workBufferSize;
+                    Cd::Update();
                 }
 
-                return absolute;
+                return this->result;
             }
+        };
 
+        /** @brief Cache of recently read CD sectors
+         * @details Sectors read by File::Read(), File::ReadSectors() and File::LoadBytes() are kept in memory, so loading the same
+         * data again (shared UI textures, sound effects, ...) is served from RAM without touching the drive.
+         * When the cache is full, least recently used sector is replaced.<br/>
+         * Sectors are identified by their absolute address on the disc, so a file keeps its cached sectors across Cd::ChangeDir() calls.<br/>
+         * Cache is created on CD initialization when @c SRL_CD_CACHE_SECTORS is set in makefile, or manually by calling Initialize().
+         * @code {.cpp}
+         * // Keep last 64 sectors (128KB) in cartridge RAM
+         * SRL::Cd::SectorCache::Initialize(64, SRL::Memory::Zone::CartRam);
+         *
+         * // Second load comes from the cache
+         * SRL::Cd::File file("UI.TGA");
+         * file.LoadBytes(0, file.Size.Bytes, buffer);
+         * file.LoadBytes(0, file.Size.Bytes, buffer);
+         *
+         * uint32_t hits = SRL::Cd::SectorCache::GetStatistics().Hits;
+         * @endcode
+         */
+        class SectorCache
+        {
         public:
-            /** @brief File handle
+            /** @brief Size of cached sector in bytes
              */
-            GfsHn Handle;
+            static constexpr int32_t SectorSize = 2048;
 
-            /** @brief Size of the file
+            /** @brief Cache statistics
              */
-            FileSize Size;
+            struct Statistics
+            {
+                /** @brief Number of sectors found in the cache
+                 */
+                uint32_t Hits;
 
-            /** @brief disable default constructor
+                /** @brief Number of sectors read from the disc
+                 */
+                uint32_t Misses;
+            };
+
+        private:
+            /** @brief File reads and stores sectors
              */
-            File() = delete;
+            friend struct File;
 
-            /** @brief Construct a new File object from Gfs handle and identifier
-             * @param handle Gfs handle
-             * @param fid File identifier
-             * @param getSize Fetch file size (will cause file to be open for a bit)
+            /** @brief Cached sector
              */
-            File(GfsHn handle, int32_t fid, bool getSize = true) : Handle(handle),
-                                                                   Size(getSize ? FileSize(handle) : FileSize()),
-                                                                   identifier(fid),
-                                                                   workBuffer(nullptr),
-                                                                   readBytes(0)
+            struct Slot
             {
-                #if defined(SRL_MAX_CD_FILES) && (SRL_MAX_CD_FILES < 1)
-                    static_assert(false, "SRL_MAX_CD_FILES is not set properly to instantiate this class");
-                #endif
+                /** @brief Absolute sector address on the disc (negative when slot is empty)
+                 */
+                int32_t Address;
+
+                /** @brief Next slot with the same hash
+                 */
+                int16_t Next;
+
+                /** @brief Slot used before this one
+                 */
+                int16_t Older;
+
+                /** @brief Slot used after this one
+                 */
+                int16_t Newer;
+            };
+
+            /** @brief Memory block containing sector data, slots and hash buckets
+             */
+            inline static uint8_t* storage = nullptr;
+
+            /** @brief Cached slots
+             */
+            inline static Slot* slots = nullptr;
+
+            /** @brief First slot for each hash
+             */
+            inline static int16_t* buckets = nullptr;
+
+            /** @brief Number of slots
+             */
+            inline static int16_t slotCount = 0;
+
+            /** @brief Number of hash buckets minus one
+             */
+            inline static int16_t bucketMask = 0;
+
+            /** @brief Least recently used slot
+             */
+            inline static int16_t oldest = -1;
+
+            /** @brief Most recently used slot
+             */
+            inline static int16_t newest = -1;
+
+            /** @brief Cache statistics
+             */
+            inline static Statistics statistics = { 0, 0 };
+
+            /** @brief Remove slot from the list of used slots
+             * @param slot Slot index
+             */
+            static void Unlink(int16_t slot)
+            {
+                Slot& entry = SectorCache::slots[slot];
+
+                if (entry.Older >= 0)
+                {
+                    SectorCache::slots[entry.Older].Newer = entry.Newer;
+                }
+                else
+                {
+                    SectorCache::oldest = entry.Newer;
+                }
+
+                if (entry.Newer >= 0)
+                {
+                    SectorCache::slots[entry.Newer].Older = entry.Older;
+                }
+                else
+                {
+                    SectorCache::newest = entry.Older;
+                }
             }
 
-            /** @brief Open a file on CD
-             * @param name File name
+            /** @brief Mark slot as most recently used
+             * @param slot Slot index
              */
-            File(const char *name) : Handle(nullptr),
-                                     Size(0),
-                                     identifier(-1),
-                                     workBuffer(nullptr),
-                                     readBytes(0)
+            static void Touch(int16_t slot)
             {
-                #if defined(SRL_MAX_CD_FILES) && (SRL_MAX_CD_FILES < 1)
-                    static_assert(false, "SRL_MAX_CD_FILES is not set properly to instantiate this class");
-                #endif
+                if (slot != SectorCache::newest)
+                {
+                    SectorCache::Unlink(slot);
+                    SectorCache::slots[slot].Older = SectorCache::newest;
+                    SectorCache::slots[slot].Newer = -1;
+                    SectorCache::slots[SectorCache::newest].Newer = slot;
+                    SectorCache::newest = slot;
+                }
+            }
+
+            /** @brief Find slot holding a sector
+             * @param address Absolute sector address on the disc
+             * @return Slot index or -1 if sector is not cached
+             */
+            static int16_t FindSlot(int32_t address)
+            {
+                int16_t slot = SectorCache::buckets[address & SectorCache::bucketMask];
 
-                if (name != nullptr)
+                while (slot >= 0 && SectorCache::slots[slot].Address != address)
                 {
-                    int32_t sectorSize;
-                    int32_t sectorCount;
-                    int32_t lastSectorSize;
-                    int32_t id = GFS_NameToId((int8_t *)name);
+                    slot = SectorCache::slots[slot].Next;
+                }
 
-                    if (id >= 0)
+                return slot;
+            }
+
+            /** @brief Check whether sector is cached without counting it in statistics
+             * @param address Absolute sector address on the disc
+             * @return true if sector is cached
+             */
+            static bool Contains(int32_t address)
+            {
+                return SectorCache::FindSlot(address) >= 0;
+            }
+
+            /** @brief Get cached sector and mark it as most recently used
+             * @param address Absolute sector address on the disc
+             * @return Sector data or nullptr if sector is not cached
+             */
+            static const uint8_t* Find(int32_t address)
+            {
+                const int16_t slot = SectorCache::FindSlot(address);
+
+                if (slot < 0)
+                {
+                    return nullptr;
+                }
+
+                SectorCache::statistics.Hits++;
+                SectorCache::Touch(slot);
+                return SectorCache::storage + (slot * SectorCache::SectorSize);
+            }
+
+            /** @brief Store sector in place of the least recently used one
+             * @param address Absolute sector address on the disc
+             * @param data Sector data
+             * @param size Number of valid bytes in the sector
+             */
+            static void Store(int32_t address, const void* data, int32_t size)
+            {
+                int16_t slot = SectorCache::FindSlot(address);
+
+                if (slot < 0)
+                {
+                    slot = SectorCache::oldest;
+                    Slot& entry = SectorCache::slots[slot];
+
+                    // Remove replaced sector from its hash chain
+                    if (entry.Address >= 0)
                     {
-                        this->identifier = id;
+                        int16_t* link = &SectorCache::buckets[entry.Address & SectorCache::bucketMask];
 
-                        if (this->Open())
-                        {
-                            this->Size = FileSize(this->Handle);
-                            this->Close();
-                        }
-                        else
+                        while (*link != slot)
                         {
-                            this->identifier = -1;
+                            link = &SectorCache::slots[*link].Next;
                         }
+
+                        *link = entry.Next;
                     }
+
+                    entry.Address = address;
+                    entry.Next = SectorCache::buckets[address & SectorCache::bucketMask];
+                    SectorCache::buckets[address & SectorCache::bucketMask] = slot;
                 }
+
+                Memory::Copy(SectorCache::storage + (slot * SectorCache::SectorSize), data, size);
+                SectorCache::Touch(slot);
             }
 
-            /** @brief Close file
+        public:
+            /** @brief disable default constructor
              */
-            ~File()
+            SectorCache() = delete;
+
+            /** @brief Create sector cache
+             * @note Previous cache is released
+             * @param sectorCount Number of sectors to keep (at most 16384)
+             * @param zone Memory zone to take cache memory from
+             * @return true if memory for the cache was allocated
+             */
+            static bool Initialize(int32_t sectorCount, const Memory::Zone zone = Memory::Zone::LWRam)
             {
-                this->Close();
+                SectorCache::Release();
+                sectorCount = SRL::Math::Min<int32_t>(sectorCount, 16384);
+
+                if (sectorCount <= 0)
+                {
+                    return false;
+                }
+
+                // Keep hash chains short
+                int32_t bucketCount = 1;
+
+                while (bucketCount < sectorCount * 2)
+                {
+                    bucketCount <<= 1;
+                }
+
+                SectorCache::storage = reinterpret_cast<uint8_t*>(Memory::Malloc(
+                    (sectorCount * (SectorCache::SectorSize + sizeof(Slot))) + (bucketCount * sizeof(int16_t)),
+                    zone));
+
+                if (SectorCache::storage == nullptr)
+                {
+                    return false;
+                }
+
+                SectorCache::slots = reinterpret_cast<Slot*>(SectorCache::storage + (sectorCount * SectorCache::SectorSize));
+                SectorCache::buckets = reinterpret_cast<int16_t*>(SectorCache::slots + sectorCount);
+                SectorCache::slotCount = sectorCount;
+                SectorCache::bucketMask = bucketCount - 1;
+                SectorCache::Clear();
+                return true;
             }
 
-            /**
-             * @name File handling and status
-             * @{
+            /** @brief Release memory of the sector cache
              */
+            static void Release()
+            {
+                void* block = SectorCache::storage;
+                SectorCache::storage = nullptr;
+                SectorCache::slots = nullptr;
+                SectorCache::buckets = nullptr;
+                SectorCache::slotCount = 0;
+                SectorCache::oldest = -1;
+                SectorCache::newest = -1;
+                Memory::Free(block);
+            }
 
-            /** @brief Close file
+            /** @brief Drop all cached sectors
              */
-            void Close()
+            static void Clear()
             {
-                if (this->Handle != nullptr)
+                for (int16_t slot = 0; slot < SectorCache::slotCount; slot++)
                 {
-                    GFS_Close(this->Handle);
-                    this->Handle = nullptr;
+                    SectorCache::slots[slot] = { -1, -1, static_cast<int16_t>(slot - 1), static_cast<int16_t>(slot + 1) };
                 }
 
-                if (this->workBuffer != nullptr)
+                for (int16_t bucket = 0; bucket <= SectorCache::bucketMask; bucket++)
                 {
-                    delete this->workBuffer;
-                    this->workBuffer = nullptr;
+                    SectorCache::buckets[bucket] = -1;
+                }
+
+                if (SectorCache::slotCount > 0)
+                {
+                    SectorCache::slots[SectorCache::slotCount - 1].Newer = -1;
+                    SectorCache::oldest = 0;
+                    SectorCache::newest = SectorCache::slotCount - 1;
                 }
             }
 
-            /** @brief Open file
-             * @return True on success
+            /** @brief Check whether cache is created
+             * @return true if sectors are being cached
+             */
+            static bool IsEnabled()
+            {
+                return SectorCache::storage != nullptr;
+            }
+
+            /** @brief Gets number of sectors cache can hold
+             * @return Number of sectors
+             */
+            static int32_t GetCapacity()
+            {
+                return SectorCache::slotCount;
+            }
+
+            /** @brief Gets cache statistics
+             * @return Number of hits and misses since last reset
+             */
+            static const Statistics& GetStatistics()
+            {
+                return SectorCache::statistics;
+            }
+
+            /** @brief Reset cache statistics
+             */
+            static void ResetStatistics()
+            {
+                SectorCache::statistics = { 0, 0 };
+            }
+        };
+
+        /** @brief Index of all files and directories on the disc
+         * @details Built once by Cd::Initialize() (see @c SRL_CD_PATH_INDEX), it keeps directory table of every directory
+         * in memory together with a hash table of full paths. Files can then be opened by path (e.g. "DIR/FILE.BIN")
+         * and Cd::ChangeDir() switches between cached tables, neither of them touches the drive.<br/>
+         * Each file or directory takes 24 bytes of directory table and 2 slots of 8 bytes in the hash table.
+         * Paths are case insensitive, both '/' and '\\' work as separator, path starting with separator is relative to root directory.
+         * @code {.cpp}
+         * // No seek to the directory table of LEVEL1
+         * SRL::Cd::File file("LEVEL1/MAP.BIN");
+         *
+         * uint16_t count = SRL::Cd::PathIndex::GetFileCount();
+         * @endcode
+         */
+        class PathIndex
+        {
+        private:
+            /** @brief Files and Cd resolve paths through the index
+             */
+            friend struct File;
+            friend class Cd;
+
+            /** @brief Cached directory
+             */
+            struct Directory
+            {
+                /** @brief Directory table in the format GFS uses
+                 */
+                GfsDirTbl Table;
+
+                /** @brief Hash of the full path of the directory
+                 */
+                uint32_t PathHash;
+
+                /** @brief Parent directory (-1 for root directory)
+                 */
+                int16_t Parent;
+
+                /** @brief File identifier of the directory in its parent
+                 */
+                int16_t Identifier;
+            };
+
+            /** @brief Hash table slot
+             */
+            struct Entry
+            {
+                /** @brief Hash of the full path
+                 */
+                uint32_t PathHash;
+
+                /** @brief Directory containing the entry (-1 for an empty slot)
+                 */
+                int16_t Directory;
+
+                /** @brief File identifier in the directory
+                 */
+                int16_t Identifier;
+            };
+
+            /** @brief Cached directories, root directory is first
+             */
+            inline static Directory* directories = nullptr;
+
+            /** @brief Hash table of all paths
+             */
+            inline static Entry* entries = nullptr;
+
+            /** @brief Number of cached directories
+             */
+            inline static int16_t directoryCount = 0;
+
+            /** @brief Number of files and directories in the index
+             */
+            inline static uint16_t fileCount = 0;
+
+            /** @brief Number of hash table slots minus one
+             */
+            inline static uint32_t entryMask = 0;
+
+            /** @brief Current directory
+             */
+            inline static int16_t current = 0;
+
+            /** @brief Directory table GFS is set to
+             */
+            inline static int16_t active = 0;
+
+            /** @brief Copy name of a directory record without version suffix
+             * @param record Directory record
+             * @param name Buffer for the name
+             */
+            static void GetName(const GfsDirName& record, char (&name)[GFS_FNAME_LEN + 1])
+            {
+                int32_t length = 0;
+
+                while (length < GFS_FNAME_LEN && record.fname[length] != '\0' && record.fname[length] != ';')
+                {
+                    name[length] = record.fname[length];
+                    length++;
+                }
+
+                name[length] = '\0';
+            }
+
+            /** @brief Compare names case insensitive
+             * @param recordName Name from directory record
+             * @param name Name to compare with
+             * @return true if names are same
+             */
+            static bool IsSameName(const char* recordName, const char* name)
+            {
+                for (; *recordName != '\0'; recordName++, name++)
+                {
+                    const char character = *name >= 'a' && *name <= 'z' ? *name - ('a' - 'A') : *name;
+
+                    if (character != (*recordName >= 'a' && *recordName <= 'z' ? *recordName - ('a' - 'A') : *recordName))
+                    {
+                        return false;
+                    }
+                }
+
+                return *name == '\0';
+            }
+
+            /** @brief Hash of a path continuing from a directory
+             * @param directory Directory the path starts in
+             * @param path Path relative to the directory
+             * @return Hash of the full path
+             */
+            static uint32_t Hash(const int16_t directory, const char* path)
+            {
+                const uint32_t hash = PathIndex::directories[directory].PathHash;
+                return Pack::Hash(path, directory > 0 ? Pack::Hash("/", hash) : hash);
+            }
+
+            /** @brief Make GFS use table of a directory for calls taking file identifier
+             * @param directory Cached directory
+             */
+            static void Select(const int16_t directory)
+            {
+                if (directory != PathIndex::active && directory >= 0 && directory < PathIndex::directoryCount)
+                {
+                    GFS_SetDir(&PathIndex::directories[directory].Table);
+                    PathIndex::active = directory;
+                }
+            }
+
+            /** @brief Gets directory record of an entry
+             * @param directory Cached directory
+             * @param identifier File identifier in the directory
+             * @return Directory record
+             */
+            static const GfsDirName& GetRecord(const int16_t directory, const int16_t identifier)
+            {
+                return GFS_DIRTBL_DIRNAME(&PathIndex::directories[directory].Table)[identifier];
+            }
+
+            /** @brief Add directory to the list of cached directories
+             * @param directory Directory to add
+             * @param capacity Number of directories the list can hold, grows when full
+             * @param zone Memory zone of the list
+             * @return true on success
+             */
+            static bool AddDirectory(const Directory& directory, int16_t& capacity, const Memory::Zone zone)
+            {
+                if (PathIndex::directoryCount == capacity)
+                {
+                    Directory* grown = reinterpret_cast<Directory*>(Memory::Malloc(capacity * 2 * sizeof(Directory), zone));
+
+                    if (grown == nullptr)
+                    {
+                        return false;
+                    }
+
+                    Memory::Copy(grown, PathIndex::directories, capacity * sizeof(Directory));
+                    Memory::Free(PathIndex::directories);
+                    PathIndex::directories = grown;
+                    capacity *= 2;
+                }
+
+                PathIndex::directories[PathIndex::directoryCount++] = directory;
+                return true;
+            }
+
+            /** @brief Load directory table into memory owned by the index
+             * @param identifier Identifier of the directory in the directory table GFS is set to (0 for the directory itself)
+             * @param scratch Buffer for up to SRL_MAX_CD_FILES records
+             * @param table Loaded table
+             * @param zone Memory zone to keep the table in
+             * @return true on success
+             */
+            static bool LoadTable(const int32_t identifier, GfsDirName* scratch, GfsDirTbl& table, const Memory::Zone zone)
+            {
+                GfsDirTbl loaded;
+                GFS_DIRTBL_TYPE(&loaded) = GFS_DIR_NAME;
+                GFS_DIRTBL_DIRNAME(&loaded) = scratch;
+                GFS_DIRTBL_NDIR(&loaded) = SRL_MAX_CD_FILES;
+
+                const int32_t count = GFS_LoadDir(identifier, &loaded);
+                GfsDirName* names = count > 0 ? reinterpret_cast<GfsDirName*>(Memory::Malloc(count * sizeof(GfsDirName), zone)) : nullptr;
+
+                if (names == nullptr)
+                {
+                    return false;
+                }
+
+                Memory::Copy(names, scratch, count * sizeof(GfsDirName));
+                GFS_DIRTBL_TYPE(&table) = GFS_DIR_NAME;
+                GFS_DIRTBL_DIRNAME(&table) = names;
+                GFS_DIRTBL_NDIR(&table) = count;
+                return true;
+            }
+
+            /** @brief Find file or directory
+             * @param directory Directory relative path starts in
+             * @param path Path to the file or directory
+             * @param found Directory containing the file
+             * @param identifier File identifier in that directory
+             * @return true if path exists
+             */
+            static bool Find(int16_t directory, const char* path, int16_t& found, int16_t& identifier)
+            {
+                if (path == nullptr || PathIndex::entries == nullptr)
+                {
+                    return false;
+                }
+
+                if (*path == '/' || *path == '\\')
+                {
+                    directory = 0;
+                    path++;
+                }
+
+                const char* name = path;
+
+                for (const char* character = path; *character != '\0'; character++)
+                {
+                    if (*character == '/' || *character == '\\')
+                    {
+                        name = character + 1;
+                    }
+                }
+
+                const uint32_t hash = PathIndex::Hash(directory, path);
+
+                for (uint32_t index = hash & PathIndex::entryMask; PathIndex::entries[index].Directory >= 0; index = (index + 1) & PathIndex::entryMask)
+                {
+                    const Entry& entry = PathIndex::entries[index];
+
+                    if (entry.PathHash == hash)
+                    {
+                        // Hash covers the whole path, names are compared to rule out a collision
+                        char recordName[GFS_FNAME_LEN + 1];
+                        PathIndex::GetName(PathIndex::GetRecord(entry.Directory, entry.Identifier), recordName);
+
+                        if (PathIndex::IsSameName(recordName, name))
+                        {
+                            found = entry.Directory;
+                            identifier = entry.Identifier;
+                            return true;
+                        }
+                    }
+                }
+
+                return false;
+            }
+
+            /** @brief Find cached directory
+             * @param parent Parent directory
+             * @param identifier File identifier of the directory in its parent
+             * @return Cached directory or -1 if entry is not a directory
+             */
+            static int16_t FindDirectory(const int16_t parent, const int16_t identifier)
+            {
+                for (int16_t directory = 1; directory < PathIndex::directoryCount; directory++)
+                {
+                    if (PathIndex::directories[directory].Parent == parent && PathIndex::directories[directory].Identifier == identifier)
+                    {
+                        return directory;
+                    }
+                }
+
+                return -1;
+            }
+
+            /** @brief Write full path of an entry
+             * @param directory Directory containing the entry
+             * @param identifier File identifier in the directory
+             * @param path Buffer for the path
+             * @param length Number of characters already in the buffer
+             * @param size Size of the buffer
+             * @return Number of characters in the buffer
+             */
+            static int32_t GetPath(const int16_t directory, const int16_t identifier, char* path, int32_t length, const int32_t size)
+            {
+                if (directory > 0)
+                {
+                    length = PathIndex::GetPath(PathIndex::directories[directory].Parent, PathIndex::directories[directory].Identifier, path, length, size);
+
+                    if (length < size - 1)
+                    {
+                        path[length++] = '/';
+                    }
+                }
+
+                char name[GFS_FNAME_LEN + 1];
+                PathIndex::GetName(PathIndex::GetRecord(directory, identifier), name);
+
+                for (const char* character = name; *character != '\0' && length < size - 1; character++)
+                {
+                    path[length++] = *character;
+                }
+
+                path[length] = '\0';
+                return length;
+            }
+
+            /** @brief Change current directory
+             * @param path Path to the directory (nullptr for root directory)
+             * @return true if directory was changed
+             */
+            static bool ChangeDir(const char* path)
+            {
+                int16_t directory = 0;
+
+                if (path != nullptr && path[0] == '.' && path[1] == '.' && path[2] == '\0')
+                {
+                    directory = SRL::Math::Max<int16_t>(PathIndex::directories[PathIndex::current].Parent, 0);
+                }
+                else if (path != nullptr && path[0] == '.' && path[1] == '\0')
+                {
+                    directory = PathIndex::current;
+                }
+                else if (path != nullptr && path[0] != '\0')
+                {
+                    int16_t parent;
+                    int16_t identifier;
+
+                    if (!PathIndex::Find(PathIndex::current, path, parent, identifier) ||
+                        (directory = PathIndex::FindDirectory(parent, identifier)) < 0)
+                    {
+                        return false;
+                    }
+                }
+
+                PathIndex::current = directory;
+                PathIndex::Select(directory);
+                return true;
+            }
+
+        public:
+            /** @brief disable default constructor
+             */
+            PathIndex() = delete;
+
+            /** @brief Build the index by reading all directory tables
+             * @note Previous index is released, current directory becomes root directory
+             * @param zone Memory zone to keep the index in
+             * @return true if whole disc was indexed
+             */
+            static bool Initialize(const Memory::Zone zone = Memory::Zone::LWRam)
+            {
+                PathIndex::Release();
+
+                GfsDirName* scratch = reinterpret_cast<GfsDirName*>(Memory::Malloc(SRL_MAX_CD_FILES * sizeof(GfsDirName), zone));
+                int16_t capacity = 8;
+                PathIndex::directories = reinterpret_cast<Directory*>(Memory::Malloc(capacity * sizeof(Directory), zone));
+                bool success = scratch != nullptr && PathIndex::directories != nullptr;
+
+                // Root directory table is current after GFS_Init(), identifier 0 is the directory itself
+                Directory root = { {}, Pack::Hash(""), -1, 0 };
+                success = success && PathIndex::LoadTable(0, scratch, root.Table, zone);
+
+                if (success)
+                {
+                    // List has room for the first directory
+                    PathIndex::AddDirectory(root, capacity, zone);
+                }
+                int32_t total = 0;
+
+                // Breadth first, list grows while it is walked
+                for (int16_t directory = 0; success && directory < PathIndex::directoryCount; directory++)
+                {
+                    PathIndex::active = -1;
+                    PathIndex::Select(directory);
+                    const int32_t count = GFS_DIRTBL_NDIR(&PathIndex::directories[directory].Table);
+
+                    // Identifiers 0 and 1 are the directory itself and its parent
+                    for (int16_t identifier = 2; success && identifier < count; identifier++)
+                    {
+                        const GfsDirName& record = PathIndex::GetRecord(directory, identifier);
+                        total++;
+
+                        if ((GFS_DIR_ATR(&record) & GFS_ATR_DIR) != 0)
+                        {
+                            char name[GFS_FNAME_LEN + 1];
+                            PathIndex::GetName(record, name);
+
+                            Directory child = { {}, PathIndex::Hash(directory, name), directory, identifier };
+                            success = PathIndex::LoadTable(identifier, scratch, child.Table, zone);
+
+                            if (success && !PathIndex::AddDirectory(child, capacity, zone))
+                            {
+                                Memory::Free(GFS_DIRTBL_DIRNAME(&child.Table));
+                                success = false;
+                            }
+                        }
+                    }
+                }
+
+                Memory::Free(scratch);
+
+                // Keep probe sequences short
+                uint32_t slotCount = 2;
+
+                while (slotCount < static_cast<uint32_t>(total) * 2)
+                {
+                    slotCount <<= 1;
+                }
+
+                PathIndex::entries = success ? reinterpret_cast<Entry*>(Memory::Malloc(slotCount * sizeof(Entry), zone)) : nullptr;
+
+                if (PathIndex::entries == nullptr)
+                {
+                    PathIndex::Release();
+                    return false;
+                }
+
+                PathIndex::entryMask = slotCount - 1;
+
+                for (uint32_t slot = 0; slot < slotCount; slot++)
+                {
+                    PathIndex::entries[slot] = { 0, -1, -1 };
+                }
+
+                for (int16_t directory = 0; directory < PathIndex::directoryCount; directory++)
+                {
+                    const int32_t count = GFS_DIRTBL_NDIR(&PathIndex::directories[directory].Table);
+
+                    for (int16_t identifier = 2; identifier < count; identifier++)
+                    {
+                        char name[GFS_FNAME_LEN + 1];
+                        PathIndex::GetName(PathIndex::GetRecord(directory, identifier), name);
+                        const uint32_t hash = PathIndex::Hash(directory, name);
+                        uint32_t index = hash & PathIndex::entryMask;
+
+                        while (PathIndex::entries[index].Directory >= 0)
+                        {
+                            index = (index + 1) & PathIndex::entryMask;
+                        }
+
+                        PathIndex::entries[index] = { hash, directory, identifier };
+                    }
+                }
+
+                PathIndex::fileCount = total;
+                PathIndex::current = 0;
+                PathIndex::Select(0);
+                return true;
+            }
+
+            /** @brief Release memory of the index
+             * @note Cd::ChangeDir() and Cd::File read directory tables from the disc again
+             */
+            static void Release()
+            {
+                if (PathIndex::directoryCount > 0)
+                {
+                    // GFS must not be left with a table that is about to be freed, root directory table is copied back
+                    const GfsDirTbl& root = PathIndex::directories[0].Table;
+                    const int32_t count = SRL::Math::Min<int32_t>(GFS_DIRTBL_NDIR(&root), SRL_MAX_CD_FILES);
+                    Memory::Copy(Cd::GfsDirectoryNames, GFS_DIRTBL_DIRNAME(&root), count * sizeof(GfsDirName));
+                    GFS_DIRTBL_TYPE(&Cd::GfsDirectories) = GFS_DIR_NAME;
+                    GFS_DIRTBL_DIRNAME(&Cd::GfsDirectories) = Cd::GfsDirectoryNames;
+                    GFS_DIRTBL_NDIR(&Cd::GfsDirectories) = count;
+                    GFS_SetDir(&Cd::GfsDirectories);
+
+                    for (int16_t directory = 0; directory < PathIndex::directoryCount; directory++)
+                    {
+                        Memory::Free(GFS_DIRTBL_DIRNAME(&PathIndex::directories[directory].Table));
+                    }
+                }
+
+                Memory::Free(PathIndex::directories);
+                Memory::Free(PathIndex::entries);
+                PathIndex::directories = nullptr;
+                PathIndex::entries = nullptr;
+                PathIndex::directoryCount = 0;
+                PathIndex::fileCount = 0;
+                PathIndex::entryMask = 0;
+                PathIndex::current = 0;
+                PathIndex::active = 0;
+            }
+
+            /** @brief Check whether index is built
+             * @return true if paths are resolved from memory
+             */
+            static bool IsEnabled()
+            {
+                return PathIndex::entries != nullptr;
+            }
+
+            /** @brief Gets number of directories on the disc, including root directory
+             * @return Number of directories
+             */
+            static int16_t GetDirectoryCount()
+            {
+                return PathIndex::directoryCount;
+            }
+
+            /** @brief Gets number of files and directories in the index
+             * @return Number of entries
+             */
+            static uint16_t GetFileCount()
+            {
+                return PathIndex::fileCount;
+            }
+        };
+
+        /** @brief Pool of open GFS file handles shared by all files
+         * @details GFS can keep only @c SRL_MAX_CD_BACKGROUND_JOBS files open at once. Files get their handle from the pool
+         * when they need to read and keep it afterwards, so reading the same files again does not open them again.
+         * When all handles are taken, handle of the least recently used file is closed and given to the file that needs it.
+         * File keeps its access position, its handle is opened again on the next read.<br/>
+         * Handle of a file that is being read in the background or that was pinned (see HandlePool::Pin()) is never taken away.
+         * Libraries opening GFS files by themselves (e.g. SRL::Stream) take a handle out of the pool by HandlePool::Reserve() first.
+         * Statistics tell how often handles were taken away, high number of evictions means files compete for too few handles.
+         * @code {.cpp}
+         * SRL::Cd::File level("LEVEL.BIN");
+         * SRL::Cd::File sprites("SPRITES.BIN");
+         * level.Open();
+         * ...
+         * // Level keeps its handle and position when there are enough handles
+         * sprites.LoadBytes(0, size, buffer);
+         * level.Read(64, header);
+         *
+         * uint32_t evictions = SRL::Cd::HandlePool::GetStatistics().Evictions;
+         * @endcode
+         */
+        class HandlePool
+        {
+        public:
+            /** @brief Number of handles in the pool
+             */
+            static constexpr int32_t Capacity = SRL_MAX_CD_BACKGROUND_JOBS;
+
+            /** @brief Pool statistics
+             */
+            struct Statistics
+            {
+                /** @brief Number of times file already had its handle
+                 */
+                uint32_t Hits;
+
+                /** @brief Number of handles opened
+                 */
+                uint32_t Opens;
+
+                /** @brief Number of handles closed to make room for another file
+                 */
+                uint32_t Evictions;
+            };
+
+        private:
+            /** @brief Files acquire and release handles
+             */
+            friend struct File;
+
+            /** @brief Files holding a handle from the pool (nullptr for free slot)
+             */
+            inline static File* owners[HandlePool::Capacity] = { nullptr };
+
+            /** @brief Slots given to libraries that open GFS files by themselves
+             */
+            inline static bool reserved[HandlePool::Capacity] = { false };
+
+            /** @brief Time of the last use of each slot
+             */
+            inline static uint32_t lastUse[HandlePool::Capacity] = { 0 };
+
+            /** @brief Time of the last use
+             */
+            inline static uint32_t clock = 0;
+
+            /** @brief Pool statistics
+             */
+            inline static Statistics statistics = { 0, 0, 0 };
+
+            /** @brief Find slot of a file
+             * @param file File to look for (nullptr for free slot)
+             * @return Slot index or -1 if not found
+             */
+            static int32_t FindSlot(const File* file)
+            {
+                for (int32_t slot = 0; slot < HandlePool::Capacity; slot++)
+                {
+                    if (HandlePool::owners[slot] == file && (file != nullptr || !HandlePool::reserved[slot]))
+                    {
+                        return slot;
+                    }
+                }
+
+                return -1;
+            }
+
+            /** @brief Close handle of the least recently used file that can give it away
+             * @return Freed slot or -1 if all handles are in use
+             */
+            static int32_t Evict()
+            {
+                int32_t oldest = -1;
+
+                for (int32_t slot = 0; slot < HandlePool::Capacity; slot++)
+                {
+                    const File* owner = HandlePool::owners[slot];
+
+                    if (owner != nullptr &&
+                        !owner->pinned &&
+                        (Cd::requestHead == nullptr || Cd::requestHead->file != owner) &&
+                        (oldest < 0 || HandlePool::lastUse[slot] < HandlePool::lastUse[oldest]))
+                    {
+                        oldest = slot;
+                    }
+                }
+
+                if (oldest >= 0)
+                {
+                    File* owner = HandlePool::owners[oldest];
+                    GFS_Close(owner->Handle);
+                    owner->Handle = nullptr;
+                    HandlePool::owners[oldest] = nullptr;
+                    HandlePool::statistics.Evictions++;
+                }
+
+                return oldest;
+            }
+
+            /** @brief Make sure file has an open handle
+             * @param file File needing a handle
+             * @return true if file has a handle
+             */
+            static bool Acquire(File& file)
+            {
+                if (file.Handle != nullptr)
+                {
+                    const int32_t slot = HandlePool::FindSlot(&file);
+
+                    if (slot >= 0)
+                    {
+                        HandlePool::lastUse[slot] = ++HandlePool::clock;
+                    }
+
+                    HandlePool::statistics.Hits++;
+                    return true;
+                }
+                else if (file.identifier < 0)
+                {
+                    return false;
+                }
+
+                int32_t slot = HandlePool::FindSlot(nullptr);
+
+                if (slot < 0)
+                {
+                    slot = HandlePool::Evict();
+                }
+
+                while (slot >= 0)
+                {
+                    PathIndex::Select(file.directory);
+                    file.Handle = GFS_Open(file.identifier);
+                    PathIndex::Select(PathIndex::current);
+
+                    if (file.Handle != nullptr)
+                    {
+                        HandlePool::owners[slot] = &file;
+                        HandlePool::lastUse[slot] = ++HandlePool::clock;
+                        HandlePool::statistics.Opens++;
+                        return true;
+                    }
+
+                    // GFS handles are also taken by streams and movies, try to free one more
+                    slot = HandlePool::Evict() >= 0 ? slot : -1;
+                }
+
+                return false;
+            }
+
+            /** @brief Close handle of a file
+             * @param file File giving its handle back
+             */
+            static void Release(File& file)
+            {
+                const int32_t slot = HandlePool::FindSlot(&file);
+
+                if (slot >= 0)
+                {
+                    HandlePool::owners[slot] = nullptr;
+                }
+
+                if (file.Handle != nullptr)
+                {
+                    GFS_Close(file.Handle);
+                    file.Handle = nullptr;
+                }
+
+                // Next handle of the file can be taken away again
+                file.pinned = false;
+            }
+
+        public:
+            /** @brief disable default constructor
+             */
+            HandlePool() = delete;
+
+            /** @brief Keep handle of a file open until it is unpinned
+             * @details Needed when the handle is given to other library (e.g. SRL::Movie passes it to CPK)
+             * @param file File to pin
+             * @return true if file has an open handle
+             */
+            static bool Pin(File& file)
+            {
+                file.pinned = HandlePool::Acquire(file);
+                return file.pinned;
+            }
+
+            /** @brief Allow handle of a file to be given to other files
+             * @param file File to unpin
+             */
+            static void Unpin(File& file)
+            {
+                file.pinned = false;
+            }
+
+            /** @brief Take a handle out of the pool for a library that opens GFS file by itself
+             * @details Handle of the least recently used file is closed when there is no free one, so GFS can open the file.
+             * Handle is not given to files until HandlePool::Unreserve() is called.
+             * @return Reserved slot or -1 if all handles are in use
+             */
+            static int32_t Reserve()
+            {
+                int32_t slot = HandlePool::FindSlot(nullptr);
+
+                if (slot < 0)
+                {
+                    slot = HandlePool::Evict();
+                }
+
+                if (slot >= 0)
+                {
+                    HandlePool::reserved[slot] = true;
+                }
+
+                return slot;
+            }
+
+            /** @brief Give reserved handle back to the pool
+             * @param slot Slot returned by HandlePool::Reserve()
+             */
+            static void Unreserve(const int32_t slot)
+            {
+                if (slot >= 0 && slot < HandlePool::Capacity)
+                {
+                    HandlePool::reserved[slot] = false;
+                }
+            }
+
+            /** @brief Gets number of files holding a handle from the pool
+             * @return Number of open handles
+             */
+            static int32_t GetOpenCount()
+            {
+                int32_t count = 0;
+
+                for (const File* owner : HandlePool::owners)
+                {
+                    count += owner != nullptr ? 1 : 0;
+                }
+
+                return count;
+            }
+
+            /** @brief Gets pool statistics
+             * @return Number of hits, opened and evicted handles since last reset
+             */
+            static const Statistics& GetStatistics()
+            {
+                return HandlePool::statistics;
+            }
+
+            /** @brief Reset pool statistics
+             */
+            static void ResetStatistics()
+            {
+                HandlePool::statistics = { 0, 0, 0 };
+            }
+        };
+
+        /** @brief Disk file
+         */
+        struct File
+        {
+        private:
+            /** @brief Cd needs to be able to process read requests
+             */
+            friend class Cd;
+
+            /** @brief Handle pool opens and closes file handles
+             */
+            friend class HandlePool;
+
+            /** @brief Maximal number of sectors to be read in a single pass
+             */
+            inline static const uint16_t SectorsToReadAtOnce = 5;
+
+            /** @brief File identifier
+             */
+            int32_t identifier;
+
+            /** @brief Absolute address of the first sector of the file on the disc (negative when unknown)
+             */
+            int32_t discAddress;
+
+            /** @brief Directory of the file in Cd::PathIndex (negative when file identifier is from current directory)
+             */
+            int16_t directory;
+
+            /** @brief Number of bytes read in total
+             */
+            int32_t readBytes;
+
+            /** @brief File was opened by File::Open() (handle can be closed by Cd::HandlePool in the meantime)
+             */
+            bool opened;
+
+            /** @brief Handle must not be taken away by Cd::HandlePool
+             */
+            bool pinned;
+
+            /** @brief File read buffer
+             */
+            uint8_t *workBuffer;
+
+            /** @brief Byte offset in the file of the first byte in work buffer
+             */
+            int32_t workBufferStart;
+
+            /** @brief Number of valid bytes in work buffer (0 when buffer holds no data)
+             */
+            int32_t workBufferLength;
+
+            /** @brief Check whether byte at given offset is already in the work buffer
+             * @param offset Offset from start of the file
+             * @return true if byte can be copied from work buffer without reading the disk
+             */
+            bool IsInWorkBuffer(int32_t offset)
+            {
+                return this->workBuffer != nullptr &&
+                    offset >= this->workBufferStart &&
+                    offset < this->workBufferStart + this->workBufferLength;
+            }
+
+            /** @brief Move GFS access pointer to a sector, if it is not there already
+             * @param sector Sector number from start of the file
+             * @return Negative on error
+             */
+            int32_t SeekSector(int32_t sector)
+            {
+                if (GFS_Tell(this->Handle) == sector)
+                {
+                    return ErrorCode::ErrorOk;
+                }
+
+                return GFS_Seek(this->Handle, sector, Cd::SeekMode::Absolute);
+            }
+
+            /** @brief Get absolute address of the first sector of a file on the disc
+             * @param fid File identifier in current directory
+             * @return Sector address or -1 if file does not exist
+             */
+            static int32_t GetDiscAddress(int32_t fid)
+            {
+                GfsDirId info;
+                return fid >= 0 && GFS_GetDirInfo(fid, &info) == GFS_ERR_OK ? GFS_DIR_FAD(&info) : -1;
+            }
+
+            /** @brief Read data starting at a sector boundary from the disc
+             * @param sector Sector number from start of the file
+             * @param size Number of bytes to read
+             * @param destination Buffer to read into
+             * @return Number of bytes read (if lower than 0, error was encountered)
+             */
+            int32_t ReadFromDisk(int32_t sector, int32_t size, uint8_t* destination)
+            {
+                // GFS_Fread() transfers only into 4 byte aligned buffers
+                if ((reinterpret_cast<uintptr_t>(destination) & 3) != 0 || !HandlePool::Acquire(*this))
+                {
+                    // Let GFS open the file just for this load
+                    PathIndex::Select(this->directory);
+                    const int32_t result = GFS_Load(this->identifier, sector, destination, size);
+                    PathIndex::Select(PathIndex::current);
+                    return result;
+                }
+
+                const int32_t sectors = (size + this->Size.SectorSize - 1) / this->Size.SectorSize;
+                int32_t result = this->SeekSector(sector);
+
+                if (result >= 0)
+                {
+                    result = GFS_Fread(this->Handle, sectors, destination, size);
+                }
+
+                return result < 0 ? result : SRL::Math::Min<int32_t>(result, size);
+            }
+
+            /** @brief Read data starting at a sector boundary, sectors present in Cd::SectorCache are not read from the disc
+             * @param sector Sector number from start of the file
+             * @param size Number of bytes to read
+             * @param destination Buffer to read into (must hold whole sectors when file is open)
+             * @return Number of bytes read (if lower than 0, error was encountered)
+             */
+            int32_t ReadCached(int32_t sector, int32_t size, uint8_t* destination)
+            {
+                if (!SectorCache::IsEnabled() || this->discAddress < 0 || this->Size.SectorSize != SectorCache::SectorSize)
+                {
+                    return this->ReadFromDisk(sector, size, destination);
+                }
+
+                size = SRL::Math::Min<int32_t>(size, this->Size.Bytes - (sector * SectorCache::SectorSize));
+                int32_t done = 0;
+
+                while (done < size)
+                {
+                    const uint8_t* cached = SectorCache::Find(this->discAddress + sector);
+
+                    if (cached != nullptr)
+                    {
+                        const int32_t length = SRL::Math::Min<int32_t>(size - done, SectorCache::SectorSize);
+                        Memory::Copy(destination + done, cached, length);
+                        done += length;
+                        sector++;
+                        continue;
+                    }
+
+                    // Read all following sectors missing in the cache at once
+                    int32_t count = 1;
+
+                    while (count * SectorCache::SectorSize < size - done && !SectorCache::Contains(this->discAddress + sector + count))
+                    {
+                        count++;
+                    }
+
+                    const int32_t length = SRL::Math::Min<int32_t>(size - done, count * SectorCache::SectorSize);
+                    const int32_t read = this->ReadFromDisk(sector, length, destination + done);
+
+                    if (read < 0)
+                    {
+                        return read;
+                    }
+
+                    SectorCache::statistics.Misses += count;
+
+                    // Keep sectors that arrived whole, last sector of the file is whole when it was read up to the end of the file
+                    for (int32_t index = 0; index < count; index++)
+                    {
+                        const int32_t start = index * SectorCache::SectorSize;
+                        const int32_t sectorBytes = SRL::Math::Min<int32_t>(
+                            SectorCache::SectorSize,
+                            this->Size.Bytes - ((sector + index) * SectorCache::SectorSize));
+
+                        if (read < start + sectorBytes)
+                        {
+                            break;
+                        }
+
+                        SectorCache::Store(this->discAddress + sector + index, destination + done + start, sectorBytes);
+                    }
+
+                    done += read;
+                    sector += count;
+
+                    if (read < length)
+                    {
+                        // End of the file
+                        break;
+                    }
+                }
+
+                return done;
+            }
+
+            /** @brief Fill work buffer with sectors starting at the sector containing specified byte
+             * @param offset Offset from start of the file
+             * @return Number of bytes in the work buffer (if lower than 0, error was encountered)
+             */
+            int32_t FillWorkBuffer(int32_t offset)
+            {
+                const int32_t workBufferSize = this->Size.SectorSize * File::SectorsToReadAtOnce;
+                const int32_t sector = offset / this->Size.SectorSize;
+
+                if (this->workBuffer == nullptr)
+                {
+                    this->workBuffer = autonew uint8_t[workBufferSize];
+                }
+
+                this->workBufferLength = 0;
+                const int32_t result = this->ReadCached(sector, workBufferSize, this->workBuffer);
+
+                if (result < 0)
+                {
+                    return result;
+                }
+
+                this->workBufferStart = sector * this->Size.SectorSize;
+                this->workBufferLength = result;
+                return result;
+            }
+
+        public:
+            /** @brief File handle
+             */
+            GfsHn Handle;
+
+            /** @brief Size of the file
+             */
+            FileSize Size;
+
+            /** @brief disable default constructor
+             */
+            File() = delete;
+
+            /** @brief disable copying, Cd::HandlePool and read requests keep address of the file
+             */
+            File(const File&) = delete;
+            File& operator=(const File&) = delete;
+
+            /** @brief Construct a new File object from Gfs handle and identifier
+             * @param handle Gfs handle
+             * @param fid File identifier
+             * @param getSize Fetch file size (will cause file to be open for a bit)
+             */
+            File(GfsHn handle, int32_t fid, bool getSize = true) : Handle(handle),
+                                                                   Size(getSize ? FileSize(handle) : FileSize()),
+                                                                   identifier(fid),
+                                                                   discAddress(File::GetDiscAddress(fid)),
+                                                                   directory(-1),
+                                                                   workBuffer(nullptr),
+                                                                   workBufferStart(0),
+                                                                   workBufferLength(0),
+                                                                   readBytes(0),
+                                                                   opened(handle != nullptr),
+                                                                   pinned(false)
+            {
+                #if defined(SRL_MAX_CD_FILES) && (SRL_MAX_CD_FILES < 1)
+                    static_assert(false, "SRL_MAX_CD_FILES is not set properly to instantiate this class");
+                #endif
+            }
+
+            /** @brief Open a file on CD
+             * @details When Cd::PathIndex is built, name can be a path (e.g. "DIR/FILE.BIN") and file is found without reading from the disc.
+             * @param name File name or path relative to current directory
+             */
+            File(const char *name) : Handle(nullptr),
+                                     Size(0),
+                                     identifier(-1),
+                                     discAddress(-1),
+                                     directory(-1),
+                                     workBuffer(nullptr),
+                                     workBufferStart(0),
+                                     workBufferLength(0),
+                                     readBytes(0),
+                                     opened(false),
+                                     pinned(false)
+            {
+                #if defined(SRL_MAX_CD_FILES) && (SRL_MAX_CD_FILES < 1)
+                    static_assert(false, "SRL_MAX_CD_FILES is not set properly to instantiate this class");
+                #endif
+
+                int16_t fid;
+
+                if (PathIndex::Find(PathIndex::current, name, this->directory, fid))
+                {
+                    const GfsDirName& record = PathIndex::GetRecord(this->directory, fid);
+                    this->identifier = fid;
+                    this->discAddress = GFS_DIR_FAD(&record);
+
+                    if ((GFS_DIR_ATR(&record) & (GFS_ATR_FORM2 | GFS_ATR_INTLV)) == 0)
+                    {
+                        this->Size = FileSize(GFS_DIR_SIZE(&record), SectorCache::SectorSize);
+                    }
+                    else if (HandlePool::Acquire(*this))
+                    {
+                        // Sector size depends on the sector form, handle stays in the pool for later reads
+                        this->Size = FileSize(this->Handle);
+                    }
+                }
+                else if (name != nullptr && !PathIndex::IsEnabled())
+                {
+                    int32_t sectorSize;
+                    int32_t sectorCount;
+                    int32_t lastSectorSize;
+                    int32_t id = GFS_NameToId((int8_t *)name);
+
+                    if (id >= 0)
+                    {
+                        this->identifier = id;
+                        this->discAddress = File::GetDiscAddress(id);
+
+                        if (HandlePool::Acquire(*this))
+                        {
+                            // Handle stays in the pool for later reads
+                            this->Size = FileSize(this->Handle);
+                        }
+                        else
+                        {
+                            this->identifier = -1;
+                            this->discAddress = -1;
+                        }
+                    }
+                }
+            }
+
+            /** @brief Close file
+             */
+            ~File()
+            {
+                this->Close();
+            }
+
+            /**
+             * @name File handling and status
+             * @{
+             */
+
+            /** @brief Close file
+             */
+            void Close()
+            {
+                // Requests can be queued while file has no handle (not opened yet or evicted from the pool)
+                Cd::CancelRequests(this);
+
+                if (this->Handle != nullptr)
+                {
+                    HandlePool::Release(*this);
+                }
+
+                this->opened = false;
+
+                if (this->workBuffer != nullptr)
+                {
+                    delete[] this->workBuffer;
+                    this->workBuffer = nullptr;
+                }
+
+                this->workBufferLength = 0;
+            }
+
+            /** @brief Open file
+             * @return True on success
+             */
+            bool Open()
+            {
+                if (this->IsOpen())
+                {
+                    // Handle could have been given to other file in the meantime
+                    return HandlePool::Acquire(*this);
+                }
+                else if (HandlePool::Acquire(*this))
+                {
+                    this->opened = true;
+                    this->readBytes = 0;
+                    Cd::Trace(TraceOperation::Open, *this, this->readBytes, this->Size.Bytes);
+                }
+
+                return this->opened;
+            }
+
+            /** @brief File exists
+             * @return True if exists
+             */
+            constexpr bool Exists()
+            {
+                return this->identifier >= 0;
+            }
+
+            /** @brief Gets the current position in the file
+             * @return Position in the file as bytes
+             */
+            constexpr size_t GetCurrentPosition()
+            {
+                return this->readBytes;
+            }
+
+            /** @brief File is open
+             * @note Open file keeps its access position even when its handle was closed by Cd::HandlePool
+             * @return True if file is open
+             */
+            constexpr bool IsOpen()
+            {
+                return this->Exists() && this->opened;
+            }
+
+            /** @brief EOF has been reached
+             * @return true if file access pointer is at the end of the file, false otherwise
+             */
+            constexpr bool IsEOF()
+            {
+                return this->IsOpen() && this->readBytes >= this->Size.Bytes;
+            }
+
+            /**
+             * @}
+             */
+
+            /**
+             * @name File reading
+             * @{
+             */
+
+            /** @brief Loads specified amount of bytes from a file
+             * @details Sectors present in Cd::SectorCache are copied from it instead of being read from the disc.
+             * Handle used for reading stays in Cd::HandlePool, so loading from the same file again does not open it again.
+             * @note This function does not need file to be open and does not move file access pointer
+             * @param sectorOffset Number of sectors to skip at the start
+             * @param size Number of bytes to read (length of the batch)
+             * @param destination Buffer to read batch into
+             * @return Number of bytes read (if lower than 0, error was encountered)
+             */
+            int32_t LoadBytes(size_t sectorOffset, int32_t size, void *destination)
+            {
+                int32_t result = 0;
+
+                if (this->identifier >= 0)
+                {
+                    Cd::Trace(TraceOperation::Load, *this, sectorOffset * this->Size.SectorSize, size);
+                    result = this->ReadCached(sectorOffset, size, reinterpret_cast<uint8_t*>(destination));
+                }
+
+                return result;
+            }
+
+            /** @brief Read specified number of bytes from the file and advances file access pointer
+             * @details Bytes already in the work buffer are copied from it. Whole sectors starting at a sector boundary
+             * are read from disk straight into the destination when it is 4 byte aligned, only the unaligned head and tail
+             * of the read go through the work buffer. Sectors present in Cd::SectorCache are copied from it instead of being read from the disc.
+             * @param size Number of bytes to read
+             * @param destination Buffer to read bytes into
+             * @return Number of bytes read (if lower than 0, error was encountered)
+             */
+            int32_t Read(int32_t size, void *destination)
+            {
+                if (this->IsOpen() && size > 0 && this->Size.Bytes > 0)
+                {
+                    uint8_t* target = reinterpret_cast<uint8_t*>(destination);
+                    int32_t currentlyRead = 0;
+                    size = SRL::Math::Min<int32_t>(size, this->Size.Bytes - this->readBytes);
+                    Cd::Trace(TraceOperation::Read, *this, this->readBytes, size);
+
+                    while (currentlyRead < size)
+                    {
+                        int32_t toRead = size - currentlyRead;
+
+                        if (this->IsInWorkBuffer(this->readBytes))
+                        {
+                            // Copy what we already have
+                            toRead = SRL::Math::Min<int32_t>(toRead, this->workBufferStart + this->workBufferLength - this->readBytes);
+                            Memory::Copy(target + currentlyRead, this->workBuffer + (this->readBytes - this->workBufferStart), toRead);
+                        }
+                        else if (toRead >= this->Size.SectorSize &&
+                            this->readBytes % this->Size.SectorSize == 0 &&
+                            (reinterpret_cast<uintptr_t>(target + currentlyRead) & 3) == 0)
+                        {
+                            // Read whole sectors directly into the destination
+                            const int32_t sectors = toRead / this->Size.SectorSize;
+                            toRead = this->ReadCached(this->readBytes / this->Size.SectorSize, sectors * this->Size.SectorSize, target + currentlyRead);
+
+                            if (toRead <= 0)
+                            {
+                                return toRead < 0 ? -1 : currentlyRead;
+                            }
+                        }
+                        else
+                        {
+                            // Head or tail of the read is not a whole sector, read it through work buffer
+                            if (this->FillWorkBuffer(this->readBytes) < 0)
+                            {
+                                return -1;
+                            }
+                            else if (!this->IsInWorkBuffer(this->readBytes))
+                            {
+                                // Nothing more to read
+                                return currentlyRead;
+                            }
+
+                            continue;
+                        }
+
+                        // Set state
+                        this->readBytes += toRead;
+                        currentlyRead += toRead;
+                    }
+
+                    return currentlyRead;
+                }
+
+                return -1;
+            }
+
+            /** @brief Read specified number of sectors from the file and advances file access pointer
+             * @details Reading starts at the sector containing the file access pointer.
+             * Sectors present in Cd::SectorCache are copied from it instead of being read from the disc.
+             * @param sectorCount Number of sectors to be read from file
+             * @param destination Buffer to read bytes into (must hold whole sectors)
+             * @return Number of bytes read (if lower than 0, error was encountered)
+             */
+            int32_t ReadSectors(const int32_t sectorCount, void* destination)
+            {
+                if (this->IsOpen() && sectorCount > 0 && this->Size.SectorSize > 0)
+                {
+                    // Number of the current sector offset
+                    const auto currentSector = this->readBytes / this->Size.SectorSize;
+                    const auto toRead = SRL::Math::Min<int32_t>(sectorCount, this->Size.Sectors - currentSector);
+                    
+                    if (toRead > 0)
+                    {
+                        Cd::Trace(TraceOperation::Read, *this, currentSector * this->Size.SectorSize, toRead * this->Size.SectorSize);
+                        const auto read = this->ReadCached(currentSector, this->Size.SectorSize * toRead, reinterpret_cast<uint8_t*>(destination));
+
+                        // Advance read pointer
+                        if (read >= 0)
+                        {
+                            this->readBytes = (currentSector * this->Size.SectorSize) + read;
+                        }
+
+                        return read;
+                    }
+                }
+
+                return 0;
+            }
+
+            /** @brief Start reading specified number of sectors from the file in the background
+             * @details Reading starts at the current sector, file access pointer is advanced when the request completes
+             * @note File must not be read by other means until the request is done, closing the file cancels the request
+             * @param request Request object to track the read with
+             * @param sectorCount Number of sectors to be read from file
+             * @param destination Buffer to read sectors into (must hold whole sectors and be 4 byte aligned)
+             * @return true if request was queued, false also when destination is not 4 byte aligned
+             */
+            bool ReadSectorsAsync(Cd::ReadRequest& request, const int32_t sectorCount, void* destination)
+            {
+                if (!this->IsOpen() || sectorCount <= 0 || this->Size.SectorSize <= 0)
+                {
+                    return false;
+                }
+
+                return Cd::QueueRequest(request, this, -1, sectorCount, this->Size.SectorSize * sectorCount, destination);
+            }
+
+            /** @brief Start loading specified amount of bytes from a file in the background
+             * @note File is opened if it is not open yet and stays open afterwards
+             * @param request Request object to track the read with
+             * @param sectorOffset Number of sectors to skip at the start
+             * @param size Number of bytes to read
+             * @param destination Buffer to read bytes into (must be 4 byte aligned)
+             * @return true if request was queued, false also when destination is not 4 byte aligned
+             */
+            bool LoadBytesAsync(Cd::ReadRequest& request, size_t sectorOffset, int32_t size, void* destination)
+            {
+                if (!this->Exists() || size <= 0 || this->Size.SectorSize <= 0)
+                {
+                    return false;
+                }
+
+                int32_t sectorCount = (size + this->Size.SectorSize - 1) / this->Size.SectorSize;
+                return Cd::QueueRequest(request, this, sectorOffset, sectorCount, size, destination);
+            }
+
+            /** @brief Seek file access pointer to specific byte
+             * @details Disk is not read when the new position is inside the work buffer
+             * @param offset offset from start of the file
+             * @return New position of the access pointer otherwise negative on error
+             */
+            int32_t Seek(int32_t offset)
+            {
+                if (this->IsOpen() && offset >= 0 && offset < this->Size.Bytes)
+                {
+                    Cd::Trace(TraceOperation::Seek, *this, offset, 0);
+
+                    if (!this->IsInWorkBuffer(offset) && this->FillWorkBuffer(offset) < 0)
+                    {
+                        return -1;
+                    }
+
+                    this->readBytes = offset;
+                    return offset;
+                }
+
+                return this->IsOpen() ? ErrorCode::ErrorSeek : -1;
+            }
+
+            /**
+             * @}
+             */
+
+            /**
+             * @name Other
+             * @{
+             */
+
+            /** @brief
+             * @return Current state of file access pointer
+             */
+            int32_t GetCurrentAccessPointer()
+            {
+                return this->IsOpen() ? this->readBytes : -1;
+            }
+
+            /** @brief Get file identifier
+             * @note With Cd::PathIndex the identifier is valid only in directory of the file, use WithIdentifier() to pass it to GFS
+             * @return File identifier
+             */
+            constexpr int32_t GetIdentifier()
+            {
+                return this->identifier;
+            }
+
+            /** @brief Call function taking file identifier while GFS uses directory table of the file
+             * @details Needed when the identifier is given to other library (e.g. SRL::Stream passes it to STM)
+             * @param function Function called with the file identifier
+             * @return Value returned by the function
+             */
+            template<typename Function>
+            auto WithIdentifier(Function function)
+            {
+                PathIndex::Select(this->directory);
+                auto result = function(this->identifier);
+                PathIndex::Select(PathIndex::current);
+                return result;
+            }
+
+            /** @brief Get number sectors take by specified byte count for this file
+             * @param bytes Number of bytes
+             * @return Number of sectors, -1 on error
+             */
+            int32_t GetSectorCount(size_t bytes)
+            {
+                if (this->IsOpen() && HandlePool::Acquire(*this))
+                {
+                    return GFS_ByteToSct(this->Handle, bytes);
+                }
+
+                return -1;
+            }
+
+            /**
+             * @}
+             */
+        };
+
+        /** @brief Sequential file reader keeping several buffers loading in the background
+         * @details File is split into chunks of the buffer size. All buffers are queued as read requests,
+         * so while the caller consumes chunk K, chunks K+1 and further are already being read by Cd::Update().
+         * Consumed buffer is queued again right away for the next chunk of the file.<br/>
+         * When the caller gets to a chunk that did not arrive yet, reader waits for it and counts it as drive starvation
+         * in the statistics. Many stalls mean buffers are too small or too few for the rate data are consumed at.
+         * @note File must not be read by other means while the stream is active
+         * @code {.cpp}
+         * SRL::Cd::File file("LEVEL1.BIN");
+         *
+         * // 3 buffers of 8 sectors each in low work RAM
+         * SRL::Cd::StreamReader stream(file, 8, 3, SRL::Memory::Zone::LWRam);
+         *
+         * LevelChunkHeader header;
+         *
+         * while (stream.Read(sizeof(LevelChunkHeader), &header) == sizeof(LevelChunkHeader))
+         * {
+         *     // Use data in place, without copying
+         *     int32_t size;
+         *     const void* data = stream.GetChunk(size);
+         *     ...
+         * }
+         * @endcode
+         */
+        class StreamReader
+        {
+        public:
+            /** @brief Stream statistics
+             */
+            struct Statistics
+            {
+                /** @brief Number of bytes consumed
+                 */
+                uint32_t BytesRead;
+
+                /** @brief Number of chunks consumed
+                 */
+                uint32_t ChunksRead;
+
+                /** @brief Number of times a chunk was not loaded yet when it was needed
+                 */
+                uint32_t Stalls;
+
+                /** @brief Number of Cd::Update() calls made while waiting for the drive
+                 */
+                uint32_t StallUpdates;
+            };
+
+        private:
+            /** @brief File to read from
+             */
+            File* file;
+
+            /** @brief Storage of all buffers
+             */
+            uint8_t* buffers;
+
+            /** @brief Read request for each buffer
+             */
+            ReadRequest* requests;
+
+            /** @brief Number of sectors in one buffer
+             */
+            int32_t bufferSectors;
+
+            /** @brief Number of buffers
+             */
+            uint8_t bufferCount;
+
+            /** @brief Number of buffers that are loading or hold data that were not consumed yet
+             */
+            uint8_t pending;
+
+            /** @brief Buffer being consumed
+             */
+            uint8_t current;
+
+            /** @brief Number of bytes consumed from current buffer
+             */
+            int32_t consumed;
+
+            /** @brief Byte offset in the file of the chunk in current buffer
+             */
+            int32_t chunkStart;
+
+            /** @brief Next sector to queue
+             */
+            int32_t nextSector;
+
+            /** @brief Stream statistics
+             */
+            Statistics statistics;
+
+            /** @brief Gets size of one buffer in bytes
+             * @return Buffer size
+             */
+            int32_t GetBufferSize() const
+            {
+                return this->bufferSectors * this->file->Size.SectorSize;
+            }
+
+            /** @brief Queue read of the next chunk of the file into a buffer
+             * @param index Buffer index
+             */
+            void QueueBuffer(uint8_t index)
+            {
+                if (this->nextSector < this->file->Size.Sectors)
+                {
+                    int32_t sectors = SRL::Math::Min<int32_t>(this->bufferSectors, this->file->Size.Sectors - this->nextSector);
+
+                    if (this->file->LoadBytesAsync(
+                        this->requests[index],
+                        this->nextSector,
+                        sectors * this->file->Size.SectorSize,
+                        this->buffers + (index * this->GetBufferSize())))
+                    {
+                        this->nextSector += sectors;
+                        this->pending++;
+                    }
+                }
+            }
+
+            /** @brief Queue current buffer again and move to the next one
+             */
+            void NextBuffer()
+            {
+                this->pending--;
+                this->statistics.ChunksRead++;
+                this->QueueBuffer(this->current);
+                this->current = (this->current + 1) % this->bufferCount;
+                this->chunkStart += this->GetBufferSize();
+                this->consumed = 0;
+            }
+
+        public:
+            /** @brief Construct stream reader and start reading from the start of the file
+             * @param file File to read from
+             * @param bufferSectors Number of sectors in one buffer
+             * @param bufferCount Number of buffers
+             * @param zone Memory zone to allocate buffers in
+             */
+            StreamReader(File& file, const int32_t bufferSectors = 8, const uint8_t bufferCount = 2, const Memory::Zone zone = Memory::Zone::LWRam) :
+                file(&file),
+                buffers(nullptr),
+                requests(nullptr),
+                bufferSectors(bufferSectors > 0 ? bufferSectors : 1),
+                bufferCount(bufferCount > 0 ? bufferCount : 1),
+                pending(0),
+                current(0),
+                consumed(0),
+                chunkStart(0),
+                nextSector(0),
+                statistics()
+            {
+                if (file.Exists() && file.Size.SectorSize > 0)
+                {
+                    this->buffers = new (zone) uint8_t[this->GetBufferSize() * this->bufferCount];
+                    this->requests = new ReadRequest[this->bufferCount];
+                    this->Restart();
+                }
+            }
+
+            /** @brief Stop reading and free buffers
+             */
+            ~StreamReader()
+            {
+                // Requests must be cancelled before their buffers are gone
+                delete[] this->requests;
+                delete[] this->buffers;
+            }
+
+            StreamReader(const StreamReader&) = delete;
+            StreamReader& operator=(const StreamReader&) = delete;
+
+            /** @brief Cancel reads in progress and start streaming from specified sector
+             * @param sectorOffset Sector to start at
+             * @return true if reading was started
+             */
+            bool Restart(const int32_t sectorOffset = 0)
+            {
+                if (this->buffers == nullptr || this->requests == nullptr)
+                {
+                    return false;
+                }
+
+                for (uint8_t index = 0; index < this->bufferCount; index++)
+                {
+                    this->requests[index].Cancel();
+                }
+
+                this->pending = 0;
+                this->current = 0;
+                this->consumed = 0;
+                this->nextSector = sectorOffset;
+                this->chunkStart = sectorOffset * this->file->Size.SectorSize;
+
+                for (uint8_t index = 0; index < this->bufferCount; index++)
+                {
+                    this->QueueBuffer(index);
+                }
+
+                return this->pending > 0;
+            }
+
+            /** @brief Gets data of current chunk that were not consumed yet, waits for the chunk if it is not loaded yet
+             * @details Data stay valid until they are consumed by Skip() or Read()
+             * @param size Number of bytes available at returned address, 0 at the end of the file, negative Cd::ErrorCode on error
+             * @return Pointer to the data or nullptr
+             */
+            const void* GetChunk(int32_t& size)
+            {
+                while (this->pending > 0)
+                {
+                    ReadRequest& request = this->requests[this->current];
+
+                    if (!request.IsDone())
+                    {
+                        this->statistics.Stalls++;
+
+                        while (!request.IsDone())
+                        {
+                            Cd::Update();
+                            this->statistics.StallUpdates++;
+                        }
+                    }
+
+                    if (request.GetStatus() == ReadRequest::Status::Failed)
+                    {
+                        size = request.GetResult();
+                        return nullptr;
+                    }
+
+                    // Last sector of the file is not full
+                    size = SRL::Math::Min<int32_t>(request.GetResult(), this->file->Size.Bytes - this->chunkStart) - this->consumed;
+
+                    if (size > 0)
+                    {
+                        return this->buffers + (this->current * this->GetBufferSize()) + this->consumed;
+                    }
+
+                    this->NextBuffer();
+                }
+
+                size = 0;
+                return nullptr;
+            }
+
+            /** @brief Consume bytes without copying them
+             * @param size Number of bytes to skip
+             * @return Number of bytes skipped (if lower than 0, error was encountered)
+             */
+            int32_t Skip(int32_t size)
+            {
+                int32_t skipped = 0;
+
+                while (skipped < size)
+                {
+                    int32_t available;
+
+                    if (this->GetChunk(available) == nullptr)
+                    {
+                        return available < 0 && skipped == 0 ? available : skipped;
+                    }
+
+                    available = SRL::Math::Min<int32_t>(available, size - skipped);
+                    this->consumed += available;
+                    this->statistics.BytesRead += available;
+                    skipped += available;
+                }
+
+                return skipped;
+            }
+
+            /** @brief Read specified number of bytes from the stream
+             * @param size Number of bytes to read
+             * @param destination Buffer to read bytes into
+             * @return Number of bytes read (if lower than 0, error was encountered)
+             */
+            int32_t Read(int32_t size, void* destination)
+            {
+                uint8_t* target = reinterpret_cast<uint8_t*>(destination);
+                int32_t read = 0;
+
+                while (read < size)
+                {
+                    int32_t available;
+                    const void* data = this->GetChunk(available);
+
+                    if (data == nullptr)
+                    {
+                        return available < 0 && read == 0 ? available : read;
+                    }
+
+                    available = SRL::Math::Min<int32_t>(available, size - read);
+                    Memory::Copy(target + read, data, available);
+                    this->consumed += available;
+                    this->statistics.BytesRead += available;
+                    read += available;
+                }
+
+                return read;
+            }
+
+            /** @brief Gets number of bytes that can be consumed without waiting for the drive
+             * @return Number of bytes
+             */
+            int32_t GetAvailable() const
+            {
+                int32_t available = 0;
+                int32_t start = this->chunkStart;
+
+                for (uint8_t index = 0; index < this->pending; index++)
+                {
+                    const ReadRequest& request = this->requests[(this->current + index) % this->bufferCount];
+
+                    if (request.GetStatus() != ReadRequest::Status::Completed)
+                    {
+                        break;
+                    }
+
+                    available += SRL::Math::Min<int32_t>(request.GetResult(), this->file->Size.Bytes - start);
+                    start += this->GetBufferSize();
+                }
+
+                return available - this->consumed;
+            }
+
+            /** @brief Gets position of the stream in the file
+             * @return Byte offset from the start of the file
+             */
+            int32_t GetPosition() const
+            {
+                return SRL::Math::Min<int32_t>(this->chunkStart + this->consumed, this->file->Size.Bytes);
+            }
+
+            /** @brief Check whether whole file was consumed
+             * @return true if there are no more data
+             */
+            bool IsEOF() const
+            {
+                return this->pending == 0 || this->GetPosition() >= this->file->Size.Bytes;
+            }
+
+            /** @brief Gets stream statistics
+             * @return Statistics
+             */
+            const Statistics& GetStatistics() const
+            {
+                return this->statistics;
+            }
+
+            /** @brief Reset stream statistics
+             */
+            void ResetStatistics()
+            {
+                this->statistics = Statistics();
+            }
+        };
+
+        /** @brief Pack file made of many assets
+         * @details Pack is built by tools/scripts/srl_packer.py from every directory in @c cd/packs of the project.
+         * Pack starts with a hashed table of contents, that is loaded into memory when the pack is opened.
+         * Every entry starts at a sector boundary, so loading an entry is a single seek and contiguous read,
+         * without any directory lookup. Entries do not count against @c SRL_MAX_CD_FILES.
+         * @code {.cpp}
+         * // Built from cd/packs/level1
+         * SRL::Cd::Pack pack("LEVEL1.PAK");
+         *
+         * // Hash can be computed at compile time
+         * constexpr uint32_t mapHash = SRL::Cd::Pack::Hash("maps/level1.map");
+         * const SRL::Cd::Pack::Entry* entry = pack.Find(mapHash);
+         *
+         * if (entry != nullptr)
+         * {
+         *     void* map = new uint8_t[entry->Size];
+         *     pack.Load(*entry, map);
+         * }
+         * @endcode
+         */
+        class Pack
+        {
+        public:
+            /** @brief Table of contents entry
+             */
+            struct Entry
+            {
+                /** @brief Hash of the path, see Pack::Hash()
+                 */
+                uint32_t PathHash;
+
+                /** @brief First sector of the entry within pack file (0 for an empty slot)
+                 */
+                uint32_t Sector;
+
+                /** @brief Size of the entry in bytes
+                 */
+                uint32_t Size;
+            };
+
+        private:
+            /** @brief Pack file header
+             */
+            struct Header
+            {
+                /** @brief Magic identifier ("SRLP")
+                 */
+                char Magic[4];
+
+                /** @brief Format version
+                 */
+                uint16_t Version;
+
+                /** @brief Unused
+                 */
+                uint16_t Reserved;
+
+                /** @brief Number of slots in the table of contents (power of two)
+                 */
+                uint32_t SlotCount;
+
+                /** @brief Number of entries in the pack
+                 */
+                uint32_t EntryCount;
+
+                /** @brief Number of sectors taken by header and table of contents
+                 */
+                uint32_t TocSectors;
+            };
+
+            /** @brief Supported format version
+             */
+            inline static const uint16_t Version = 1;
+
+            /** @brief Pack file
+             */
+            File file;
+
+            /** @brief Header followed by table of contents
+             */
+            uint8_t* toc;
+
+            /** @brief Gets pack header
+             * @return Pack header
+             */
+            const Header* GetHeader() const
+            {
+                return reinterpret_cast<const Header*>(this->toc);
+            }
+
+            /** @brief Gets table of contents slots
+             * @return First slot
+             */
+            const Entry* GetSlots() const
+            {
+                return reinterpret_cast<const Entry*>(this->toc + sizeof(Header));
+            }
+
+        public:
+            /** @brief Compute hash of a path inside a pack
+             * @details FNV-1a of the path, case insensitive, both '/' and '\\' work as separator
+             * @param path Path relative to the packed directory
+             * @param hash Hash of the preceding part of the path to continue from
+             * @return Path hash
+             */
+            static constexpr uint32_t Hash(const char* path, uint32_t hash = 2166136261u)
+            {
+                for (; *path != '\0'; path++)
+                {
+                    char character = *path == '\\' ? '/' : *path;
+                    character = character >= 'a' && character <= 'z' ? character - ('a' - 'A') : character;
+                    hash = (hash ^ static_cast<uint8_t>(character)) * 16777619u;
+                }
+
+                return hash;
+            }
+
+            /** @brief Open pack and load its table of contents
+             * @param name Pack file name
+             * @param zone Memory zone to keep table of contents in
+             */
+            Pack(const char* name, const Memory::Zone zone = Memory::Zone::HWRam) : file(name), toc(nullptr)
+            {
+                if (!this->file.Exists() || this->file.Size.SectorSize <= 0)
+                {
+                    return;
+                }
+
+                // Header is in the first sector, GFS reads whole sectors
+                this->toc = new (zone) uint8_t[this->file.Size.SectorSize];
+
+                if (this->toc == nullptr || this->file.LoadBytes(0, this->file.Size.SectorSize, this->toc) < static_cast<int32_t>(sizeof(Header)))
+                {
+                    this->Close();
+                    return;
+                }
+
+                const Header* header = this->GetHeader();
+
+                if (header->Magic[0] != 'S' || header->Magic[1] != 'R' || header->Magic[2] != 'L' || header->Magic[3] != 'P' ||
+                    header->Version != Pack::Version ||
+                    header->SlotCount == 0 ||
+                    (header->SlotCount & (header->SlotCount - 1)) != 0)
+                {
+                    this->Close();
+                    return;
+                }
+
+                if (header->TocSectors > 1)
+                {
+                    // Table of contents does not fit into one sector
+                    int32_t size = header->TocSectors * this->file.Size.SectorSize;
+                    delete[] this->toc;
+                    this->toc = new (zone) uint8_t[size];
+
+                    if (this->toc == nullptr || this->file.LoadBytes(0, size, this->toc) < size)
+                    {
+                        this->Close();
+                    }
+                }
+            }
+
+            /** @brief Free table of contents
+             */
+            ~Pack()
+            {
+                this->Close();
+            }
+
+            Pack(const Pack&) = delete;
+            Pack& operator=(const Pack&) = delete;
+
+            /** @brief Free table of contents and close pack file
              */
-            bool Open()
+            void Close()
             {
-                if (this->IsOpen())
+                if (this->toc != nullptr)
                 {
-                    return true;
-                }
-                else if (this->identifier >= 0)
-                {
-                    this->readBytes = 0;
-                    this->Handle = GFS_Open(this->identifier);
+                    delete[] this->toc;
+                    this->toc = nullptr;
                 }
 
-                return this->Handle != nullptr;
+                this->file.Close();
             }
 
-            /** @brief File exists
-             * @return True if exists
+            /** @brief Check whether pack was opened
+             * @return true if table of contents is loaded
              */
-            constexpr bool Exists()
+            bool IsValid() const
             {
-                return this->identifier >= 0;
+                return this->toc != nullptr;
             }
 
-            /** @brief Gets the current position in the file
-             * @return Position in the file as bytes
+            /** @brief Gets number of entries in the pack
+             * @return Number of entries
              */
-            constexpr size_t GetCurrentPosition()
+            uint32_t GetCount() const
             {
-                return this->readBytes;
+                return this->IsValid() ? this->GetHeader()->EntryCount : 0;
             }
 
-            /** @brief File is open
-             * @return True if file is open
+            /** @brief Gets pack file
+             * @return Pack file
              */
-            constexpr bool IsOpen()
+            File& GetFile()
             {
-                return this->Exists() && this->Handle != nullptr;
+                return this->file;
             }
 
-            /** @brief EOF has been reached
-             * @return true if EOF, false otherwise
+            /** @brief Find entry by path hash
+             * @param hash Path hash
+             * @return Entry or nullptr if pack does not contain it
              */
-            constexpr bool IsEOF()
+            const Entry* Find(const uint32_t hash) const
             {
-                return (GFS_IsEof(Handle) == TRUE);
+                if (!this->IsValid())
+                {
+                    return nullptr;
+                }
+
+                const uint32_t mask = this->GetHeader()->SlotCount - 1;
+                const Entry* slots = this->GetSlots();
+
+                for (uint32_t index = hash & mask; slots[index].Sector != 0; index = (index + 1) & mask)
+                {
+                    if (slots[index].PathHash == hash)
+                    {
+                        return &slots[index];
+                    }
+                }
+
+                return nullptr;
             }
 
-            /**
-             * @}
+            /** @brief Find entry by path
+             * @param path Path relative to the packed directory
+             * @return Entry or nullptr if pack does not contain it
              */
+            const Entry* Find(const char* path) const
+            {
+                return this->Find(Pack::Hash(path));
+            }
 
-            /**
-             * @name File reading
-             * @{
+            /** @brief Load whole entry
+             * @param entry Pack entry
+             * @param destination Buffer to load entry into
+             * @return Number of bytes read (if lower than 0, error was encountered)
              */
+            int32_t Load(const Entry& entry, void* destination)
+            {
+                return this->file.LoadBytes(entry.Sector, entry.Size, destination);
+            }
 
-            /** @brief Loads specified amount of bytes from a file
-             * @note This function does not need file to be open
-             * @param sectorOffset Number of sectors to skip at the start
-             * @param size Number of bytes to read (length of the batch)
-             * @param destination Buffer to read batch into
+            /** @brief Load whole entry
+             * @param path Path relative to the packed directory
+             * @param destination Buffer to load entry into
              * @return Number of bytes read (if lower than 0, error was encountered)
              */
-            int32_t LoadBytes(size_t sectorOffset, int32_t size, void *destination)
+            int32_t Load(const char* path, void* destination)
             {
-                bool wasOpen = false;
-                int32_t result = 0;
+                const Entry* entry = this->Find(path);
+                return entry != nullptr ? this->Load(*entry, destination) : ErrorCode::ErrorNExit;
+            }
 
-                if (this->identifier >= 0)
-                {
-                    if (this->IsOpen())
-                    {
-                        this->Close();
-                        wasOpen = true;
-                    }
+            /** @brief Start loading whole entry in the background
+             * @param request Request object to track the read with
+             * @param entry Pack entry
+             * @param destination Buffer to load entry into (must be 4 byte aligned)
+             * @return true if request was queued
+             */
+            bool LoadAsync(ReadRequest& request, const Entry& entry, void* destination)
+            {
+                return this->file.LoadBytesAsync(request, entry.Sector, entry.Size, destination);
+            }
+        };
 
-                    // This function reads whole file, file does not need to be opened
-                    result = GFS_Load(this->identifier, sectorOffset, destination, size);
+    private:
+        /** @brief Function receiving traced file accesses
+         */
+        inline static TraceHandler traceHandler = nullptr;
 
-                    // Open again
-                    if (wasOpen)
-                    {
-                        this->Open();
-                    }
+        /** @brief Number of frames since start
+         */
+        inline static uint32_t frameCount = 0;
+
+        /** @brief Report file access to trace handler
+         * @param operation Access type
+         * @param identifier File identifier
+         * @param offset Byte offset from the start of the file
+         * @param size Number of bytes requested
+         * @param name Name to report (nullptr to look it up by identifier)
+         */
+        inline static void Trace(const TraceOperation operation, const int32_t identifier, const int32_t offset, const int32_t size, const char* name = nullptr)
+        {
+            if (Cd::traceHandler != nullptr)
+            {
+                if (name == nullptr && operation != TraceOperation::ChangeDir && identifier >= 0)
+                {
+                    name = reinterpret_cast<const char*>(GFS_IdToName(identifier));
                 }
 
-                return result;
+                Cd::traceHandler(TraceEvent { operation, Cd::frameCount, identifier, name, offset, size });
             }
+        }
 
-            /** @brief Read specified number of bytes from the file and advances file access pointer
-             * @param size Number of bytes to read
-             * @param destination Buffer to read bytes into
-             * @return Number of bytes read (if lower than 0, error was encountered)
-             */
-            int32_t Read(int32_t size, void *destination)
+        /** @brief Report file access to trace handler, files found through Cd::PathIndex are reported with full path
+         * @param operation Access type
+         * @param file Accessed file
+         * @param offset Byte offset from the start of the file
+         * @param size Number of bytes requested
+         */
+        inline static void Trace(const TraceOperation operation, const File& file, const int32_t offset, const int32_t size)
+        {
+            if (Cd::traceHandler != nullptr)
             {
-                int32_t workBufferSize = this->Size.SectorSize * File::SectorsToReadAtOnce;
+                char path[128];
 
-                if (this->IsOpen() && size > 0 && this->Size.Bytes > 0)
+                if (file.directory >= 0)
                 {
-                    int32_t currentlyRead = 0;
+                    PathIndex::GetPath(file.directory, file.identifier, path, 0, sizeof(path));
+                }
 
-                    // We have not read any data yet
-                    if (this->workBuffer == nullptr)
-                    {
-                        this->workBuffer = autonew uint8_t[workBufferSize];
+                Cd::Trace(operation, file.identifier, offset, size, file.directory >= 0 ? path : nullptr);
+            }
+        }
 
-                        // Refresh data for new sector
-                        int32_t error = GFS_Fread(this->Handle, File::SectorsToReadAtOnce, this->workBuffer, workBufferSize);
+        /** @brief First request in the read queue (the one being read)
+         */
+        inline static ReadRequest* requestHead = nullptr;
 
-                        if (error < 0)
-                        {
-                            delete[] this->workBuffer;
-                            this->workBuffer = nullptr;
-                            return -1;
-                        }
-                    }
+        /** @brief Last request in the read queue
+         */
+        inline static ReadRequest* requestTail = nullptr;
+
+        /** @brief Add request to the read queue
+         * @param request Request object
+         * @param file File to read from
+         * @param sectorOffset Sector to start at (negative to continue from current position)
+         * @param sectorCount Number of sectors to read
+         * @param size Number of bytes to read
+         * @param destination Buffer to read into (must be 4 byte aligned)
+         * @return true if request was queued
+         */
+        inline static bool QueueRequest(ReadRequest& request, File* file, int32_t sectorOffset, int32_t sectorCount, int32_t size, void* destination)
+        {
+            // CD block transfers data in 32bit words
+            if (request.status == ReadRequest::Status::Queued ||
+                request.status == ReadRequest::Status::Reading ||
+                destination == nullptr ||
+                (reinterpret_cast<uintptr_t>(destination) & 3) != 0)
+            {
+                return false;
+            }
 
-                    // Read data sector by sector
-                    while (currentlyRead < size && this->readBytes < this->Size.Bytes)
-                    {
-                        // Current location within the sector
-                        const int32_t sectorStartOffset = this->GetOffsetInWorkBuffer(this->readBytes, workBufferSize);
+            request.file = file;
+            request.destination = destination;
+            request.sectorOffset = sectorOffset;
+            request.sequential = sectorOffset < 0;
+            request.sectorCount = sectorCount;
+            request.size = size;
+            request.result = 0;
+            request.progress = 0;
+            request.status = ReadRequest::Status::Queued;
+            request.next = nullptr;
+
+            if (Cd::requestTail != nullptr)
+            {
+                Cd::requestTail->next = &request;
+            }
+            else
+            {
+                Cd::requestHead = &request;
+            }
 
-                        int32_t toRead = size - currentlyRead;
+            Cd::requestTail = &request;
+            return true;
+        }
 
-                        // We can't read more than one sector at a time
-                        if (toRead >= workBufferSize - sectorStartOffset)
-                        {
-                            // We have read whole sector
-                            toRead = workBufferSize - sectorStartOffset;
+        /** @brief Remove first request from the queue and report its result
+         * @param result Number of bytes read or error code
+         */
+        inline static void FinishRequest(int32_t result)
+        {
+            ReadRequest* request = Cd::requestHead;
+            Cd::requestHead = request->next;
 
-                            // Copy to target buffer
-                            for (int32_t byte = 0; byte < toRead; byte++)
-                            {
-                                reinterpret_cast<uint8_t*>(destination)[currentlyRead + byte] = this->workBuffer[byte + sectorStartOffset];
-                            }
+            if (Cd::requestHead == nullptr)
+            {
+                Cd::requestTail = nullptr;
+            }
 
-                            // Refresh data for new sector
-                            int32_t error = GFS_Fread(this->Handle, File::SectorsToReadAtOnce, this->workBuffer, workBufferSize);
+            request->next = nullptr;
+            request->result = result;
+            request->status = result >= 0 ? ReadRequest::Status::Completed : ReadRequest::Status::Failed;
 
-                            if (error < 0)
-                            {
-                                delete[] this->workBuffer;
-                                this->workBuffer = nullptr;
-                                return -1;
-                            }
-                        }
-                        else
-                        {
-                            // We have not reached sector bounds, we can just copy bytes over
-                            for (int32_t byte = 0; byte < toRead; byte++)
-                            {
-                                reinterpret_cast<uint8_t*>(destination)[currentlyRead + byte] = this->workBuffer[byte + sectorStartOffset];
-                            }
-                        }
+            // Request can be started again from the event
+            request->OnCompleted.Invoke(*request);
+        }
 
-                        // Set state
-                        this->readBytes += toRead;
-                        currentlyRead += toRead;
-                    }
+        /** @brief Start reading first request in the queue
+         * @return true if read was started, false if request failed to start
+         */
+        inline static bool StartRequest()
+        {
+            ReadRequest* request = Cd::requestHead;
+            File* file = request->file;
 
-                    return currentlyRead;
-                }
+            if (!file->Open())
+            {
+                Cd::FinishRequest(ErrorCode::ErrorHandle);
+                return false;
+            }
 
-                return -1;
+            int32_t error = ErrorCode::ErrorOk;
+
+            if (request->sectorOffset >= 0)
+            {
+                error = GFS_Seek(file->Handle, request->sectorOffset, Cd::SeekMode::Absolute);
+            }
+            else
+            {
+                // Continue from file access pointer, GFS access pointer does not follow reads served from sector cache
+                request->sectorOffset = file->readBytes / file->Size.SectorSize;
+                error = file->SeekSector(request->sectorOffset);
             }
 
-            /** @brief Read specified number of sectors from the file and advances file access pointer
-             * @param sectorCount Number of sectors to be read from file
-             * @param destination Buffer to read bytes into
-             * @return Number of bytes read (if lower than 0, error was encountered)
-             */
-            int32_t ReadSectors(const int32_t sectorCount, void* destination)
+            if (error >= 0)
             {
-                if (this->IsOpen() && !this->IsEOF() && sectorCount > 0)
-                {
-                    // Number of the current sector offset
-                    const auto currentSector = GFS_Tell(this->Handle);
-                    const auto toRead = SRL::Math::Min<int32_t>(sectorCount, this->Size.Sectors - currentSector);
-                    
-                    if (toRead > 0)
-                    {
-                        const auto read = GFS_Fread(this->Handle, sectorCount, destination, this->Size.SectorSize * toRead);
+                Cd::Trace(TraceOperation::Read, *file, request->sectorOffset * file->Size.SectorSize, request->size);
+                error = GFS_NwFread(file->Handle, request->sectorCount, request->destination, request->size);
+            }
 
-                        // Advance read pointer
-                        if (read >= 0)
-                        {
-                            this->readBytes = (currentSector * this->Size.SectorSize) + read;
-                        }
+            if (error < 0)
+            {
+                Cd::FinishRequest(error);
+                return false;
+            }
 
-                        return read;
-                    }
-                }
+            request->status = ReadRequest::Status::Reading;
+            return true;
+        }
 
-                return 0;
+        /** @brief Stop request and remove it from the queue
+         * @param request Request to cancel
+         */
+        inline static void CancelRequest(ReadRequest& request)
+        {
+            if (request.status != ReadRequest::Status::Queued && request.status != ReadRequest::Status::Reading)
+            {
+                return;
             }
 
-            /** @brief Seek file access pointer to specific byte
-             * @param offset offset from start of the file
-             * @return New position of the access pointer otherwise negative on error
-             */
-            int32_t Seek(int32_t offset)
+            if (request.status == ReadRequest::Status::Reading)
             {
-                int32_t result = -1;
-                int32_t workBufferSize = this->Size.SectorSize * File::SectorsToReadAtOnce;
+                GFS_NwStop(request.file->Handle);
+            }
 
-                if (this->IsOpen() && offset >= 0 && offset < this->Size.Bytes)
+            ReadRequest* previous = nullptr;
+
+            for (ReadRequest* current = Cd::requestHead; current != nullptr; previous = current, current = current->next)
+            {
+                if (current == &request)
                 {
-                    // Initialize read buffer if does not exist yet
-                    if (this->workBuffer == nullptr)
+                    if (previous != nullptr)
                     {
-                        this->workBuffer = autonew uint8_t[workBufferSize];
+                        previous->next = current->next;
                     }
-                    
-                    this->readBytes = offset;
-                    int32_t sector = this->GetSectorCount(offset);
-
-                    if (sector >= 0)
+                    else
                     {
-                        // Seek to predefined location
-                        result = GFS_Seek(this->Handle, sector, Cd::SeekMode::Absolute);
+                        Cd::requestHead = current->next;
+                    }
 
-                        // Refresh buffer
-                        if (result >= 0 && GFS_Fread(this->Handle, File::SectorsToReadAtOnce, this->workBuffer, workBufferSize) >= 0)
-                        {
-                            return offset;
-                        }
-                        else
-                        {
-                            return -1;
-                        }
+                    if (Cd::requestTail == current)
+                    {
+                        Cd::requestTail = previous;
                     }
-                }
 
-                return result;
+                    break;
+                }
             }
 
-            /**
-             * @}
-             */
+            request.next = nullptr;
+            request.result = ErrorCode::ErrorFatal;
+            request.status = ReadRequest::Status::Failed;
+        }
 
-            /**
-             * @name Other
-             * @{
-             */
+        /** @brief Cancel all requests reading from a file
+         * @param file File that is being closed
+         */
+        inline static void CancelRequests(File* file)
+        {
+            ReadRequest* request = Cd::requestHead;
 
-            /** @brief
-             * @return Current state of file access pointer
-             */
-            int32_t GetCurrentAccessPointer()
+            while (request != nullptr)
             {
-                return this->IsOpen() ? this->readBytes : -1;
-            }
+                ReadRequest* next = request->next;
 
-            /** @brief Get file identifier
-             * @return File identifier
-             */
-            constexpr int32_t GetIdentifier()
-            {
-                return this->identifier;
+                if (request->file == file)
+                {
+                    Cd::CancelRequest(*request);
+                }
+
+                request = next;
             }
+        }
 
-            /** @brief Get number sectors take by specified byte count for this file
-             * @param bytes Number of bytes
-             * @return Number of sectors, -1 on error
-             */
-            int32_t GetSectorCount(size_t bytes)
+    public:
+        /** @brief Process background read requests
+         * @details Moves data that arrived from the CD into the buffer of the current request and starts the next request when it completes.
+         * @note Called from Cd::Synchronize()
+         */
+        inline static void Update()
+        {
+            while (Cd::requestHead != nullptr)
             {
-                if (this->IsOpen())
+                ReadRequest* request = Cd::requestHead;
+
+                if (request->status == ReadRequest::Status::Queued && !Cd::StartRequest())
                 {
-                    return GFS_ByteToSct(this->Handle, bytes);
+                    // Request failed to start, try the next one
+                    continue;
                 }
 
-                return -1;
+                GfsHn handle = request->file->Handle;
+                int32_t status = GFS_NwExecOne(handle);
+
+                if (status < 0)
+                {
+                    Cd::FinishRequest(status);
+                    continue;
+                }
+
+                int32_t accessMode;
+                int32_t readBytes;
+                GFS_NwGetStat(handle, &accessMode, &readBytes);
+                request->progress = readBytes;
+
+                if (!GFS_NwIsComplete(handle))
+                {
+                    // Data are still streaming in
+                    return;
+                }
+
+                // Move file access pointer behind data that were read, loads from given offset leave it where it was
+                if (request->sequential)
+                {
+                    request->file->readBytes = (request->sectorOffset * request->file->Size.SectorSize) + readBytes;
+                }
+
+                Cd::FinishRequest(readBytes);
             }
+        }
 
-            /**
-             * @}
-             */
-        };
+        /** @brief Process background read requests and count frames for file access trace
+         * @note Called once per frame from SRL::Core::Synchronize()
+         */
+        inline static void Synchronize()
+        {
+            Cd::frameCount++;
+            Cd::Update();
+        }
+
+        /** @brief Sets function receiving every file access
+         * @details Recorded accesses are used by tools/scripts/srl_disc_order.py to order files on the disc.
+         * See SRL::Logger::LogCdTrace() for a handler writing them into the log.
+         * @param handler Trace handler (nullptr to stop tracing)
+         */
+        inline static void SetTraceHandler(TraceHandler handler)
+        {
+            Cd::traceHandler = handler;
+        }
+
+        /** @brief Check whether any background read is in progress
+         * @return true if read queue is not empty
+         */
+        inline static bool IsBusy()
+        {
+            return Cd::requestHead != nullptr;
+        }
 
         /** @brief Initialize file handling stuff
          * @return True if initialized without error
@@ -626,6 +3178,14 @@ namespace SRL
                 GFS_DIRTBL_DIRNAME(&Cd::GfsDirectories) = Cd::GfsDirectoryNames;
                 GFS_DIRTBL_NDIR(&Cd::GfsDirectories) = SRL_MAX_CD_FILES;
                 Cd::isInitialized = (GFS_Init(SRL_MAX_CD_BACKGROUND_JOBS, Cd::GfsWork, &Cd::GfsDirectories) <= 2);
+
+#if defined(SRL_CD_CACHE_SECTORS) && (SRL_CD_CACHE_SECTORS > 0)
+                Cd::SectorCache::Initialize(SRL_CD_CACHE_SECTORS, Memory::Zone::SRL_CD_CACHE_ZONE);
+#endif
+
+#if defined(SRL_CD_PATH_INDEX) && (SRL_CD_PATH_INDEX > 0)
+                Cd::PathIndex::Initialize(Memory::Zone::SRL_CD_PATH_INDEX_ZONE);
+#endif
             }
             return Cd::isInitialized;
         }
@@ -639,6 +3199,7 @@ namespace SRL
         }
 
         /** @brief Change current directory
+         * @details When Cd::PathIndex is built, name can be a path and directory table is taken from memory
          * @param name Directory name (NULL for root directory)
          */
         inline static void ChangeDir(char *name)
@@ -648,7 +3209,18 @@ namespace SRL
                 name = (char *)0;
             }
 
+            if (PathIndex::IsEnabled())
+            {
+                if (PathIndex::ChangeDir(name))
+                {
+                    Cd::Trace(TraceOperation::ChangeDir, PathIndex::directories[PathIndex::current].Identifier, 0, 0, name);
+                }
+
+                return;
+            }
+
             int32_t fid = GFS_NameToId((int8_t *)name);
+            Cd::Trace(TraceOperation::ChangeDir, fid, 0, 0, name);
             GFS_DIRTBL_TYPE(&GfsDirectories) = GFS_DIR_NAME;
             GFS_DIRTBL_DIRNAME(&GfsDirectories) = Cd::GfsDirectoryNames;
             GFS_DIRTBL_NDIR(&GfsDirectories) = SRL_MAX_CD_FILES;
@@ -5,6 +5,8 @@
 #include "srl_tv.hpp"
 #include "srl_color.hpp"
 #include "srl_cd.hpp"
+#include "srl_stream.hpp"
+#include "srl_asset_loader.hpp"
 #include "srl_vdp1.hpp"
 #include "srl_vdp2.hpp"
 #include "srl_input.hpp"
@@ -99,6 +101,10 @@ namespace SRL
         {
             Core::OnBeforeSync.Invoke();
             slSynch();
+            SRL::Memory::FrameArena::NextFrame();
+            SRL::Cd::Synchronize();
+            SRL::Stream::Update();
+            SRL::AssetLoader::Update();
             SRL::Input::Management::RefreshPeripherals();
             SRL::Input::Gun::Synchronize();
             Core::OnAfterSync.Invoke();
@@ -2,6 +2,7 @@
 
 #include "srl_base.hpp"
 #include "srl_color.hpp"
+#include "srl_memory.hpp"
 
 namespace SRL
 {
@@ -122,11 +123,10 @@ namespace SRL
                     }
 
                     // Copy colors to CRAM
-                    slDMACopy(
-                        data,
+                    Memory::Copy(
                         this->GetData(),
+                        data,
                         colorCount * sizeof(Types::HighColor));
-                    slDMAWait();
 
                     return colorCount;
                 }
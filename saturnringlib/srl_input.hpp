@@ -197,8 +197,7 @@ namespace SRL::Input
         static void RefreshPeripherals()
         {
             // Copy current state to previous state
-            slDMACopy(Management::Peripherals, Management::PeripheralsPreviousState, sizeof(Management::PeripheralsPreviousState));
-            slDMAWait();
+            Memory::Copy(Management::PeripheralsPreviousState, Management::Peripherals, sizeof(Management::PeripheralsPreviousState));
 
             // Copy new state in
             uint8_t* destination = reinterpret_cast<uint8_t*>(Management::Peripherals);
@@ -206,19 +205,13 @@ namespace SRL::Input
             uint32_t batchSize = sizeof(PerDigital) * (Management::MaxPeripherals >> 1);
 
             // Copy first half
-            for (uint32_t byte = 0; byte < batchSize; byte++)
-            {
-                *destination++ = *source++;
-            }
+            Memory::Copy(destination, source, batchSize);
 
             // Offset for second multi-tap (see https://github.com/johannes-fetz/joengine/issues/23)
-            source += sizeof(PerDigital) * 9;
+            source += batchSize + (sizeof(PerDigital) * 9);
 
             // Copy second half
-            for (uint32_t byte = 0; byte < batchSize; byte++)
-            {
-                *destination++ = *source++;
-            }
+            Memory::Copy(destination + batchSize, source, batchSize);
         }
     };
 
@@ -3,6 +3,7 @@
 #include "srl_base.hpp"
 #include "srl_string.hpp"   // for snprintf
 #include "srl_debug.hpp"    // for SRL_DEBUG_MAX_LOG_LENGTH
+#include "srl_cd.hpp"       // for SRL::Cd::TraceEvent
 
 namespace SRL
 {
@@ -264,5 +265,110 @@ namespace SRL
         {
             SRL::Logger::LogInfo(message, args ...);
         }
+
+        /** @brief Log allocator call in the format read by the host memory benchmark (tools/memory_benchmark)
+         * @code {.cpp}
+         * // Record all allocations into the log
+         * SRL::Memory::Telemetry::SetTraceHandler(SRL::Logger::LogMemoryTrace);
+         * @endcode
+         * @tparam lvl Log level
+         * @param event Traced allocator call
+         */
+        template <SRL::Logger::LogLevels lvl = SRL::Logger::LogLevels::INFO>
+        inline void LogMemoryTrace(const SRL::Memory::Telemetry::TraceEvent& event)
+        {
+            static const char operations[] = { 'M', 'F', 'R' };
+
+            SRL::Logger::Log::LogPrint<lvl>(
+                "MT %c %u %x %x %u",
+                operations[static_cast<uint8_t>(event.Operation)],
+                event.Zone,
+                static_cast<uint32_t>(reinterpret_cast<uintptr_t>(event.Address)),
+                static_cast<uint32_t>(reinterpret_cast<uintptr_t>(event.Previous)),
+                event.Size);
+        }
+
+        /** @brief Log file access in the format read by the disc layout optimizer (tools/scripts/srl_disc_order.py)
+         * @code {.cpp}
+         * // Record all file accesses into the log
+         * SRL::Cd::SetTraceHandler(SRL::Logger::LogCdTrace);
+         * @endcode
+         * @tparam lvl Log level
+         * @param event Traced file access
+         */
+        template <SRL::Logger::LogLevels lvl = SRL::Logger::LogLevels::INFO>
+        inline void LogCdTrace(const SRL::Cd::TraceEvent& event)
+        {
+            static const char operations[] = { 'D', 'O', 'S', 'R', 'L' };
+
+            SRL::Logger::Log::LogPrint<lvl>(
+                "CT %c %u %d %s %d %d",
+                operations[static_cast<uint8_t>(event.Operation)],
+                event.Frame,
+                event.Identifier,
+                event.Name != nullptr ? event.Name : "-",
+                event.Offset,
+                event.Size);
+        }
+
+        /** @brief Log memory telemetry of all memory zones and used allocation tags
+         * @tparam lvl Log level
+         */
+        template <SRL::Logger::LogLevels lvl = SRL::Logger::LogLevels::INFO>
+        inline void LogMemoryTelemetry()
+        {
+            if constexpr (lvl >= SRL::Logger::Log::MinLevel)
+            {
+                static const char* zoneNames[] = { "HWRam", "LWRam", "CartRam" };
+
+                for (uint8_t zone = SRL::Memory::Zone::HWRam; zone <= SRL::Memory::Zone::CartRam; zone++)
+                {
+                    const SRL::Memory::Statistics statistics = SRL::Memory::Telemetry::GetStatistics(static_cast<SRL::Memory::Zone>(zone));
+
+                    SRL::Logger::Log::LogPrint<lvl>(
+                        "%s used:%u peak:%u blocks:%u peak:%u",
+                        zoneNames[zone],
+                        statistics.UsedSize,
+                        statistics.PeakUsedSize,
+                        statistics.Allocations,
+                        statistics.PeakAllocations);
+
+                    SRL::Logger::Log::LogPrint<lvl>(
+                        "%s failed:%u largest:%u frag:%u%%",
+                        zoneNames[zone],
+                        statistics.FailedAllocations,
+                        SRL::Memory::GetLargestFreeBlock(static_cast<SRL::Memory::Zone>(zone)),
+                        SRL::Memory::Telemetry::GetFragmentation(static_cast<SRL::Memory::Zone>(zone)));
+
+                    // Blocks up to 16, 32, 64, 128, 256, 512, 1K bytes and larger
+                    SRL::Logger::Log::LogPrint<lvl>(
+                        "%s sizes:%u %u %u %u %u %u %u %u",
+                        zoneNames[zone],
+                        statistics.SizeBuckets[0],
+                        statistics.SizeBuckets[1],
+                        statistics.SizeBuckets[2],
+                        statistics.SizeBuckets[3],
+                        statistics.SizeBuckets[4],
+                        statistics.SizeBuckets[5],
+                        statistics.SizeBuckets[6],
+                        statistics.SizeBuckets[7]);
+                }
+
+                for (uint8_t tag = 1; tag < SRL::Memory::Telemetry::TagCount; tag++)
+                {
+                    const SRL::Memory::TagStatistics statistics = SRL::Memory::Telemetry::GetTagStatistics(tag);
+
+                    if (statistics.PeakUsedSize != 0)
+                    {
+                        SRL::Logger::Log::LogPrint<lvl>(
+                            "Tag %u used:%u peak:%u blocks:%u",
+                            tag,
+                            statistics.UsedSize,
+                            statistics.PeakUsedSize,
+                            statistics.Allocations);
+                    }
+                }
+            }
+        }
     };
 }
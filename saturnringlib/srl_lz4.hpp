@@ -0,0 +1,604 @@
+#pragma once
+
+#include "srl_base.hpp"
+#include "srl_memory.hpp"
+#include "srl_cd.hpp"
+#include "srl_slave.hpp"
+
+namespace SRL
+{
+    /** @brief LZ4 decompression of assets
+     * @details Data are compressed on host by tools/scripts/srl_compress.py into LZ4 block format with small header.
+     * Decoder copies by words where it can and does not use DMA, so it can run on either CPU.<br/>
+     * Compressed files can be loaded in place, compressed data are read into the end of the destination buffer
+     * and decoded while the drive is still reading the rest of the file. Decoding can also run on the slave SH2,
+     * master CPU then only moves sectors from the drive.
+     * @code {.cpp}
+     * // Built by: python3 srl_compress.py level1.map cd/data/LEVEL1.LZ4
+     * SRL::Cd::File file("LEVEL1.LZ4");
+     * int32_t size;
+     *
+     * // Allocate buffer large enough and decode on slave SH2 while loading
+     * uint8_t* map = reinterpret_cast<uint8_t*>(SRL::Lz4::Load(file, size, SRL::Memory::Zone::LWRam, true));
+     * @endcode
+     */
+    class Lz4
+    {
+    public:
+        /** @brief Header of compressed data (big-endian)
+         */
+        struct Header
+        {
+            /** @brief Magic identifier ("SRLZ")
+             */
+            char Magic[4];
+
+            /** @brief Size of decompressed data in bytes
+             */
+            uint32_t Size;
+
+            /** @brief Size of compressed block following the header in bytes
+             */
+            uint32_t CompressedSize;
+        };
+
+        /** @brief Gets size of a buffer needed to decompress data in place
+         * @details Compressed data must be placed at the end of the buffer
+         * @param size Size of decompressed data in bytes
+         * @return Buffer size in bytes
+         */
+        static constexpr size_t GetInPlaceSize(const size_t size)
+        {
+            return size + (size >> 8) + 32;
+        }
+
+        /** @brief Gets size of decompressed data
+         * @param data Compressed data starting with header
+         * @return Size in bytes, negative if data do not start with valid header
+         */
+        static int32_t GetSize(const void* data)
+        {
+            const Header* header = reinterpret_cast<const Header*>(data);
+            return Lz4::IsValid(*header) ? header->Size : -1;
+        }
+
+        /** @brief Decompress raw LZ4 block
+         * @param source Compressed block
+         * @param sourceSize Size of compressed block in bytes
+         * @param destination Buffer to decompress into
+         * @param destinationSize Size of decompressed data in bytes
+         * @return Number of bytes decompressed, negative on corrupted data
+         */
+        static int32_t Decompress(const void* source, const size_t sourceSize, void* destination, const size_t destinationSize)
+        {
+            const uint8_t* input = reinterpret_cast<const uint8_t*>(source);
+            Decoder decoder(input, reinterpret_cast<uint8_t*>(destination));
+            Decoder::Status status = decoder.Run(input + sourceSize, input + sourceSize, reinterpret_cast<uint8_t*>(destination) + destinationSize);
+            return status == Decoder::Status::Done ? decoder.GetDecoded() : -1;
+        }
+
+        /** @brief Decompress data made by srl_compress.py
+         * @param data Compressed data starting with header
+         * @param destination Buffer to decompress into
+         * @param destinationSize Size of the buffer in bytes
+         * @return Number of bytes decompressed, negative on error
+         */
+        static int32_t Decompress(const void* data, void* destination, const size_t destinationSize)
+        {
+            const Header* header = reinterpret_cast<const Header*>(data);
+
+            if (!Lz4::IsValid(*header) || header->Size > destinationSize)
+            {
+                return -1;
+            }
+
+            return Lz4::Decompress(header + 1, header->CompressedSize, destination, header->Size);
+        }
+
+        /** @brief Load and decompress file in place
+         * @details Whole file is read into the end of the buffer by single read request and decoded as sectors arrive
+         * @param file Compressed file
+         * @param destination Buffer to decompress into
+         * @param destinationSize Size of the buffer in bytes, it must fit both the whole file rounded up to sectors
+         * and GetInPlaceSize() of decompressed data plus one sector
+         * @param useSlave Decode on slave SH2 (slave must not be running other task)
+         * @return Number of bytes decompressed, negative on error
+         */
+        static int32_t Load(Cd::File& file, void* destination, const size_t destinationSize, const bool useSlave = false)
+        {
+            uint8_t* sector = new uint8_t[file.Size.SectorSize > 0 ? file.Size.SectorSize : 1];
+            int32_t result = Lz4::LoadHeader(file, sector);
+
+            if (result >= 0)
+            {
+                result = Lz4::Load(file, sector, reinterpret_cast<uint8_t*>(destination), destinationSize, useSlave);
+            }
+
+            delete[] sector;
+            return result;
+        }
+
+        /** @brief Load and decompress file into newly allocated buffer
+         * @param file Compressed file
+         * @param size Number of bytes decompressed, negative on error
+         * @param zone Memory zone to allocate buffer in
+         * @param useSlave Decode on slave SH2 (slave must not be running other task)
+         * @return Decompressed data or nullptr on error, buffer is larger than decompressed data to allow decoding in place
+         */
+        static void* Load(Cd::File& file, int32_t& size, const Memory::Zone zone = Memory::Zone::HWRam, const bool useSlave = false)
+        {
+            uint8_t* sector = new uint8_t[file.Size.SectorSize > 0 ? file.Size.SectorSize : 1];
+            uint8_t* buffer = nullptr;
+            size = Lz4::LoadHeader(file, sector);
+
+            if (size >= 0)
+            {
+                size_t capacity = Lz4::GetLoadSize(file, *reinterpret_cast<Header*>(sector));
+                buffer = new (zone) uint8_t[capacity];
+                size = buffer != nullptr ? Lz4::Load(file, sector, buffer, capacity, useSlave) : Cd::ErrorCode::ErrorBufferFull;
+
+                if (size < 0 && buffer != nullptr)
+                {
+                    delete[] buffer;
+                    buffer = nullptr;
+                }
+            }
+
+            delete[] sector;
+            return buffer;
+        }
+
+    private:
+        /** @brief Resumable LZ4 block decoder
+         * @details Decoder stops at sequence boundary when it runs out of available input and can continue later
+         */
+        class Decoder
+        {
+        public:
+            /** @brief Decoder state
+             */
+            enum class Status : uint8_t
+            {
+                /** @brief Whole block was decoded
+                 */
+                Done,
+
+                /** @brief Decoder needs more input to continue
+                 */
+                NeedInput,
+
+                /** @brief Data are corrupted or do not fit into destination
+                 */
+                Error
+            };
+
+        private:
+            /** @brief Next byte to decode
+             */
+            const uint8_t* input;
+
+            /** @brief Start of decoded data
+             */
+            uint8_t* start;
+
+            /** @brief Next byte to write
+             */
+            uint8_t* output;
+
+            /** @brief Copy bytes forward, destination must be before source or at least 4 bytes after it
+             * @param destination Destination address
+             * @param source Source address
+             * @param length Number of bytes to copy
+             */
+            static void Copy(uint8_t* destination, const uint8_t* source, size_t length)
+            {
+                if (length >= 16 && ((reinterpret_cast<uintptr_t>(destination) ^ reinterpret_cast<uintptr_t>(source)) & 3) == 0)
+                {
+                    for (; (reinterpret_cast<uintptr_t>(destination) & 3) != 0; length--)
+                    {
+                        *destination++ = *source++;
+                    }
+
+                    uint32_t* to = reinterpret_cast<uint32_t*>(destination);
+                    const uint32_t* from = reinterpret_cast<const uint32_t*>(source);
+
+                    for (; length >= 4; length -= 4)
+                    {
+                        *to++ = *from++;
+                    }
+
+                    destination = reinterpret_cast<uint8_t*>(to);
+                    source = reinterpret_cast<const uint8_t*>(from);
+                }
+
+                for (; length > 0; length--)
+                {
+                    *destination++ = *source++;
+                }
+            }
+
+        public:
+            /** @brief Construct decoder
+             * @param input Start of compressed block
+             * @param output Buffer to decompress into
+             */
+            Decoder(const uint8_t* input, uint8_t* output) : input(input), start(output), output(output) { }
+
+            /** @brief Gets number of bytes decoded so far
+             * @return Number of bytes
+             */
+            int32_t GetDecoded() const
+            {
+                return this->output - this->start;
+            }
+
+            /** @brief Decode sequences until input runs out
+             * @param available End of input that can be decoded now
+             * @param inputEnd End of the compressed block
+             * @param outputEnd End of decompressed data
+             * @return Decoder state
+             */
+            Status Run(const uint8_t* available, const uint8_t* inputEnd, uint8_t* outputEnd)
+            {
+                while (true)
+                {
+                    const uint8_t* in = this->input;
+                    uint8_t* out = this->output;
+
+                    if (in >= inputEnd)
+                    {
+                        return out == outputEnd ? Status::Done : Status::Error;
+                    }
+
+                    if (in >= available)
+                    {
+                        return Status::NeedInput;
+                    }
+
+                    const uint8_t token = *in++;
+                    size_t length = token >> 4;
+                    uint8_t extra = 255;
+
+                    // Literals
+                    if (length == 15)
+                    {
+                        do
+                        {
+                            if (in >= available)
+                            {
+                                return available == inputEnd ? Status::Error : Status::NeedInput;
+                            }
+
+                            extra = *in++;
+                            length += extra;
+                        }
+                        while (extra == 255);
+                    }
+
+                    if (length > static_cast<size_t>(available - in))
+                    {
+                        return available == inputEnd ? Status::Error : Status::NeedInput;
+                    }
+
+                    if (length > static_cast<size_t>(outputEnd - out))
+                    {
+                        return Status::Error;
+                    }
+
+                    Decoder::Copy(out, in, length);
+                    in += length;
+                    out += length;
+
+                    // Last sequence has no match
+                    if (in == inputEnd)
+                    {
+                        this->input = in;
+                        this->output = out;
+                        continue;
+                    }
+
+                    if (available - in < 2)
+                    {
+                        return available == inputEnd ? Status::Error : Status::NeedInput;
+                    }
+
+                    const size_t offset = in[0] | (in[1] << 8);
+                    in += 2;
+
+                    if (offset == 0 || offset > static_cast<size_t>(out - this->start))
+                    {
+                        return Status::Error;
+                    }
+
+                    // Match
+                    length = token & 15;
+
+                    if (length == 15)
+                    {
+                        do
+                        {
+                            if (in >= available)
+                            {
+                                return available == inputEnd ? Status::Error : Status::NeedInput;
+                            }
+
+                            extra = *in++;
+                            length += extra;
+                        }
+                        while (extra == 255);
+                    }
+
+                    length += 4;
+
+                    if (length > static_cast<size_t>(outputEnd - out))
+                    {
+                        return Status::Error;
+                    }
+
+                    if (offset >= 4)
+                    {
+                        Decoder::Copy(out, out - offset, length);
+                        out += length;
+                    }
+                    else
+                    {
+                        // Short repeating pattern
+                        for (const uint8_t* match = out - offset; length > 0; length--)
+                        {
+                            *out++ = *match++;
+                        }
+                    }
+
+                    this->input = in;
+                    this->output = out;
+                }
+            }
+        };
+
+        /** @brief Task decoding on slave SH2 while master CPU reads the file
+         */
+        class SlaveDecoder : public Types::ITask
+        {
+        public:
+            /** @brief Block decoder
+             */
+            Decoder decoder;
+
+            /** @brief End of input that arrived so far, written by master CPU
+             */
+            const uint8_t* volatile available;
+
+            /** @brief End of the compressed block
+             */
+            const uint8_t* inputEnd;
+
+            /** @brief End of decompressed data
+             */
+            uint8_t* outputEnd;
+
+            /** @brief Read failed, stop waiting for input
+             */
+            volatile bool aborted;
+
+            /** @brief Decoding finished, written by slave CPU
+             */
+            volatile bool finished;
+
+            /** @brief Decoder state at the end
+             */
+            volatile Decoder::Status status;
+
+            /** @brief Construct task
+             * @param input Start of compressed block
+             * @param inputEnd End of compressed block
+             * @param output Buffer to decompress into
+             * @param outputEnd End of decompressed data
+             */
+            SlaveDecoder(const uint8_t* input, const uint8_t* inputEnd, uint8_t* output, uint8_t* outputEnd) :
+                decoder(input, output),
+                available(input),
+                inputEnd(inputEnd),
+                outputEnd(outputEnd),
+                aborted(false),
+                finished(false),
+                status(Decoder::Status::NeedInput)
+            {
+            }
+
+            /** @brief Decode input as it arrives
+             */
+            void Do() override
+            {
+                // Buffer may be cached from before the file was read
+                slCashPurge();
+                Decoder::Status result;
+
+                do
+                {
+                    // Master CPU writes these, they have to be read around the cache
+                    const uint8_t* end = *Lz4::GetCacheThrough(&this->available);
+                    bool stop = *Lz4::GetCacheThrough(&this->aborted);
+                    result = this->decoder.Run(end, this->inputEnd, this->outputEnd);
+
+                    if (result == Decoder::Status::NeedInput && stop)
+                    {
+                        result = Decoder::Status::Error;
+                    }
+                }
+                while (result == Decoder::Status::NeedInput);
+
+                this->status = result;
+                this->finished = true;
+            }
+        };
+
+        /** @brief Number of bytes in a cache line
+         */
+        inline static const uint32_t CacheLine = 16;
+
+        /** @brief Gets cache-through address of a variable shared by both CPUs
+         * @tparam Type Variable type
+         * @param variable Variable address
+         * @return Address that bypasses CPU cache
+         */
+        template<typename Type>
+        static volatile Type* GetCacheThrough(volatile Type* variable)
+        {
+#if defined(__sh__)
+            return reinterpret_cast<volatile Type*>(reinterpret_cast<uintptr_t>(variable) | 0x20000000);
+#else
+            return variable;
+#endif
+        }
+
+        /** @brief Check header of compressed data
+         * @param header Header
+         * @return true if header is valid
+         */
+        static bool IsValid(const Header& header)
+        {
+            return header.Magic[0] == 'S' && header.Magic[1] == 'R' && header.Magic[2] == 'L' && header.Magic[3] == 'Z';
+        }
+
+        /** @brief Gets buffer size Load() needs for a file
+         * @param file Compressed file
+         * @param header Header of the file
+         * @return Buffer size in bytes
+         */
+        static size_t GetLoadSize(Cd::File& file, const Header& header)
+        {
+            size_t fileSize = file.Size.Sectors * file.Size.SectorSize;
+            size_t inPlaceSize = Lz4::GetInPlaceSize(header.Size) + file.Size.SectorSize;
+            return (fileSize > inPlaceSize ? fileSize : inPlaceSize) + 4;
+        }
+
+        /** @brief Read first sector of the file and check its header
+         * @param file Compressed file
+         * @param sector Buffer for one sector
+         * @return Size of decompressed data, negative on error
+         */
+        static int32_t LoadHeader(Cd::File& file, uint8_t* sector)
+        {
+            if (!file.Exists() || file.Size.Bytes < static_cast<int32_t>(sizeof(Header)))
+            {
+                return Cd::ErrorCode::ErrorNExit;
+            }
+
+            int32_t result = file.LoadBytes(0, file.Size.SectorSize, sector);
+
+            if (result < 0)
+            {
+                return result;
+            }
+
+            const Header* header = reinterpret_cast<const Header*>(sector);
+
+            if (!Lz4::IsValid(*header) || header->CompressedSize + sizeof(Header) > static_cast<size_t>(file.Size.Bytes))
+            {
+                return Cd::ErrorCode::ErrorPara;
+            }
+
+            return header->Size;
+        }
+
+        /** @brief Read rest of the file into the end of the buffer and decode it while it arrives
+         * @param file Compressed file
+         * @param sector First sector of the file
+         * @param destination Buffer to decompress into
+         * @param destinationSize Size of the buffer in bytes
+         * @param useSlave Decode on slave SH2
+         * @return Number of bytes decompressed, negative on error
+         */
+        static int32_t Load(Cd::File& file, const uint8_t* sector, uint8_t* destination, const size_t destinationSize, const bool useSlave)
+        {
+            const Header* header = reinterpret_cast<const Header*>(sector);
+            const int32_t sectorSize = file.Size.SectorSize;
+            const int32_t fileSize = file.Size.Sectors * sectorSize;
+
+            if (destinationSize < Lz4::GetLoadSize(file, *header))
+            {
+                return Cd::ErrorCode::ErrorPara;
+            }
+
+            // File image goes to the end of the buffer, so output never catches up with unread input
+            uint8_t* image = reinterpret_cast<uint8_t*>(reinterpret_cast<uintptr_t>(destination + destinationSize - fileSize) & ~3);
+            const uint8_t* input = image + sizeof(Header);
+            const uint8_t* inputEnd = input + header->CompressedSize;
+            uint8_t* outputEnd = destination + header->Size;
+            Memory::Copy(image, sector, sectorSize);
+
+            Cd::ReadRequest request;
+
+            if (fileSize > sectorSize && !file.LoadBytesAsync(request, 1, fileSize - sectorSize, image + sectorSize))
+            {
+                return Cd::ErrorCode::ErrorBusy;
+            }
+
+            Decoder::Status status;
+
+            if (useSlave)
+            {
+                SlaveDecoder task(input, inputEnd, destination, outputEnd);
+                task.available = Lz4::GetAvailable(image, sectorSize, request, inputEnd);
+                Slave::ExecuteOnSlave(task);
+
+                // Keep moving sectors from the drive while slave decodes
+                while (!*Lz4::GetCacheThrough(&task.finished))
+                {
+                    Cd::Update();
+                    task.available = Lz4::GetAvailable(image, sectorSize, request, inputEnd);
+                    task.aborted = request.GetStatus() == Cd::ReadRequest::Status::Failed;
+                }
+
+                // Output was written by slave
+                slCashPurge();
+                status = *Lz4::GetCacheThrough(&task.status);
+            }
+            else
+            {
+                Decoder decoder(input, destination);
+
+                do
+                {
+                    status = decoder.Run(Lz4::GetAvailable(image, sectorSize, request, inputEnd), inputEnd, outputEnd);
+
+                    if (status == Decoder::Status::NeedInput)
+                    {
+                        if (request.GetStatus() == Cd::ReadRequest::Status::Failed)
+                        {
+                            status = Decoder::Status::Error;
+                        }
+                        else
+                        {
+                            Cd::Update();
+                        }
+                    }
+                }
+                while (status == Decoder::Status::NeedInput);
+            }
+
+            request.Cancel();
+            return status == Decoder::Status::Done ? static_cast<int32_t>(header->Size) : Cd::ErrorCode::ErrorCDRD;
+        }
+
+        /** @brief Gets end of compressed data that arrived so far
+         * @details Kept at cache line boundary until the end, so decoder does not cache lines that are still being written
+         * @param image Start of file image
+         * @param sectorSize Size of the first sector that is already loaded
+         * @param request Read request loading rest of the file
+         * @param inputEnd End of compressed block
+         * @return End of available input
+         */
+        static const uint8_t* GetAvailable(const uint8_t* image, const int32_t sectorSize, const Cd::ReadRequest& request, const uint8_t* inputEnd)
+        {
+            const uint8_t* end = image + sectorSize + request.GetProgress();
+
+            if (end >= inputEnd || request.GetStatus() == Cd::ReadRequest::Status::Completed)
+            {
+                return inputEnd;
+            }
+
+            return reinterpret_cast<const uint8_t*>(reinterpret_cast<uintptr_t>(end) & ~static_cast<uintptr_t>(Lz4::CacheLine - 1));
+        }
+    };
+}
@@ -3,12 +3,25 @@
 #include "srl_base.hpp"
 
 extern "C" {
+    #include <sega_tim.h>
+
     extern char _heap_start;
     extern char _heap_end;
 }
 
+#if defined(USE_TLSF_ALLOCATOR)
 #include <tlsf.h>
+#endif
+
 #include <stdlib.h>
+#include <bit>
+#include <new>
+
+#if !defined(SRL_MEMORY_TAG_SLOTS)
+/** @brief Number of slots in the table of tagged allocations (0 disables allocation tags)
+ */
+#define SRL_MEMORY_TAG_SLOTS 0
+#endif
 
 namespace SRL
 {
@@ -44,6 +57,10 @@ namespace SRL
         };
 
     private:
+        /** @brief Host memory benchmark (tools/memory_benchmark) runs allocators directly on fake memory zones
+         */
+        friend class MemoryBenchmark;
+
         /** @brief Memory zone definition
          */
         struct MemoryZone
@@ -68,6 +85,121 @@ namespace SRL
             return (ptr >= (void*)zone.Address && ptr <= (char*)zone.Address + zone.Size);
         }
 
+        /** @brief Allocator lock shared by both SH2 CPUs
+         * @details Guards allocator headers and telemetry while an allocation is in progress, so ITask code running on the slave CPU
+         * can allocate and free memory too. Lock flag is taken by the @c TAS.B instruction through its cache-through address.<br/>
+         * Both CPUs have their own write-through cache, so only reads can get stale. When the lock is taken over from the other CPU,
+         * cache of the current CPU is purged before any allocator header is read.<br/>
+         * Interrupts are masked while the lock is held, so allocating from an interrupt handler cannot deadlock the CPU it interrupted.
+         */
+        class ZoneLock
+        {
+        private:
+            /** @brief Memory needs to know which CPU it runs on to pick transfer method
+             */
+            friend class Memory;
+
+            /** @brief Lock flag (bit 7 is set by @c TAS.B while the lock is held)
+             */
+            inline static volatile uint8_t flag = 0;
+
+            /** @brief CPU that held the lock last
+             */
+            inline static volatile uint8_t owner = 0;
+
+            /** @brief Interrupt mask bits of the status register before the lock was taken
+             */
+            uint32_t interruptMask;
+
+            /** @brief Get cache-through address of a lock variable
+             * @param variable Lock variable
+             * @return Address that bypasses the CPU cache
+             */
+            inline static volatile uint8_t* GetCacheThrough(volatile uint8_t* variable)
+            {
+#if defined(__sh__)
+                return reinterpret_cast<volatile uint8_t*>(reinterpret_cast<uintptr_t>(variable) | 0x20000000);
+#else
+                return variable;
+#endif
+            }
+
+            /** @brief Get CPU executing the code
+             * @return 0 for master CPU, 1 for slave CPU
+             */
+            inline static uint8_t GetCpu()
+            {
+#if defined(__sh__)
+                // MASTER bit of BCR1 register reflects how the CPU was wired
+                return (*reinterpret_cast<volatile uint32_t*>(0xFFFFFFE0) & 0x8000) != 0 ? 1 : 0;
+#else
+                return 0;
+#endif
+            }
+
+            /** @brief Try to take the lock flag
+             * @return true if lock was free and is now held by the current CPU
+             */
+            inline static bool TestAndSet()
+            {
+#if defined(__sh__)
+                uint32_t acquired;
+                asm volatile ("tas.b @%1\n\tmovt %0" : "=r"(acquired) : "r"(ZoneLock::GetCacheThrough(&ZoneLock::flag)) : "t", "memory");
+                return acquired != 0;
+#else
+                return !__atomic_test_and_set(&ZoneLock::flag, __ATOMIC_ACQUIRE);
+#endif
+            }
+
+        public:
+
+            /** @brief Take the lock, waits while it is held by the other CPU
+             */
+            ZoneLock()
+            {
+#if defined(__sh__)
+                uint32_t status;
+                asm volatile ("stc sr, %0" : "=r"(status));
+                asm volatile ("ldc %0, sr" : : "r"(status | 0xF0) : "memory");
+                this->interruptMask = status & 0xF0;
+#else
+                this->interruptMask = 0;
+#endif
+
+                while (!ZoneLock::TestAndSet())
+                {
+                    // Wait for the other CPU to finish
+                }
+
+                // Headers could have been changed by the other CPU since we last used them
+                uint8_t cpu = ZoneLock::GetCpu();
+                volatile uint8_t* lastOwner = ZoneLock::GetCacheThrough(&ZoneLock::owner);
+
+                if (*lastOwner != cpu)
+                {
+                    slCashPurge();
+                    *lastOwner = cpu;
+                }
+            }
+
+            /** @brief Release the lock and restore interrupt mask
+             */
+            ~ZoneLock()
+            {
+                asm volatile ("" : : : "memory");
+                *ZoneLock::GetCacheThrough(&ZoneLock::flag) = 0;
+
+#if defined(__sh__)
+                uint32_t status;
+                asm volatile ("stc sr, %0" : "=r"(status));
+                asm volatile ("ldc %0, sr" : : "r"((status & ~0xF0UL) | this->interruptMask) : "memory");
+#endif
+            }
+
+            ZoneLock(const ZoneLock&) = delete;
+            ZoneLock& operator=(const ZoneLock&) = delete;
+        };
+
         /** @brief Reye's simple malloc
          */
         class SimpleMalloc
@@ -180,6 +312,7 @@ namespace SRL
                 if (header->Size == newBlock)
                 {
                     header->State = SimpleMalloc::BlockState::Used;
+                    return true;
                 }
                 else if (header->Size > newBlock)
                 {
@@ -216,7 +349,7 @@ namespace SRL
                 if (ptr != nullptr && Memory::InZone(zone, ptr))
                 {
                     // Gets offset to memory array
-                    size_t location = reinterpret_cast<uint32_t>(ptr) - reinterpret_cast<uint32_t>(zone.Address);
+                    size_t location = reinterpret_cast<uintptr_t>(ptr) - reinterpret_cast<uintptr_t>(zone.Address);
 
                     // Check if offset is valid, we do not need to check whether location is 0, since first 4 bytes are always header
                     if (location > 0 && location < zone.Size && (location & 3) == 0)
@@ -230,6 +363,74 @@ namespace SRL
                 }
             }
 
+            /** @brief Get size of allocated block
+             * @param zone Memory zone settings
+             * @param ptr Allocated memory
+             * @return Block size or 0 if pointer does not point to allocated block
+             */
+            inline static size_t GetAllocatedSize(const MemoryZone& zone, void* ptr)
+            {
+                if (ptr != nullptr && Memory::InZone(zone, ptr))
+                {
+                    size_t location = reinterpret_cast<size_t>(ptr) - reinterpret_cast<size_t>(zone.Address);
+
+                    if (location > 0 && location < zone.Size && (location & 3) == 0)
+                    {
+                        SimpleMalloc::Header* header = ((SimpleMalloc::Header*)&((uint8_t*)zone.Address)[location - sizeof(SimpleMalloc::Header)]);
+
+                        if (header->State == SimpleMalloc::BlockState::Used)
+                        {
+                            return header->Size;
+                        }
+                    }
+                }
+
+                return 0;
+            }
+
+            /** @brief Get total size of free memory in specified memory zone
+             * @note This walks the whole zone
+             * @param zone Memory zone
+             * @return Number of bytes
+             */
+            inline static size_t GetFreeSize(const MemoryZone& zone)
+            {
+                return SimpleMalloc::GetReport(zone).FreeSize;
+            }
+
+            /** @brief Get size of the largest block that can be allocated in specified memory zone
+             * @note This walks the whole zone, neighboring free blocks are counted as one since they get merged on allocation
+             * @param zone Memory zone
+             * @return Number of bytes
+             */
+            inline static size_t GetLargestFreeBlock(const MemoryZone& zone)
+            {
+                size_t location = 0;
+                size_t largest = 0;
+                size_t run = 0;
+                bool inRun = false;
+
+                while (location < zone.Size)
+                {
+                    SimpleMalloc::Header* header = ((SimpleMalloc::Header*)&((uint8_t*)zone.Address)[location]);
+
+                    if (header->State == SimpleMalloc::BlockState::Free)
+                    {
+                        run = inRun ? run + sizeof(SimpleMalloc::Header) + header->Size : header->Size;
+                        inRun = true;
+                        largest = run > largest ? run : largest;
+                    }
+                    else
+                    {
+                        inRun = false;
+                    }
+
+                    location = SimpleMalloc::GetNextBlockLocation(zone, location);
+                }
+
+                return largest;
+            }
+
             /** @brief Get report on the allocator in specified memory zone
              * @param zone Memory zone
              * @return State report
@@ -331,27 +532,39 @@ namespace SRL
                 // Validate pointer to not be null and be in zone
                 if (ptr != nullptr && Memory::InZone(zone, ptr))
                 {
-                    // This one is located in the free() function as well, but I do not want to repeat its insides here again 
                     size_t location = reinterpret_cast<size_t>(ptr) - reinterpret_cast<size_t>(zone.Address);
                     size_t headerLocation = location - sizeof(SimpleMalloc::Header);
+                    SimpleMalloc::Header* header = ((SimpleMalloc::Header*)&((uint8_t*)zone.Address)[headerLocation]);
 
-                    // We free the block first, this will also join it will all free blocks right after it
-                    SimpleMalloc::Free(zone, ptr);
-
-                    // Now we check if we can fit inside the new created space
-                    if (SimpleMalloc::SetBlockAllocation(zone, headerLocation, size))
-                    {
-                        // We fit inside
-                        return (void*)&((uint8_t*)zone.Address)[location];
-                    }
-                    else
+                    // Check if offset is valid and block is allocated
+                    if (location > 0 && location < zone.Size && (location & 3) == 0 &&
+                        header->State == SimpleMalloc::BlockState::Used)
                     {
-                        // We do not fit, try to find space elsewhere
+                        size_t oldSize = header->Size;
+
+                        // Align to 4
+                        size_t length = ((size + 3) & ~static_cast<size_t>(3)) & 0x7fffffff;
+
+                        // Join block with all free blocks right after it, block data stay untouched
+                        header->State = SimpleMalloc::BlockState::Free;
+                        SimpleMalloc::MergeFreeMemoryBlocks(zone, headerLocation);
+
+                        // Shrink or grow in place, left over space is split off as a free block
+                        if (SimpleMalloc::SetBlockAllocation(zone, headerLocation, length))
+                        {
+                            return ptr;
+                        }
+
+                        // We do not fit, give back joined free space and try to find space elsewhere
+                        SimpleMalloc::SetBlockAllocation(zone, headerLocation, oldSize);
                         void* newSpace = SimpleMalloc::Malloc(zone, size);
 
-                        // Copy data to the new location
-                        slDMACopy(ptr, newSpace, ((SimpleMalloc::Header*)&((uint8_t*)zone.Address)[headerLocation])->Size);
-                        slDMAWait();
+                        if (newSpace != nullptr)
+                        {
+                            // Copy only the old data, CPU copy does not touch DMA state shared with the other CPU
+                            Memory::CopyCpu(newSpace, ptr, oldSize);
+                            SimpleMalloc::Free(zone, ptr);
+                        }
 
                         // Return address to new thing
                         return newSpace;
@@ -361,430 +574,3296 @@ namespace SRL
                 return nullptr;
             }
         };
-        
-    public:
 
-        /** @brief Memory zone codes
+        /** @brief Segregated free-list malloc
+         * @details Free blocks are kept in size class bins. Small sizes have a bin each, larger sizes are grouped by power of two.
+         * Non-empty bins are tracked in a bitmap, so a fitting free block is found without walking the whole zone.
+         * Free blocks also store their size at the end, which allows neighbors to be merged in constant time on free.
          */
-        enum Zone
+        class SegregatedMalloc
         {
-            /** @brief High (main) system RAM
+        private:
+
+            /** @brief Block header
              */
-            HWRam = 0,
+            struct Header
+            {
+                /** @brief Block is in use
+                 */
+                size_t Used : 1;
 
-            /** @brief Low system RAM
+                /** @brief Block right before this one in memory is free
+                 */
+                size_t PreviousFree : 1;
+
+                /** @brief Block size (without header)
+                 */
+                size_t Size : 30;
+            };
+
+            /** @brief Free list links, stored in the payload of a free block
              */
-            LWRam = 1,
+            struct FreeLinks
+            {
+                /** @brief Next free block in the same bin
+                 */
+                Header* Next;
 
-            /** @brief Expansion cart RAM
+                /** @brief Previous free block in the same bin
+                 */
+                Header* Previous;
+            };
+
+            /** @brief Get base 2 logarithm of a value
+             * @param value Value (must not be 0)
+             * @return Index of the highest set bit
              */
-            CartRam = 2
-        };
+            inline static constexpr size_t Log2(size_t value)
+            {
+                return (sizeof(unsigned long) * 8) - 1 - __builtin_clzl(static_cast<unsigned long>(value));
+            }
 
-        /** @brief Malloc for main system RAM
-         */
-        class HighWorkRam
-        {
-        private:
-        
-            /** @brief Memory class needs to be able to see private members to initialize zones
+            /** @brief Size granularity of all blocks
              */
-            friend class Memory;
+            static constexpr size_t Granularity = sizeof(size_t);
 
-            /** @brief Main system memory zone
-             * @note This is assigned on system initialization
+            /** @brief Smallest block size, free block must be able to hold its links and size footer
              */
-            inline static MemoryZone zone;
+            static constexpr size_t MinimumSize = ((sizeof(FreeLinks) + sizeof(size_t) + Granularity - 1) / Granularity) * Granularity;
 
-            /** @brief Full main system memory zone
+            /** @brief Number of bins holding blocks of single exact size
              */
-            inline static const MemoryZone fullZone = { (void*)0x06000000, 0x07FFFFFF - 0x06000000};
+            static constexpr size_t SmallBinCount = 32;
 
-            /** @brief Initialize memory zone
+            /** @brief Smallest block size that is kept in power of two bins
              */
-            inline static void Initialize()
-            {
-                auto address = reinterpret_cast<void*>(&_heap_start);
-                auto size = reinterpret_cast<size_t>(&_heap_end) - reinterpret_cast<size_t>(&_heap_start);
+            static constexpr size_t SmallBinLimit = SmallBinCount * Granularity;
 
-                #if defined(USE_TLSF_ALLOCATOR)
-                HighWorkRam::zone = Memory::MemoryZone
-                {
-                    tlsf_create_with_pool(address, size),
-                    size
-                };
-                #else
-                HighWorkRam::zone = Memory::MemoryZone
-                {
-                    Memory::SimpleMalloc::InitializeZone(address, size),
-                    size
-                };
-                #endif
-            }
-            
-        public:
+            /** @brief Total number of bins
+             */
+            static constexpr size_t BinCount = SmallBinCount + (sizeof(size_t) * 8) + 1 - std::bit_width(SmallBinLimit);
 
-            /** @brief Check whether pointer is in range of the memory zone
-             * @param ptr Pointer to check
-             * @return true if pointer belongs to the current memory zone
+            /** @brief Number of words in the bin bitmap
              */
-            static bool InRange(void* ptr)
-            {
-                return Memory::InZone(HighWorkRam::fullZone, ptr);
-            }
+            static constexpr size_t BinMapWords = (BinCount + 31) >> 5;
 
-            /** @brief Check whether pointer is in range of the memory zone
-             * @param ptr Pointer to check
-             * @return true if pointer belongs to the current memory zone
+            /** @brief Number of blocks checked in the best matching bin before a larger bin is used
+             */
+            static constexpr size_t SearchLimit = 8;
+
+            /** @brief Allocator state, stored at the start of the zone
              */
-            static bool InRange(uint32_t ptr)
+            struct Control
             {
-                return Memory::InZone(HighWorkRam::fullZone, (void*)ptr);
-            }
+                /** @brief Bit is set for each bin that contains at least one free block
+                 */
+                uint32_t BinMap[BinMapWords];
 
-            /** @brief Free allocated memory
-             * @param ptr Pointer to allocated memory
+                /** @brief First free block of each bin
+                 */
+                Header* Bins[BinCount];
+
+                /** @brief Total size of all free blocks (without headers)
+                 */
+                size_t FreeSize;
+            };
+
+            /** @brief Size of the allocator state rounded up to block granularity
              */
-            static void Free(void* ptr)
+            static constexpr size_t ControlSize = ((sizeof(Control) + Granularity - 1) / Granularity) * Granularity;
+
+            /** @brief Get allocator state of the zone
+             * @param zone Memory zone settings
+             * @return Allocator state
+             */
+            inline static Control* GetControl(const MemoryZone& zone)
             {
-                #if defined(USE_TLSF_ALLOCATOR)
-                tlsf_free(Memory::mainWorkRam.Address, ptr);
-                #else
-                Memory::SimpleMalloc::Free(HighWorkRam::zone, ptr);
-                #endif
+                return reinterpret_cast<Control*>(zone.Address);
             }
 
-            /** @brief Allocate some memory
-             * @param size Number of bytes to allocate
-             * @return Pointer to the allocated space in memory
+            /** @brief Get start of the block data
+             * @param header Block header
+             * @return Block payload
              */
-            static void* Malloc(size_t size)
+            inline static uint8_t* GetPayload(Header* header)
             {
-                #if defined(USE_TLSF_ALLOCATOR)
-                return tlsf_malloc(Memory::mainWorkRam.Address, size);
-                #else
-                return Memory::SimpleMalloc::Malloc(HighWorkRam::zone, size);
-                #endif
+                return reinterpret_cast<uint8_t*>(header) + sizeof(SegregatedMalloc::Header);
             }
 
-            /** @brief Reallocate existing memory
-             * @param ptr Pointer to the existing allocated memory
-             * @param size New size in number of bytes that should be allocated
-             * @return Pointer to the allocated space in memory
+            /** @brief Get block that follows in memory
+             * @param header Block header
+             * @return Header of the next block
              */
-            static void* Realloc(void* ptr, size_t size)
+            inline static Header* GetNextBlock(Header* header)
             {
-                #if defined(USE_TLSF_ALLOCATOR)
-                return tlsf_realloc(Memory::mainWorkRam.Address, size);
-                #else
-                return Memory::SimpleMalloc::Realloc(HighWorkRam::zone, ptr, size);
-                #endif
+                return reinterpret_cast<SegregatedMalloc::Header*>(SegregatedMalloc::GetPayload(header) + header->Size);
             }
 
-            /** @brief Gets total size of the free space in the memory zone
-             * @return Number of bytes
+            /** @brief Get free list links of a free block
+             * @param header Block header
+             * @return Block links
              */
-            static size_t GetFreeSpace()
+            inline static FreeLinks* GetLinks(Header* header)
             {
-                #if defined(USE_TLSF_ALLOCATOR)
-                return 0;
-                #else
-                return Memory::SimpleMalloc::GetReport(HighWorkRam::zone).FreeSize;
-                #endif
+                return reinterpret_cast<SegregatedMalloc::FreeLinks*>(SegregatedMalloc::GetPayload(header));
             }
 
-            /** @brief Gets report on the allocator state
-             * @return Current state of the allocator
+            /** @brief Store block size at the end of a free block and mark it for the next block
+             * @param header Block header
              */
-            static const Report GetReport()
+            inline static void SetFooter(Header* header)
             {
-                #if defined(USE_TLSF_ALLOCATOR)
-                return Report { 0, 0, 0, Memory::mainWorkRam.Size, 0};
-                #else
-                return Memory::SimpleMalloc::GetReport(HighWorkRam::zone);
-                #endif
+                *reinterpret_cast<size_t*>(SegregatedMalloc::GetPayload(header) + header->Size - sizeof(size_t)) = header->Size;
+                SegregatedMalloc::GetNextBlock(header)->PreviousFree = 1;
             }
 
-            /** @brief Gets total size of the memory zone
-             * @return Number of bytes
+            /** @brief Get bin index for block size
+             * @param size Block size
+             * @return Bin index
              */
-            static size_t GetSize()
+            inline static size_t GetBin(size_t size)
             {
-                return HighWorkRam::zone.Size;
+                if (size < SegregatedMalloc::SmallBinLimit)
+                {
+                    return size / SegregatedMalloc::Granularity;
+                }
+
+                return SegregatedMalloc::SmallBinCount + SegregatedMalloc::Log2(size) - SegregatedMalloc::Log2(SegregatedMalloc::SmallBinLimit);
             }
-            
-            /** @brief Gets total size of the used space in the memory zone
-             * @return Number of bytes
+
+            /** @brief Find first non-empty bin
+             * @param control Allocator state
+             * @param bin First bin to check
+             * @return Bin index or BinCount if all bins are empty
              */
-            static size_t GetUsedSpace()
+            inline static size_t FindBin(Control* control, size_t bin)
             {
-                #if defined(USE_TLSF_ALLOCATOR)
-                return 0;
-                #else
-                auto report = Memory::SimpleMalloc::GetReport(HighWorkRam::zone);
-                return report.TotalSize - report.FreeSize;
-                #endif
-            }
+                size_t word = bin >> 5;
 
-        };
+                if (word < SegregatedMalloc::BinMapWords)
+                {
+                    uint32_t bits = control->BinMap[word] & (~0UL << (bin & 31));
 
-        /** @brief Malloc for slower system RAM
-         */
-        class LowWorkRam
-        {
-        private:
+                    while (bits == 0)
+                    {
+                        if (++word >= SegregatedMalloc::BinMapWords)
+                        {
+                            return SegregatedMalloc::BinCount;
+                        }
 
-            /** @brief Memory class needs to be able to see private members to initialize zones
-             */
-            friend class Memory;
+                        bits = control->BinMap[word];
+                    }
 
-            /** @brief Memory zone
+                    return (word << 5) + __builtin_ctzl(bits);
+                }
+
+                return SegregatedMalloc::BinCount;
+            }
+
+            /** @brief Put free block into its bin
+             * @param control Allocator state
+             * @param header Block header
              */
-            inline static Memory::MemoryZone zone;
+            inline static void InsertBlock(Control* control, Header* header)
+            {
+                size_t bin = SegregatedMalloc::GetBin(header->Size);
+                SegregatedMalloc::FreeLinks* links = SegregatedMalloc::GetLinks(header);
+                links->Previous = nullptr;
+                links->Next = control->Bins[bin];
 
-            /** @brief Initialize memory zone
+                if (links->Next != nullptr)
+                {
+                    SegregatedMalloc::GetLinks(links->Next)->Previous = header;
+                }
+
+                control->Bins[bin] = header;
+                control->BinMap[bin >> 5] |= 1UL << (bin & 31);
+                control->FreeSize += header->Size;
+            }
+
+            /** @brief Take free block out of its bin
+             * @param control Allocator state
+             * @param header Block header
              */
-            inline static void Initialize()
+            inline static void RemoveBlock(Control* control, Header* header)
             {
-                const volatile void* address = (void*)0x00200000;
-                const uint32_t size = 0x100000;
+                size_t bin = SegregatedMalloc::GetBin(header->Size);
+                SegregatedMalloc::FreeLinks* links = SegregatedMalloc::GetLinks(header);
+                control->FreeSize -= header->Size;
 
-                #if defined(USE_TLSF_ALLOCATOR)
-                LowWorkRam::mainWorkRam = Memory::MemoryZone
+                if (links->Previous != nullptr)
                 {
-                    tlsf_create_with_pool((void*)address, size),
+                    SegregatedMalloc::GetLinks(links->Previous)->Next = links->Next;
+                }
+                else
+                {
+                    control->Bins[bin] = links->Next;
+
+                    if (links->Next == nullptr)
+                    {
+                        control->BinMap[bin >> 5] &= ~(1UL << (bin & 31));
+                    }
+                }
+
+                if (links->Next != nullptr)
+                {
+                    SegregatedMalloc::GetLinks(links->Next)->Previous = links->Previous;
+                }
+            }
+
+            /** @brief Mark free block as allocated and return left over space back into bins
+             * @param control Allocator state
+             * @param header Block header (must be already removed from its bin)
+             * @param size Requested block size
+             */
+            inline static void SetBlockAllocation(Control* control, Header* header, size_t size)
+            {
+                header->Used = 1;
+
+                if (header->Size - size >= sizeof(SegregatedMalloc::Header) + SegregatedMalloc::MinimumSize)
+                {
+                    // Split current block into two, second part is left over free memory
+                    size_t oldBlockSize = header->Size;
+                    header->Size = size;
+
+                    SegregatedMalloc::Header* rest = SegregatedMalloc::GetNextBlock(header);
+                    rest->Used = 0;
+                    rest->PreviousFree = 0;
+                    rest->Size = oldBlockSize - size - sizeof(SegregatedMalloc::Header);
+                    SegregatedMalloc::SetFooter(rest);
+                    SegregatedMalloc::InsertBlock(control, rest);
+                }
+                else
+                {
+                    SegregatedMalloc::GetNextBlock(header)->PreviousFree = 0;
+                }
+            }
+
+            /** @brief Get header of allocated block
+             * @details Header is checked against its neighbors, so pointers into the middle of a block
+             * or to a block that was already freed (and merged) are rejected
+             * @param zone Memory zone settings
+             * @param ptr Allocated memory
+             * @return Block header or nullptr if pointer does not point to allocated block
+             */
+            inline static Header* GetUsedBlock(const MemoryZone& zone, void* ptr)
+            {
+                if (ptr == nullptr || !Memory::InZone(zone, ptr))
+                {
+                    return nullptr;
+                }
+
+                const size_t location = reinterpret_cast<size_t>(ptr) - reinterpret_cast<size_t>(zone.Address);
+
+                if (location < SegregatedMalloc::ControlSize + sizeof(SegregatedMalloc::Header) ||
+                    location >= zone.Size ||
+                    (location & (SegregatedMalloc::Granularity - 1)) != 0)
+                {
+                    return nullptr;
+                }
+
+                SegregatedMalloc::Header* header = reinterpret_cast<SegregatedMalloc::Header*>(
+                    reinterpret_cast<uint8_t*>(ptr) - sizeof(SegregatedMalloc::Header));
+
+                // Used block of non-zero size, zone end marker follows it at the latest
+                if (!header->Used ||
+                    header->Size == 0 ||
+                    (header->Size & (SegregatedMalloc::Granularity - 1)) != 0 ||
+                    header->Size > zone.Size - location - sizeof(SegregatedMalloc::Header))
+                {
+                    return nullptr;
+                }
+
+                // Block after a used block never has previous block marked as free, free block ends with its size
+                SegregatedMalloc::Header* next = SegregatedMalloc::GetNextBlock(header);
+
+                if (next->PreviousFree ||
+                    (!next->Used && *reinterpret_cast<size_t*>(SegregatedMalloc::GetPayload(next) + next->Size - sizeof(size_t)) != next->Size))
+                {
+                    return nullptr;
+                }
+
+                // Free block before this one must end right at our header
+                if (header->PreviousFree)
+                {
+                    const size_t previousSize = *reinterpret_cast<size_t*>(reinterpret_cast<uint8_t*>(header) - sizeof(size_t));
+
+                    if (previousSize + sizeof(SegregatedMalloc::Header) > location - SegregatedMalloc::ControlSize - sizeof(SegregatedMalloc::Header))
+                    {
+                        return nullptr;
+                    }
+
+                    SegregatedMalloc::Header* previous = reinterpret_cast<SegregatedMalloc::Header*>(
+                        reinterpret_cast<uint8_t*>(header) - previousSize - sizeof(SegregatedMalloc::Header));
+
+                    if (previous->Used || previous->Size != previousSize)
+                    {
+                        return nullptr;
+                    }
+                }
+
+                return header;
+            }
+
+            /** @brief Align requested size to block granularity
+             * @param size Requested size
+             * @return Block size
+             */
+            inline static constexpr size_t GetBlockSize(size_t size)
+            {
+                size_t length = (size + SegregatedMalloc::Granularity - 1) & ~(SegregatedMalloc::Granularity - 1);
+                return length < SegregatedMalloc::MinimumSize ? SegregatedMalloc::MinimumSize : length;
+            }
+
+        public:
+
+            /** @brief Free memory
+             * @param zone Memory zone settings
+             * @param ptr Allocated memory
+             */
+            inline static void Free(const MemoryZone& zone, void* ptr)
+            {
+                SegregatedMalloc::Header* header = SegregatedMalloc::GetUsedBlock(zone, ptr);
+
+                if (header != nullptr)
+                {
+                    SegregatedMalloc::Control* control = SegregatedMalloc::GetControl(zone);
+                    SegregatedMalloc::Header* next = SegregatedMalloc::GetNextBlock(header);
+
+                    // Header can end up inside of a merged free block, it must not look like a live block anymore
+                    header->Used = 0;
+
+                    // Merge with following free block
+                    if (!next->Used)
+                    {
+                        SegregatedMalloc::RemoveBlock(control, next);
+                        header->Size += sizeof(SegregatedMalloc::Header) + next->Size;
+                    }
+
+                    // Merge with preceding free block, its size is stored right before our header
+                    if (header->PreviousFree)
+                    {
+                        size_t previousSize = *reinterpret_cast<size_t*>(reinterpret_cast<uint8_t*>(header) - sizeof(size_t));
+                        SegregatedMalloc::Header* previous = reinterpret_cast<SegregatedMalloc::Header*>(
+                            reinterpret_cast<uint8_t*>(header) - previousSize - sizeof(SegregatedMalloc::Header));
+
+                        SegregatedMalloc::RemoveBlock(control, previous);
+                        previous->Size += sizeof(SegregatedMalloc::Header) + header->Size;
+                        header = previous;
+                    }
+
+                    header->Used = 0;
+                    SegregatedMalloc::SetFooter(header);
+                    SegregatedMalloc::InsertBlock(control, header);
+                }
+            }
+
+            /** @brief Get size of allocated block
+             * @param zone Memory zone settings
+             * @param ptr Allocated memory
+             * @return Block size or 0 if pointer does not point to allocated block
+             */
+            inline static size_t GetAllocatedSize(const MemoryZone& zone, void* ptr)
+            {
+                SegregatedMalloc::Header* header = SegregatedMalloc::GetUsedBlock(zone, ptr);
+                return header != nullptr ? header->Size : 0;
+            }
+
+            /** @brief Get total size of free memory in specified memory zone
+             * @param zone Memory zone
+             * @return Number of bytes
+             */
+            inline static size_t GetFreeSize(const MemoryZone& zone)
+            {
+                return SegregatedMalloc::GetControl(zone)->FreeSize;
+            }
+
+            /** @brief Get size of the largest block that can be allocated in specified memory zone
+             * @details Only the highest non-empty bin is checked
+             * @param zone Memory zone
+             * @return Number of bytes
+             */
+            inline static size_t GetLargestFreeBlock(const MemoryZone& zone)
+            {
+                SegregatedMalloc::Control* control = SegregatedMalloc::GetControl(zone);
+                size_t largest = 0;
+
+                for (size_t word = SegregatedMalloc::BinMapWords; word > 0; word--)
+                {
+                    uint32_t bits = control->BinMap[word - 1];
+
+                    if (bits != 0)
+                    {
+                        size_t bin = ((word - 1) << 5) + SegregatedMalloc::Log2(bits);
+
+                        for (SegregatedMalloc::Header* header = control->Bins[bin];
+                            header != nullptr;
+                            header = SegregatedMalloc::GetLinks(header)->Next)
+                        {
+                            largest = header->Size > largest ? header->Size : largest;
+                        }
+
+                        break;
+                    }
+                }
+
+                return largest;
+            }
+
+            /** @brief Get report on the allocator in specified memory zone
+             * @param zone Memory zone
+             * @return State report
+             */
+            inline static const Report GetReport(const MemoryZone& zone)
+            {
+                auto report = Report { SegregatedMalloc::ControlSize, 0, 0, zone.Size, 0 };
+                SegregatedMalloc::Header* header = reinterpret_cast<SegregatedMalloc::Header*>(
+                    reinterpret_cast<uint8_t*>(zone.Address) + SegregatedMalloc::ControlSize);
+
+                // Walk until the zone end marker, which is the only allocated block of zero size
+                while (true)
+                {
+                    report.AllocationHeaders += sizeof(SegregatedMalloc::Header);
+
+                    if (!header->Used)
+                    {
+                        report.FreeBlocks++;
+                        report.FreeSize += header->Size;
+                    }
+                    else if (header->Size != 0)
+                    {
+                        report.UsedBlocks++;
+                    }
+                    else
+                    {
+                        break;
+                    }
+
+                    header = SegregatedMalloc::GetNextBlock(header);
+                }
+
+                return report;
+            }
+
+            /** @brief Initializes a new memory zone and returns its starting address
+             * @param start Zone start address
+             * @param size Zone size
+             * @return Zone start address
+             */
+            inline static void* InitializeZone(void* start, const size_t size)
+            {
+                size_t zoneSize = size & ~(SegregatedMalloc::Granularity - 1);
+                SegregatedMalloc::Control* control = reinterpret_cast<SegregatedMalloc::Control*>(start);
+
+                for (size_t word = 0; word < SegregatedMalloc::BinMapWords; word++)
+                {
+                    control->BinMap[word] = 0;
+                }
+
+                for (size_t bin = 0; bin < SegregatedMalloc::BinCount; bin++)
+                {
+                    control->Bins[bin] = nullptr;
+                }
+
+                control->FreeSize = 0;
+
+                // Zone end marker, it is never free so blocks do not need to check zone bounds
+                SegregatedMalloc::Header* end = reinterpret_cast<SegregatedMalloc::Header*>(
+                    reinterpret_cast<uint8_t*>(start) + zoneSize - sizeof(SegregatedMalloc::Header));
+                end->Used = 1;
+                end->Size = 0;
+
+                // Rest of the zone is one big free block
+                SegregatedMalloc::Header* header = reinterpret_cast<SegregatedMalloc::Header*>(
+                    reinterpret_cast<uint8_t*>(start) + SegregatedMalloc::ControlSize);
+                header->Used = 0;
+                header->PreviousFree = 0;
+                header->Size = zoneSize - SegregatedMalloc::ControlSize - (sizeof(SegregatedMalloc::Header) << 1);
+                SegregatedMalloc::SetFooter(header);
+                SegregatedMalloc::InsertBlock(control, header);
+                return start;
+            }
+
+            /** @brief Allocate memory
+             * @param zone Memory zone settings
+             * @param size Number of bytes to allocate
+             * @return Pointer to allocated space
+             */
+            inline static void* Malloc(const MemoryZone& zone, size_t size)
+            {
+                if (size >= zone.Size)
+                {
+                    return nullptr;
+                }
+
+                SegregatedMalloc::Control* control = SegregatedMalloc::GetControl(zone);
+                size_t length = SegregatedMalloc::GetBlockSize(size);
+                size_t bin = SegregatedMalloc::GetBin(length);
+                SegregatedMalloc::Header* found = nullptr;
+                SegregatedMalloc::Header* candidate = control->Bins[bin];
+
+                // Blocks in power of two bins can be smaller than requested, check first few of them
+                for (size_t tries = 0; candidate != nullptr && tries < SegregatedMalloc::SearchLimit; tries++)
+                {
+                    if (candidate->Size >= length)
+                    {
+                        found = candidate;
+                        break;
+                    }
+
+                    candidate = SegregatedMalloc::GetLinks(candidate)->Next;
+                }
+
+                // Any block in larger bin fits
+                if (found == nullptr)
+                {
+                    size_t larger = SegregatedMalloc::FindBin(control, bin + 1);
+
+                    if (larger < SegregatedMalloc::BinCount)
+                    {
+                        found = control->Bins[larger];
+                    }
+                }
+
+                // Last resort, check rest of the best matching bin
+                while (found == nullptr && candidate != nullptr)
+                {
+                    if (candidate->Size >= length)
+                    {
+                        found = candidate;
+                    }
+
+                    candidate = SegregatedMalloc::GetLinks(candidate)->Next;
+                }
+
+                if (found != nullptr)
+                {
+                    SegregatedMalloc::RemoveBlock(control, found);
+                    SegregatedMalloc::SetBlockAllocation(control, found, length);
+                    return SegregatedMalloc::GetPayload(found);
+                }
+
+                // We could not allocate anything
+                return nullptr;
+            }
+
+            /** @brief Reallocate memory (can either shrink, enlarge or move)
+             * @param zone Memory zone settings
+             * @param ptr Allocated memory to resize
+             * @param size New size of the allocated block
+             * @return void* Pointer to resized or moved block
+             */
+            inline static void* Realloc(const MemoryZone& zone, void* ptr, size_t size)
+            {
+                SegregatedMalloc::Header* header = SegregatedMalloc::GetUsedBlock(zone, ptr);
+
+                if (header != nullptr)
+                {
+                    SegregatedMalloc::Control* control = SegregatedMalloc::GetControl(zone);
+                    SegregatedMalloc::Header* next = SegregatedMalloc::GetNextBlock(header);
+                    size_t length = SegregatedMalloc::GetBlockSize(size);
+
+                    // Join following free block if we fit into both, when shrinking this lets left over space merge with it
+                    if (!next->Used && header->Size + sizeof(SegregatedMalloc::Header) + next->Size >= length)
+                    {
+                        SegregatedMalloc::RemoveBlock(control, next);
+                        header->Size += sizeof(SegregatedMalloc::Header) + next->Size;
+                    }
+
+                    // Shrink or grow in place, left over space is split off as a free block
+                    if (length <= header->Size)
+                    {
+                        SegregatedMalloc::SetBlockAllocation(control, header, length);
+                        return ptr;
+                    }
+
+                    // We do not fit, try to find space elsewhere
+                    void* newSpace = SegregatedMalloc::Malloc(zone, size);
+
+                    if (newSpace != nullptr)
+                    {
+                        // Copy only the old data, CPU copy does not touch DMA state shared with the other CPU
+                        Memory::CopyCpu(newSpace, ptr, header->Size);
+                        SegregatedMalloc::Free(zone, ptr);
+                    }
+
+                    // Return address to new thing
+                    return newSpace;
+                }
+
+                return nullptr;
+            }
+        };
+
+#if defined(USE_TLSF_ALLOCATOR)
+        /** @brief Two-level segregated fit malloc
+         * @details Thin wrapper around TLSF library, each memory zone is a separate TLSF instance with its own pool.<br/>
+         * Project url: <a href="https://github.com/mattconte/tlsf">Here</a>
+         */
+        class TlsfMalloc
+        {
+        private:
+
+            /** @brief Used to collect state of the pool while walking it
+             * @param ptr Block location
+             * @param size Block size
+             * @param used Block is in use
+             * @param user Report that is being filled
+             */
+            inline static void ReportWalker(void* ptr, size_t size, int used, void* user)
+            {
+                Report* report = reinterpret_cast<Report*>(user);
+                report->AllocationHeaders += tlsf_alloc_overhead();
+
+                if (used)
+                {
+                    report->UsedBlocks++;
+                }
+                else
+                {
+                    report->FreeBlocks++;
+                    report->FreeSize += size;
+                }
+            }
+
+            /** @brief Used to find largest free block while walking the pool
+             * @param ptr Block location
+             * @param size Block size
+             * @param used Block is in use
+             * @param user Largest block size found so far
+             */
+            inline static void LargestBlockWalker(void* ptr, size_t size, int used, void* user)
+            {
+                size_t* largest = reinterpret_cast<size_t*>(user);
+
+                if (!used && size > *largest)
+                {
+                    *largest = size;
+                }
+            }
+
+            /** @brief Check whether block is allocated
+             * @note TLSF keeps free flag in the lowest bit of the size field stored right before the block data
+             * @param ptr Allocated memory
+             * @return true if block is in use
+             */
+            inline static bool IsUsed(void* ptr)
+            {
+                return (*(reinterpret_cast<size_t*>(ptr) - 1) & 1) == 0;
+            }
+
+        public:
+
+            /** @brief Free memory
+             * @param zone Memory zone settings
+             * @param ptr Allocated memory
+             */
+            inline static void Free(const MemoryZone& zone, void* ptr)
+            {
+                // Validate pointer to not be null, be in zone and not be already freed
+                if (ptr != nullptr &&
+                    Memory::InZone(zone, ptr) &&
+                    (reinterpret_cast<size_t>(ptr) & 3) == 0 &&
+                    TlsfMalloc::IsUsed(ptr))
+                {
+                    tlsf_free(zone.Address, ptr);
+                }
+            }
+
+            /** @brief Get size of allocated block
+             * @param zone Memory zone settings
+             * @param ptr Allocated memory
+             * @return Block size or 0 if pointer does not point to allocated block
+             */
+            inline static size_t GetAllocatedSize(const MemoryZone& zone, void* ptr)
+            {
+                if (ptr != nullptr &&
+                    Memory::InZone(zone, ptr) &&
+                    (reinterpret_cast<size_t>(ptr) & 3) == 0 &&
+                    TlsfMalloc::IsUsed(ptr))
+                {
+                    return tlsf_block_size(ptr);
+                }
+
+                return 0;
+            }
+
+            /** @brief Get total size of free memory in specified memory zone
+             * @note This walks the whole pool
+             * @param zone Memory zone
+             * @return Number of bytes
+             */
+            inline static size_t GetFreeSize(const MemoryZone& zone)
+            {
+                return TlsfMalloc::GetReport(zone).FreeSize;
+            }
+
+            /** @brief Get size of the largest block that can be allocated in specified memory zone
+             * @note This walks the whole pool
+             * @param zone Memory zone
+             * @return Number of bytes
+             */
+            inline static size_t GetLargestFreeBlock(const MemoryZone& zone)
+            {
+                size_t largest = 0;
+                tlsf_walk_pool(tlsf_get_pool(zone.Address), TlsfMalloc::LargestBlockWalker, &largest);
+                return largest;
+            }
+
+            /** @brief Get report on the allocator in specified memory zone
+             * @param zone Memory zone
+             * @return State report
+             */
+            inline static const Report GetReport(const MemoryZone& zone)
+            {
+                auto report = Report { tlsf_size() + tlsf_pool_overhead(), 0, 0, zone.Size, 0 };
+                tlsf_walk_pool(tlsf_get_pool(zone.Address), TlsfMalloc::ReportWalker, &report);
+                return report;
+            }
+
+            /** @brief Initializes a new memory zone and returns its starting address
+             * @param start Zone start address
+             * @param size Zone size
+             * @return Zone start address (TLSF instance)
+             */
+            inline static void* InitializeZone(void* start, const size_t size)
+            {
+                return tlsf_create_with_pool(start, size);
+            }
+
+            /** @brief Allocate memory
+             * @param zone Memory zone settings
+             * @param size Number of bytes to allocate
+             * @return Pointer to allocated space
+             */
+            inline static void* Malloc(const MemoryZone& zone, size_t size)
+            {
+                return tlsf_malloc(zone.Address, size);
+            }
+
+            /** @brief Reallocate memory (can either shrink, enlarge or move)
+             * @param zone Memory zone settings
+             * @param ptr Allocated memory to resize
+             * @param size New size of the allocated block
+             * @return void* Pointer to resized or moved block
+             */
+            inline static void* Realloc(const MemoryZone& zone, void* ptr, size_t size)
+            {
+                // Validate pointer to not be null and be in zone
+                if (ptr != nullptr && Memory::InZone(zone, ptr) && TlsfMalloc::IsUsed(ptr))
+                {
+                    return tlsf_realloc(zone.Address, ptr, size);
+                }
+
+                return nullptr;
+            }
+        };
+
+        /** @brief Allocator used by memory zones
+         */
+        using Allocator = Memory::TlsfMalloc;
+#elif defined(USE_SIMPLE_ALLOCATOR)
+        /** @brief Allocator used by memory zones
+         */
+        using Allocator = Memory::SimpleMalloc;
+#else
+        /** @brief Allocator used by memory zones
+         */
+        using Allocator = Memory::SegregatedMalloc;
+#endif
+
+    public:
+
+        /** @brief Memory zone codes
+         */
+        enum Zone
+        {
+            /** @brief High (main) system RAM
+             */
+            HWRam = 0,
+
+            /** @brief Low system RAM
+             */
+            LWRam = 1,
+
+            /** @brief Expansion cart RAM
+             */
+            CartRam = 2
+        };
+
+        /** @brief Allocation category identifier used by memory telemetry
+         * @details Value 0 means untagged allocation, see Memory::Telemetry for more details
+         */
+        using AllocationTag = uint8_t;
+
+        /** @brief Malloc for main system RAM
+         */
+        class HighWorkRam
+        {
+        private:
+        
+            /** @brief Memory class needs to be able to see private members to initialize zones
+             */
+            friend class Memory;
+
+            /** @brief Main system memory zone
+             * @note This is assigned on system initialization
+             */
+            inline static MemoryZone zone;
+
+            /** @brief Full main system memory zone
+             */
+            inline static const MemoryZone fullZone = { (void*)0x06000000, 0x07FFFFFF - 0x06000000};
+
+            /** @brief Initialize memory zone
+             */
+            inline static void Initialize()
+            {
+                auto address = reinterpret_cast<void*>(&_heap_start);
+                auto size = reinterpret_cast<size_t>(&_heap_end) - reinterpret_cast<size_t>(&_heap_start);
+
+                HighWorkRam::zone = Memory::MemoryZone
+                {
+                    Memory::Allocator::InitializeZone(address, size),
+                    size
+                };
+            }
+            
+        public:
+
+            /** @brief Check whether pointer is in range of the memory zone
+             * @param ptr Pointer to check
+             * @return true if pointer belongs to the current memory zone
+             */
+            static bool InRange(void* ptr)
+            {
+                return Memory::InZone(HighWorkRam::fullZone, ptr);
+            }
+
+            /** @brief Check whether pointer is in range of the memory zone
+             * @param ptr Pointer to check
+             * @return true if pointer belongs to the current memory zone
+             */
+            static bool InRange(uintptr_t ptr)
+            {
+                return Memory::InZone(HighWorkRam::fullZone, (void*)ptr);
+            }
+
+            /** @brief Free allocated memory
+             * @param ptr Pointer to allocated memory
+             */
+            static void Free(void* ptr)
+            {
+                Memory::ZoneLock lock;
+
+                Memory::Telemetry::Trace(Memory::Telemetry::TraceOperation::Free, Memory::Zone::HWRam, ptr, nullptr, 0);
+                Memory::Telemetry::Untrack(Memory::Zone::HWRam, ptr, Memory::Allocator::GetAllocatedSize(HighWorkRam::zone, ptr));
+                Memory::Allocator::Free(HighWorkRam::zone, ptr);
+            }
+
+            /** @brief Allocate some memory
+             * @param size Number of bytes to allocate
+             * @param tag Allocation category used by telemetry
+             * @return Pointer to the allocated space in memory
+             */
+            static void* Malloc(size_t size, const Memory::AllocationTag tag = 0)
+            {
+                Memory::ZoneLock lock;
+
+                void* ptr = Memory::Allocator::Malloc(HighWorkRam::zone, size);
+                Memory::Telemetry::Track(Memory::Zone::HWRam, ptr, Memory::Allocator::GetAllocatedSize(HighWorkRam::zone, ptr), tag);
+                Memory::Telemetry::Trace(Memory::Telemetry::TraceOperation::Malloc, Memory::Zone::HWRam, ptr, nullptr, size);
+                return ptr;
+            }
+
+            /** @brief Reallocate existing memory
+             * @param ptr Pointer to the existing allocated memory
+             * @param size New size in number of bytes that should be allocated
+             * @return Pointer to the allocated space in memory
+             */
+            static void* Realloc(void* ptr, size_t size)
+            {
+                Memory::ZoneLock lock;
+                return Memory::Telemetry::Realloc(HighWorkRam::zone, Memory::Zone::HWRam, ptr, size);
+            }
+
+            /** @brief Gets total size of the free space in the memory zone
+             * @return Number of bytes
+             */
+            static size_t GetFreeSpace()
+            {
+                Memory::ZoneLock lock;
+                return Memory::Allocator::GetFreeSize(HighWorkRam::zone);
+            }
+
+            /** @brief Gets size of the largest block that can be allocated in the memory zone
+             * @return Number of bytes
+             */
+            static size_t GetLargestFreeBlock()
+            {
+                Memory::ZoneLock lock;
+                return Memory::Allocator::GetLargestFreeBlock(HighWorkRam::zone);
+            }
+
+            /** @brief Gets report on the allocator state
+             * @return Current state of the allocator
+             */
+            static const Report GetReport()
+            {
+                Memory::ZoneLock lock;
+                return Memory::Allocator::GetReport(HighWorkRam::zone);
+            }
+
+            /** @brief Gets total size of the memory zone
+             * @return Number of bytes
+             */
+            static size_t GetSize()
+            {
+                return HighWorkRam::zone.Size;
+            }
+            
+            /** @brief Gets total size of the used space in the memory zone
+             * @return Number of bytes
+             */
+            static size_t GetUsedSpace()
+            {
+                Memory::ZoneLock lock;
+                return HighWorkRam::zone.Size - Memory::Allocator::GetFreeSize(HighWorkRam::zone);
+            }
+
+        };
+
+        /** @brief Malloc for slower system RAM
+         */
+        class LowWorkRam
+        {
+        private:
+
+            /** @brief Memory class needs to be able to see private members to initialize zones
+             */
+            friend class Memory;
+
+            /** @brief Memory zone
+             */
+            inline static Memory::MemoryZone zone;
+
+            /** @brief Initialize memory zone
+             */
+            inline static void Initialize()
+            {
+                const volatile void* address = (void*)0x00200000;
+                const uint32_t size = 0x100000;
+
+                LowWorkRam::zone = Memory::MemoryZone
+                {
+                    Memory::Allocator::InitializeZone((void*)address, size),
                     size
                 };
-                #else
-                LowWorkRam::zone = Memory::MemoryZone
+            }
+            
+        public:
+
+            /** @brief Check whether pointer is in range of the memory zone
+             * @param ptr Pointer to check
+             * @return true if pointer belongs to the current memory zone
+             */
+            inline static bool InRange(void* ptr)
+            {
+                return Memory::InZone(LowWorkRam::zone, ptr);
+            }
+
+            /** @brief Check whether pointer is in range of the memory zone
+             * @param zoneAddress Zone address to check
+             * @return true if pointer belongs to the current memory zone
+             */
+            inline static bool InRange(uintptr_t zoneAddress)
+            {
+                return Memory::InZone(LowWorkRam::zone, (void*)zoneAddress);
+            }
+
+            /** @brief Free allocated memory
+             * @param ptr Pointer to allocated memory
+             */
+            inline static void Free(void* ptr)
+            {
+                Memory::ZoneLock lock;
+
+                Memory::Telemetry::Trace(Memory::Telemetry::TraceOperation::Free, Memory::Zone::LWRam, ptr, nullptr, 0);
+                Memory::Telemetry::Untrack(Memory::Zone::LWRam, ptr, Memory::Allocator::GetAllocatedSize(LowWorkRam::zone, ptr));
+                Memory::Allocator::Free(LowWorkRam::zone, ptr);
+            }
+
+            /** @brief Allocate some memory
+             * @param size Number of bytes to allocate
+             * @param tag Allocation category used by telemetry
+             * @return Pointer to the allocated space in memory
+             */
+            inline static void* Malloc(size_t size, const Memory::AllocationTag tag = 0)
+            {
+                Memory::ZoneLock lock;
+
+                void* ptr = Memory::Allocator::Malloc(LowWorkRam::zone, size);
+                Memory::Telemetry::Track(Memory::Zone::LWRam, ptr, Memory::Allocator::GetAllocatedSize(LowWorkRam::zone, ptr), tag);
+                Memory::Telemetry::Trace(Memory::Telemetry::TraceOperation::Malloc, Memory::Zone::LWRam, ptr, nullptr, size);
+                return ptr;
+            }
+
+           /** @brief Reallocate existing memory
+            * @param ptr Pointer to the existing allocated memory
+            * @param size New size in number of bytes that should be allocated
+            * @return Pointer to the allocated space in memory
+            */
+            inline static void* Realloc(void* ptr, size_t size)
+            {
+                Memory::ZoneLock lock;
+                return Memory::Telemetry::Realloc(LowWorkRam::zone, Memory::Zone::LWRam, ptr, size);
+            }
+
+            /** @brief Gets total size of the free space in the memory zone
+             * @return Number of bytes
+             */
+            static size_t GetFreeSpace()
+            {
+                Memory::ZoneLock lock;
+                return Memory::Allocator::GetFreeSize(LowWorkRam::zone);
+            }
+
+            /** @brief Gets size of the largest block that can be allocated in the memory zone
+             * @return Number of bytes
+             */
+            static size_t GetLargestFreeBlock()
+            {
+                Memory::ZoneLock lock;
+                return Memory::Allocator::GetLargestFreeBlock(LowWorkRam::zone);
+            }
+
+            /** @brief Gets report on the allocator state
+             * @return Current state of the allocator
+             */
+            static const Report GetReport()
+            {
+                Memory::ZoneLock lock;
+                return Memory::Allocator::GetReport(LowWorkRam::zone);
+            }
+
+            /** @brief Gets total size of the memory zone
+             * @return Number of bytes
+             */
+            inline static size_t GetSize()
+            {
+                return LowWorkRam::zone.Size;
+            }
+            
+            /** @brief Gets total size of the used space in the memory zone
+             * @return Number of bytes
+             */
+            static size_t GetUsedSpace()
+            {
+                Memory::ZoneLock lock;
+                return LowWorkRam::zone.Size - Memory::Allocator::GetFreeSize(LowWorkRam::zone);
+            }
+        };
+
+        /** @brief Malloc for expansion cart RAM
+         * @details Cart is detected on memory initialization, supported are 1MB and 4MB RAM carts.<br/>
+         * 1MB cart has its memory split into two separate 512KB banks, each bank is then managed as its own allocator zone.
+         */
+        class CartRam
+        {
+        public:
+
+            /** @brief Expansion cart type (cart identifier)
+             */
+            enum class CartType : uint8_t
+            {
+                /** @brief No RAM cart present
+                 */
+                None = 0x00,
+
+                /** @brief 1MB (8Mbit) RAM cart
+                 */
+                Ram1MB = 0x5A,
+
+                /** @brief 4MB (32Mbit) RAM cart
+                 */
+                Ram4MB = 0x5C
+            };
+
+        private:
+
+            /** @brief Memory class needs to be able to see private members to initialize zones
+             */
+            friend class Memory;
+
+            /** @brief Maximal number of separate memory banks cart can have
+             */
+            static constexpr size_t MaxBanks = 2;
+
+            /** @brief Cart identifier location
+             */
+            static constexpr uint32_t IdAddress = 0x24FFFFFF;
+
+            /** @brief Cart RAM write enable register
+             */
+            static constexpr uint32_t WriteEnableAddress = 0x257EFFFE;
+
+            /** @brief SCU A-Bus set register for CS0
+             */
+            static constexpr uint32_t AbusSetAddress = 0x25FE00B0;
+
+            /** @brief SCU A-Bus refresh register
+             */
+            static constexpr uint32_t AbusRefreshAddress = 0x25FE00B8;
+
+            /** @brief Start of the cart RAM (cache-through)
+             */
+            static constexpr uint32_t RamAddress = 0x22400000;
+
+            /** @brief Start of the second bank of 1MB cart (cache-through)
+             */
+            static constexpr uint32_t SecondBankAddress = 0x22600000;
+
+            /** @brief Memory zones of each bank
+             */
+            inline static Memory::MemoryZone zones[CartRam::MaxBanks];
+
+            /** @brief Number of initialized banks
+             */
+            inline static size_t bankCount = 0;
+
+            /** @brief Detected cart type
+             */
+            inline static CartType cartType = CartType::None;
+
+            /** @brief Add memory bank
+             * @param address Bank start
+             * @param size Bank size
+             */
+            inline static void AddBank(uint32_t address, size_t size)
+            {
+                CartRam::zones[CartRam::bankCount++] = Memory::MemoryZone
+                {
+                    Memory::Allocator::InitializeZone(reinterpret_cast<void*>(address), size),
+                    size
+                };
+            }
+
+            /** @brief Find bank containing pointer
+             * @param ptr Pointer to check
+             * @return Bank zone or nullptr if pointer does not belong to the cart RAM
+             */
+            inline static const Memory::MemoryZone* GetBank(void* ptr)
+            {
+                for (size_t bank = 0; bank < CartRam::bankCount; bank++)
+                {
+                    if (Memory::InZone(CartRam::zones[bank], ptr))
+                    {
+                        return &CartRam::zones[bank];
+                    }
+                }
+
+                return nullptr;
+            }
+
+            /** @brief Detect cart and initialize memory zone
+             */
+            inline static void Initialize()
+            {
+                CartRam::bankCount = 0;
+                CartRam::cartType = static_cast<CartType>(*reinterpret_cast<volatile uint8_t*>(CartRam::IdAddress));
+
+                if (CartRam::cartType == CartType::Ram1MB || CartRam::cartType == CartType::Ram4MB)
+                {
+                    // Set A-Bus timing and refresh for DRAM, then enable writes into the cart
+                    *reinterpret_cast<volatile uint32_t*>(CartRam::AbusSetAddress) = 0x23301FF0;
+                    *reinterpret_cast<volatile uint32_t*>(CartRam::AbusRefreshAddress) = 0x00000013;
+                    *reinterpret_cast<volatile uint16_t*>(CartRam::WriteEnableAddress) = 0x0001;
+                }
+
+                switch (CartRam::cartType)
+                {
+                case CartType::Ram1MB:
+                    CartRam::AddBank(CartRam::RamAddress, 0x80000);
+                    CartRam::AddBank(CartRam::SecondBankAddress, 0x80000);
+                    break;
+
+                case CartType::Ram4MB:
+                    CartRam::AddBank(CartRam::RamAddress, 0x400000);
+                    break;
+
+                default:
+                    CartRam::cartType = CartType::None;
+                    break;
+                }
+            }
+            
+        public:
+
+            /** @brief Gets type of the detected expansion cart
+             * @return Cart type
+             */
+            inline static CartType GetCartType()
+            {
+                return CartRam::cartType;
+            }
+
+            /** @brief Check whether pointer is in range of the memory zone
+             * @param ptr Pointer to check
+             * @return true if pointer belongs to the current memory zone
+             */
+            inline static bool InRange(void* ptr)
+            {
+                return CartRam::GetBank(ptr) != nullptr;
+            }
+
+            /** @brief Check whether pointer is in range of the memory zone
+             * @param zoneAddress Address in the memory zone where object should be allocated
+             * @return true if pointer belongs to the current memory zone
+             */
+            inline static bool InRange(uintptr_t zoneAddress)
+            {
+                return CartRam::GetBank(reinterpret_cast<void*>(zoneAddress)) != nullptr;
+            }
+
+            /** @brief Free allocated memory
+             * @param ptr Pointer to allocated memory
+             */
+            inline static void Free(void* ptr)
+            {
+                Memory::ZoneLock lock;
+
+                const Memory::MemoryZone* bank = CartRam::GetBank(ptr);
+
+                if (bank != nullptr)
+                {
+                    Memory::Telemetry::Trace(Memory::Telemetry::TraceOperation::Free, Memory::Zone::CartRam, ptr, nullptr, 0);
+                    Memory::Telemetry::Untrack(Memory::Zone::CartRam, ptr, Memory::Allocator::GetAllocatedSize(*bank, ptr));
+                    Memory::Allocator::Free(*bank, ptr);
+                }
+            }
+
+            /** @brief Allocate some memory
+             * @param size Number of bytes to allocate
+             * @param tag Allocation category used by telemetry
+             * @return Pointer to the allocated space in memory
+             */
+            inline static void* Malloc(size_t size, const Memory::AllocationTag tag = 0)
+            {
+                Memory::ZoneLock lock;
+
+                for (size_t bank = 0; bank < CartRam::bankCount; bank++)
+                {
+                    void* ptr = Memory::Allocator::Malloc(CartRam::zones[bank], size);
+
+                    if (ptr != nullptr)
+                    {
+                        Memory::Telemetry::Track(Memory::Zone::CartRam, ptr, Memory::Allocator::GetAllocatedSize(CartRam::zones[bank], ptr), tag);
+                        Memory::Telemetry::Trace(Memory::Telemetry::TraceOperation::Malloc, Memory::Zone::CartRam, ptr, nullptr, size);
+                        return ptr;
+                    }
+                }
+
+                Memory::Telemetry::Track(Memory::Zone::CartRam, nullptr, 0, tag);
+                Memory::Telemetry::Trace(Memory::Telemetry::TraceOperation::Malloc, Memory::Zone::CartRam, nullptr, nullptr, size);
+                return nullptr;
+            }
+
+            /** @brief Reallocate existing memory
+             * @note Block can be only moved within the bank it was allocated in
+             * @param ptr Pointer to the existing allocated memory
+             * @param size New size in number of bytes that should be allocated
+             * @return Pointer to the allocated space in memory
+             */
+            inline static void* Realloc(void* ptr, size_t size)
+            {
+                Memory::ZoneLock lock;
+
+                const Memory::MemoryZone* bank = CartRam::GetBank(ptr);
+
+                if (bank != nullptr)
+                {
+                    return Memory::Telemetry::Realloc(*bank, Memory::Zone::CartRam, ptr, size);
+                }
+
+                return nullptr;
+            }
+
+            /** @brief Gets total size of the free space in the memory zone
+             * @return Number of bytes
+             */
+            inline static size_t GetFreeSpace()
+            {
+                Memory::ZoneLock lock;
+
+                size_t size = 0;
+
+                for (size_t bank = 0; bank < CartRam::bankCount; bank++)
+                {
+                    size += Memory::Allocator::GetFreeSize(CartRam::zones[bank]);
+                }
+
+                return size;
+            }
+
+            /** @brief Gets size of the largest block that can be allocated in the memory zone
+             * @return Number of bytes
+             */
+            inline static size_t GetLargestFreeBlock()
+            {
+                Memory::ZoneLock lock;
+
+                size_t largest = 0;
+
+                for (size_t bank = 0; bank < CartRam::bankCount; bank++)
+                {
+                    size_t size = Memory::Allocator::GetLargestFreeBlock(CartRam::zones[bank]);
+                    largest = size > largest ? size : largest;
+                }
+
+                return largest;
+            }
+
+            /** @brief Gets report on the allocator state
+             * @return Current state of the allocator
+             */
+            static const Report GetReport()
+            {
+                Memory::ZoneLock lock;
+
+                auto report = Report { 0, 0, 0, 0, 0 };
+
+                for (size_t bank = 0; bank < CartRam::bankCount; bank++)
+                {
+                    auto bankReport = Memory::Allocator::GetReport(CartRam::zones[bank]);
+                    report.AllocationHeaders += bankReport.AllocationHeaders;
+                    report.FreeBlocks += bankReport.FreeBlocks;
+                    report.FreeSize += bankReport.FreeSize;
+                    report.TotalSize += bankReport.TotalSize;
+                    report.UsedBlocks += bankReport.UsedBlocks;
+                }
+
+                return report;
+            }
+
+            /** @brief Gets total size of the memory zone
+             * @return Number of bytes
+             */
+            inline static size_t GetSize()
+            {
+                size_t size = 0;
+
+                for (size_t bank = 0; bank < CartRam::bankCount; bank++)
+                {
+                    size += CartRam::zones[bank].Size;
+                }
+
+                return size;
+            }
+            
+            /** @brief Gets total size of the used space in the memory zone
+             * @return Number of bytes
+             */
+            inline static size_t GetUsedSpace()
+            {
+                // GetFreeSpace() takes the zone lock, which cannot be taken twice
+                return CartRam::GetSize() - CartRam::GetFreeSpace();
+            }
+        };
+
+        /** @brief Number of allocation size buckets tracked by telemetry
+         */
+        static constexpr size_t SizeBucketCount = 8;
+
+        /** @brief Allocation statistics of a memory zone
+         */
+        struct Statistics
+        {
+            /** @brief Total size of live allocated blocks (without headers)
+             */
+            size_t UsedSize;
+
+            /** @brief Highest UsedSize reached (high-water mark)
+             */
+            size_t PeakUsedSize;
+
+            /** @brief Number of live allocated blocks
+             */
+            size_t Allocations;
+
+            /** @brief Highest number of live allocated blocks
+             */
+            size_t PeakAllocations;
+
+            /** @brief Number of successful allocation and reallocation requests
+             */
+            size_t TotalAllocations;
+
+            /** @brief Number of allocation and reallocation requests that could not be satisfied
+             */
+            size_t FailedAllocations;
+
+            /** @brief Number of live allocated blocks in each size bucket
+             * @details Bucket N holds blocks up to 16 << N bytes, last bucket holds everything larger
+             */
+            size_t SizeBuckets[Memory::SizeBucketCount];
+        };
+
+        /** @brief Allocation statistics of an allocation tag
+         */
+        struct TagStatistics
+        {
+            /** @brief Total size of live allocated blocks (without headers)
+             */
+            size_t UsedSize;
+
+            /** @brief Highest UsedSize reached (high-water mark)
+             */
+            size_t PeakUsedSize;
+
+            /** @brief Number of live allocated blocks
+             */
+            size_t Allocations;
+        };
+
+        /** @brief Memory telemetry
+         * @details Statistics are updated on every allocation and free, so reading them is cheap and can be done every frame.<br/>
+         * Allocations can be given a tag (category ID), usage of each tag is then tracked separately.
+         * Tags are remembered in a fixed size table, its size is set by @c SRL_MEMORY_TAG_SLOTS in the project makefile (power of two).
+         * When the table is not enabled or is full, tagged allocation is counted as untagged.
+         * @code {.cpp}
+         * enum MemoryTags : SRL::Memory::AllocationTag { Untagged, Level, Enemies };
+         *
+         * // Allocate tagged object
+         * Enemy* enemy = new (SRL::Memory::Zone::HWRam, MemoryTags::Enemies) Enemy();
+         *
+         * // Read statistics
+         * size_t peak = SRL::Memory::Telemetry::GetStatistics(SRL::Memory::Zone::HWRam).PeakUsedSize;
+         * size_t enemies = SRL::Memory::Telemetry::GetTagStatistics(MemoryTags::Enemies).UsedSize;
+         * @endcode
+         */
+        class Telemetry
+        {
+        public:
+
+            /** @brief Number of supported allocation tags
+             */
+            static constexpr size_t TagCount = 16;
+
+            /** @brief Number of slots in the table of tagged allocations
+             */
+            static constexpr size_t TagSlots = SRL_MEMORY_TAG_SLOTS;
+
+            /** @brief Traced allocator operation
+             */
+            enum class TraceOperation : uint8_t
+            {
+                /** @brief Block was allocated
+                 */
+                Malloc,
+
+                /** @brief Block was freed
+                 */
+                Free,
+
+                /** @brief Block was reallocated
+                 */
+                Realloc
+            };
+
+            /** @brief Traced allocator call
+             */
+            struct TraceEvent
+            {
+                /** @brief Allocator operation
+                 */
+                TraceOperation Operation;
+
+                /** @brief Memory zone
+                 */
+                Memory::Zone Zone;
+
+                /** @brief Returned block (nullptr if allocation failed), or freed block
+                 */
+                void* Address;
+
+                /** @brief Original block of reallocation
+                 */
+                void* Previous;
+
+                /** @brief Requested number of bytes
+                 */
+                size_t Size;
+            };
+
+            /** @brief Function receiving traced allocator calls
+             * @note Handler is called while allocator is locked, it must not allocate or free memory
+             */
+            using TraceHandler = void (*)(const TraceEvent& event);
+
+        private:
+
+            static_assert((Telemetry::TagSlots & (Telemetry::TagSlots - 1)) == 0, "SRL_MEMORY_TAG_SLOTS must be power of two");
+
+            /** @brief Zones can update statistics
+             */
+            friend class Memory;
+
+            /** @brief Zones can update statistics
+             */
+            friend class HighWorkRam;
+
+            /** @brief Zones can update statistics
+             */
+            friend class LowWorkRam;
+
+            /** @brief Zones can update statistics
+             */
+            friend class CartRam;
+
+            /** @brief Receiver of traced allocator calls
+             */
+            inline static TraceHandler traceHandler = nullptr;
+
+            /** @brief Tagged allocation
+             */
+            struct TagEntry
+            {
+                /** @brief Allocated block (nullptr if slot is empty)
+                 */
+                void* Address;
+
+                /** @brief Allocation tag
+                 */
+                Memory::AllocationTag Tag;
+            };
+
+            /** @brief Statistics of each memory zone
+             */
+            inline static Statistics zones[3];
+
+            /** @brief Statistics of each allocation tag
+             */
+            inline static TagStatistics tags[Telemetry::TagCount];
+
+            /** @brief Open addressing table of tagged allocations
+             */
+            inline static TagEntry tagTable[Telemetry::TagSlots > 0 ? Telemetry::TagSlots : 1];
+
+            /** @brief Number of used slots in tag table
+             */
+            inline static size_t taggedCount = 0;
+
+            /** @brief Get size bucket of an allocation
+             * @param size Block size
+             * @return Bucket index
+             */
+            inline static size_t GetSizeBucket(size_t size)
+            {
+                size_t bucket = std::bit_width((size - 1) >> 4);
+                return bucket < Memory::SizeBucketCount ? bucket : Memory::SizeBucketCount - 1;
+            }
+
+            /** @brief Get home slot of a block in tag table
+             * @param ptr Allocated block
+             * @return Slot index
+             */
+            inline static size_t GetTagSlot(void* ptr)
+            {
+                return ((reinterpret_cast<size_t>(ptr) >> 2) * 2654435761UL) & (Telemetry::TagSlots - 1);
+            }
+
+            /** @brief Remember tag of an allocated block
+             * @param ptr Allocated block
+             * @param tag Allocation tag
+             * @return true if tag was stored
+             */
+            inline static bool SetTag(void* ptr, Memory::AllocationTag tag)
+            {
+                // Keep table at most 3/4 full, so lookups stay short
+                if constexpr (Telemetry::TagSlots > 0)
+                {
+                    if (Telemetry::taggedCount < ((Telemetry::TagSlots * 3) >> 2))
+                    {
+                        size_t slot = Telemetry::GetTagSlot(ptr);
+
+                        while (Telemetry::tagTable[slot].Address != nullptr)
+                        {
+                            slot = (slot + 1) & (Telemetry::TagSlots - 1);
+                        }
+
+                        Telemetry::tagTable[slot] = TagEntry { ptr, tag };
+                        Telemetry::taggedCount++;
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+
+            /** @brief Remove block from tag table
+             * @param ptr Allocated block
+             * @return Tag of the block or 0 if block was not tagged
+             */
+            inline static Memory::AllocationTag TakeTag(void* ptr)
+            {
+                if constexpr (Telemetry::TagSlots > 0)
+                {
+                    if (Telemetry::taggedCount == 0)
+                    {
+                        return 0;
+                    }
+
+                    for (size_t slot = Telemetry::GetTagSlot(ptr);
+                        Telemetry::tagTable[slot].Address != nullptr;
+                        slot = (slot + 1) & (Telemetry::TagSlots - 1))
+                    {
+                        if (Telemetry::tagTable[slot].Address == ptr)
+                        {
+                            Memory::AllocationTag tag = Telemetry::tagTable[slot].Tag;
+
+                            // Shift following entries back, so no entry becomes unreachable from its home slot
+                            size_t hole = slot;
+
+                            for (size_t next = (slot + 1) & (Telemetry::TagSlots - 1);
+                                Telemetry::tagTable[next].Address != nullptr;
+                                next = (next + 1) & (Telemetry::TagSlots - 1))
+                            {
+                                size_t home = Telemetry::GetTagSlot(Telemetry::tagTable[next].Address);
+
+                                if (((next - home) & (Telemetry::TagSlots - 1)) >= ((next - hole) & (Telemetry::TagSlots - 1)))
+                                {
+                                    Telemetry::tagTable[hole] = Telemetry::tagTable[next];
+                                    hole = next;
+                                }
+                            }
+
+                            Telemetry::tagTable[hole].Address = nullptr;
+                            Telemetry::taggedCount--;
+                            return tag;
+                        }
+                    }
+                }
+
+                return 0;
+            }
+
+            /** @brief Record new allocation
+             * @param zone Memory zone
+             * @param ptr Allocated block or nullptr if allocation failed
+             * @param size Block size
+             * @param tag Allocation tag
+             */
+            inline static void Track(const Memory::Zone zone, void* ptr, size_t size, Memory::AllocationTag tag)
+            {
+                Statistics& statistics = Telemetry::zones[zone];
+
+                if (ptr == nullptr)
+                {
+                    statistics.FailedAllocations++;
+                    return;
+                }
+                else if (size == 0)
+                {
+                    return;
+                }
+
+                statistics.UsedSize += size;
+                statistics.PeakUsedSize = statistics.UsedSize > statistics.PeakUsedSize ? statistics.UsedSize : statistics.PeakUsedSize;
+                statistics.Allocations++;
+                statistics.PeakAllocations = statistics.Allocations > statistics.PeakAllocations ? statistics.Allocations : statistics.PeakAllocations;
+                statistics.TotalAllocations++;
+                statistics.SizeBuckets[Telemetry::GetSizeBucket(size)]++;
+
+                if (tag != 0 && tag < Telemetry::TagCount && Telemetry::SetTag(ptr, tag))
+                {
+                    TagStatistics& tagStatistics = Telemetry::tags[tag];
+                    tagStatistics.UsedSize += size;
+                    tagStatistics.PeakUsedSize = tagStatistics.UsedSize > tagStatistics.PeakUsedSize ? tagStatistics.UsedSize : tagStatistics.PeakUsedSize;
+                    tagStatistics.Allocations++;
+                }
+            }
+
+            /** @brief Record block being freed
+             * @param zone Memory zone
+             * @param ptr Allocated block
+             * @param size Block size (0 if pointer is not a live block)
+             * @return Tag of the block
+             */
+            inline static Memory::AllocationTag Untrack(const Memory::Zone zone, void* ptr, size_t size)
+            {
+                if (size == 0)
+                {
+                    return 0;
+                }
+
+                Statistics& statistics = Telemetry::zones[zone];
+                statistics.UsedSize -= size;
+                statistics.Allocations--;
+                statistics.SizeBuckets[Telemetry::GetSizeBucket(size)]--;
+
+                Memory::AllocationTag tag = Telemetry::TakeTag(ptr);
+
+                if (tag != 0)
+                {
+                    Telemetry::tags[tag].UsedSize -= size;
+                    Telemetry::tags[tag].Allocations--;
+                }
+
+                return tag;
+            }
+
+            /** @brief Pass allocator call to trace handler
+             * @param operation Allocator operation
+             * @param code Memory zone
+             * @param ptr Returned or freed block
+             * @param previous Original block of reallocation
+             * @param size Requested number of bytes
+             */
+            inline static void Trace(const TraceOperation operation, const Memory::Zone code, void* ptr, void* previous, size_t size)
+            {
+                if (Telemetry::traceHandler != nullptr)
+                {
+                    Telemetry::traceHandler(TraceEvent { operation, code, ptr, previous, size });
+                }
+            }
+
+            /** @brief Reallocate memory and keep statistics and tag of the block
+             * @param zone Memory zone settings
+             * @param code Memory zone
+             * @param ptr Allocated memory to resize
+             * @param size New size of the allocated block
+             * @return Pointer to resized or moved block
+             */
+            inline static void* Realloc(const MemoryZone& zone, const Memory::Zone code, void* ptr, size_t size)
+            {
+                Memory::AllocationTag tag = Telemetry::Untrack(code, ptr, Memory::Allocator::GetAllocatedSize(zone, ptr));
+                void* result = Memory::Allocator::Realloc(zone, ptr, size);
+
+                if (result == nullptr)
+                {
+                    Telemetry::zones[code].FailedAllocations++;
+
+                    // Original block can still be alive
+                    if (ptr != nullptr)
+                    {
+                        Telemetry::Track(code, ptr, Memory::Allocator::GetAllocatedSize(zone, ptr), tag);
+                    }
+                }
+                else
+                {
+                    Telemetry::Track(code, result, Memory::Allocator::GetAllocatedSize(zone, result), tag);
+                }
+
+                Telemetry::Trace(TraceOperation::Realloc, code, result, ptr, size);
+                return result;
+            }
+
+            /** @brief Clear all statistics
+             */
+            inline static void Reset()
+            {
+                for (Statistics& statistics : Telemetry::zones)
+                {
+                    statistics = Statistics();
+                }
+
+                for (TagStatistics& statistics : Telemetry::tags)
+                {
+                    statistics = TagStatistics();
+                }
+
+                for (TagEntry& entry : Telemetry::tagTable)
+                {
+                    entry.Address = nullptr;
+                }
+
+                Telemetry::taggedCount = 0;
+            }
+
+        public:
+
+            /** @brief Gets allocation statistics of the memory zone
+             * @param zone Memory zone
+             * @return Copy of zone statistics taken while no allocation was in progress
+             */
+            static Statistics GetStatistics(const Memory::Zone zone)
+            {
+                Memory::ZoneLock lock;
+                return Telemetry::zones[zone];
+            }
+
+            /** @brief Gets allocation statistics of the allocation tag
+             * @param tag Allocation tag
+             * @return Copy of tag statistics taken while no allocation was in progress
+             */
+            static TagStatistics GetTagStatistics(const Memory::AllocationTag tag)
+            {
+                Memory::ZoneLock lock;
+                return Telemetry::tags[tag < Telemetry::TagCount ? tag : 0];
+            }
+
+            /** @brief Gets largest upper size limit of a size bucket
+             * @param bucket Bucket index
+             * @return Number of bytes (0 for the last bucket, which has no limit)
+             */
+            static constexpr size_t GetSizeBucketLimit(size_t bucket)
+            {
+                return bucket + 1 < Memory::SizeBucketCount ? 16 << bucket : 0;
+            }
+
+            /** @brief Gets fragmentation of the free space in the memory zone
+             * @details Fragmentation is a part of free space that cannot be allocated in one block
+             * @param zone Memory zone
+             * @return Fragmentation in percent (0 means all free space is in one block)
+             */
+            static uint8_t GetFragmentation(const Memory::Zone zone)
+            {
+                size_t freeSpace = Memory::GetFreeSpace(zone);
+
+                if (freeSpace == 0)
+                {
+                    return 0;
+                }
+
+                // SimpleMalloc counts headers between neighboring free blocks into the largest block, but not into free space
+                size_t largest = Memory::GetLargestFreeBlock(zone);
+                largest = largest < freeSpace ? largest : freeSpace;
+
+                // Divide first for large zones, so the multiplication does not overflow
+                size_t percent = freeSpace > 0x1000000 ? largest / (freeSpace / 100) : (largest * 100) / freeSpace;
+                return 100 - static_cast<uint8_t>(percent < 100 ? percent : 100);
+            }
+
+            /** @brief Sets high-water marks to current values
+             */
+            static void ResetPeaks()
+            {
+                Memory::ZoneLock lock;
+
+                for (Statistics& statistics : Telemetry::zones)
+                {
+                    statistics.PeakUsedSize = statistics.UsedSize;
+                    statistics.PeakAllocations = statistics.Allocations;
+                }
+
+                for (TagStatistics& statistics : Telemetry::tags)
+                {
+                    statistics.PeakUsedSize = statistics.UsedSize;
+                }
+            }
+
+            /** @brief Sets function receiving every allocator call of the memory zones
+             * @details Recorded calls can be replayed by the host memory benchmark (tools/memory_benchmark).
+             * See SRL::Logger::LogMemoryTrace() for a handler writing them into the log.
+             * @param handler Trace handler (nullptr to stop tracing)
+             */
+            static void SetTraceHandler(TraceHandler handler)
+            {
+                Memory::ZoneLock lock;
+                Telemetry::traceHandler = handler;
+            }
+        };
+
+        /** @brief Linear (bump pointer) allocator
+         * @details Memory is taken from a single block by moving a pointer forward. Individual allocations cannot be freed,
+         * all of them are released at once by Reset().<br/>
+         * Arena does not own its block, destructors of objects placed in it are not called.
+         * @code {.cpp}
+         * // Take 16KB from low work RAM and use it as arena
+         * SRL::Memory::Arena arena(SRL::Memory::Malloc(16384, SRL::Memory::Zone::LWRam), 16384);
+         *
+         * // Allocate in arena
+         * Vector3D* points = new (arena) Vector3D[64];
+         *
+         * // Release everything at once
+         * arena.Reset();
+         * @endcode
+         */
+        class Arena
+        {
+        private:
+            /** @brief Arena memory block
+             */
+            uint8_t* buffer;
+
+            /** @brief Size of the memory block
+             */
+            size_t size;
+
+            /** @brief Number of bytes used
+             */
+            size_t used;
+
+            /** @brief Largest number of bytes used since construction
+             */
+            size_t peak;
+
+        public:
+
+            /** @brief Construct empty arena
+             */
+            Arena() : buffer(nullptr), size(0), used(0), peak(0) {}
+
+            /** @brief Construct arena over a memory block
+             * @param buffer Memory block
+             * @param size Size of the memory block in bytes
+             */
+            Arena(void* buffer, size_t size) : buffer(reinterpret_cast<uint8_t*>(buffer)), size(buffer != nullptr ? size : 0), used(0), peak(0) {}
+
+            /** @brief Allocate memory
+             * @param size Number of bytes to allocate
+             * @param alignment Alignment of the returned address (must be power of two)
+             * @return Pointer to allocated space or nullptr if there is not enough space left
+             */
+            void* Malloc(size_t size, size_t alignment = 4)
+            {
+                uintptr_t start = (reinterpret_cast<uintptr_t>(this->buffer) + this->used + alignment - 1) & ~(alignment - 1);
+                uintptr_t end = reinterpret_cast<uintptr_t>(this->buffer) + this->size;
+
+                // Compare against space left, start + size could wrap around
+                if (this->buffer == nullptr || start > end || size > end - start)
+                {
+                    return nullptr;
+                }
+
+                this->used = (start - reinterpret_cast<uintptr_t>(this->buffer)) + size;
+                this->peak = this->used > this->peak ? this->used : this->peak;
+                return reinterpret_cast<void*>(start);
+            }
+
+            /** @brief Release all allocations
+             */
+            void Reset()
+            {
+                this->used = 0;
+            }
+
+            /** @brief Check whether pointer is inside the arena
+             * @param ptr Pointer to check
+             * @return true if pointer belongs to the arena
+             */
+            bool InRange(void* ptr) const
+            {
+                return ptr >= this->buffer && ptr < this->buffer + this->size;
+            }
+
+            /** @brief Gets start of the arena memory block
+             * @return Memory block
+             */
+            void* GetBuffer() const
+            {
+                return this->buffer;
+            }
+
+            /** @brief Gets total size of the arena
+             * @return Number of bytes
+             */
+            size_t GetSize() const
+            {
+                return this->size;
+            }
+
+            /** @brief Gets number of bytes used
+             * @return Number of bytes
+             */
+            size_t GetUsedSpace() const
+            {
+                return this->used;
+            }
+
+            /** @brief Gets number of bytes still available
+             * @return Number of bytes
+             */
+            size_t GetFreeSpace() const
+            {
+                return this->size - this->used;
+            }
+
+            /** @brief Gets largest number of bytes that were used at once
+             * @return Number of bytes
+             */
+            size_t GetPeakUsage() const
+            {
+                return this->peak;
+            }
+        };
+
+        /** @brief Tag used to select per-frame arena in @c new
+         */
+        struct FrameTag { };
+
+        /** @brief Selects per-frame arena in @c new
+         */
+        static constexpr FrameTag Frame = FrameTag();
+
+        /** @brief Per-frame arena
+         * @details Memory allocated here is valid only until the end of the frame, arena is reset in SRL::Core::Synchronize().<br/>
+         * When double buffered, memory allocated in frame N stays valid during frame N+1 as well, so slave CPU can still read it while master builds next frame.<br/>
+         * Arena is created on memory initialization when @c SRL_FRAME_ARENA_SIZE is set in makefile, or manually by calling Initialize().
+         * @code {.cpp}
+         * // Temporary list that is gone after next synchronization
+         * uint16_t* sorted = framenew uint16_t[count];
+         * @endcode
+         */
+        class FrameArena
+        {
+        private:
+
+            /** @brief Memory class needs to be able to see private members to initialize arena
+             */
+            friend class Memory;
+
+            /** @brief Arena buffers
+             */
+            inline static Memory::Arena buffers[2];
+
+            /** @brief Number of buffers in use (0 when arena is not initialized)
+             */
+            inline static uint8_t bufferCount = 0;
+
+            /** @brief Buffer used in current frame
+             */
+            inline static uint8_t current = 0;
+
+            /** @brief Memory block containing all buffers
+             */
+            inline static void* storage = nullptr;
+
+        public:
+
+            /** @brief Create per-frame arena
+             * @note Previous arena is released
+             * @param size Size of a single buffer in bytes
+             * @param zone Memory zone to take arena memory from
+             * @param buffers Number of buffers (1 or 2, 2 makes data live for two frames)
+             * @return true if memory for the arena was allocated
+             */
+            static bool Initialize(size_t size, const Memory::Zone zone = Memory::Zone::HWRam, uint8_t buffers = 1)
+            {
+                FrameArena::Release();
+
+                size = (size + 3) & ~3;
+                buffers = buffers > 1 ? 2 : 1;
+                FrameArena::storage = Memory::Malloc(size * buffers, zone);
+
+                if (FrameArena::storage != nullptr)
+                {
+                    for (uint8_t buffer = 0; buffer < buffers; buffer++)
+                    {
+                        FrameArena::buffers[buffer] = Memory::Arena(reinterpret_cast<uint8_t*>(FrameArena::storage) + (size * buffer), size);
+                    }
+
+                    FrameArena::bufferCount = buffers;
+                    FrameArena::current = 0;
+                    return true;
+                }
+
+                return false;
+            }
+
+            /** @brief Release memory of the per-frame arena
+             */
+            static void Release()
+            {
+                void* block = FrameArena::storage;
+                FrameArena::storage = nullptr;
+                FrameArena::bufferCount = 0;
+                FrameArena::buffers[0] = Memory::Arena();
+                FrameArena::buffers[1] = Memory::Arena();
+                Memory::Free(block);
+            }
+
+            /** @brief Allocate memory for current frame
+             * @param size Number of bytes to allocate
+             * @param alignment Alignment of the returned address (must be power of two)
+             * @return Pointer to allocated space or nullptr if arena is full or not initialized
+             */
+            static void* Malloc(size_t size, size_t alignment = 4)
+            {
+                return FrameArena::buffers[FrameArena::current].Malloc(size, alignment);
+            }
+
+            /** @brief Start new frame
+             * @details Switches to the other buffer when double buffered and releases all its allocations
+             * @note Called from SRL::Core::Synchronize()
+             */
+            static void NextFrame()
+            {
+                if (FrameArena::bufferCount > 1)
+                {
+                    FrameArena::current ^= 1;
+                }
+
+                FrameArena::buffers[FrameArena::current].Reset();
+            }
+
+            /** @brief Check whether pointer is inside any of the arena buffers
+             * @param ptr Pointer to check
+             * @return true if pointer belongs to the arena
+             */
+            static bool InRange(void* ptr)
+            {
+                return FrameArena::buffers[0].InRange(ptr) || FrameArena::buffers[1].InRange(ptr);
+            }
+
+            /** @brief Gets arena buffer used in current frame
+             * @return Arena buffer
+             */
+            static const Memory::Arena& GetCurrent()
+            {
+                return FrameArena::buffers[FrameArena::current];
+            }
+
+            /** @brief Gets number of bytes still available in current frame
+             * @return Number of bytes
+             */
+            static size_t GetFreeSpace()
+            {
+                return FrameArena::buffers[FrameArena::current].GetFreeSpace();
+            }
+
+            /** @brief Gets number of bytes used in current frame
+             * @return Number of bytes
+             */
+            static size_t GetUsedSpace()
+            {
+                return FrameArena::buffers[FrameArena::current].GetUsedSpace();
+            }
+        };
+
+        /** @brief Object pool base
+         * @details Objects live in one contiguous array of slots, free slots are chained into an intrusive list,
+         * so both Acquire() and Release() take constant time. Live slots are tracked in a bitmap used for iteration.
+         * @tparam Type Pooled object type
+         */
+        template<typename Type>
+        class PoolBase
+        {
+        protected:
+
+            /** @brief Storage for a single object, free slot stores link to the next free slot instead
+             */
+            union Slot
+            {
+                /** @brief Object storage
+                 */
+                alignas(Type) uint8_t Data[sizeof(Type)];
+
+                /** @brief Next free slot
+                 */
+                Slot* Next;
+            };
+
+            /** @brief Slot array
+             */
+            Slot* slots;
+
+            /** @brief Bitmap of live slots
+             */
+            uint32_t* liveMap;
+
+            /** @brief Number of slots
+             */
+            size_t capacity;
+
+            /** @brief Number of live objects
+             */
+            size_t count;
+
+            /** @brief First free slot
+             */
+            Slot* freeList;
+
+            /** @brief Construct empty pool
+             */
+            PoolBase() : slots(nullptr), liveMap(nullptr), capacity(0), count(0), freeList(nullptr) {}
+
+            /** @brief Assign storage to the pool and mark all slots as free
+             * @param slots Slot array
+             * @param liveMap Bitmap of live slots (one bit per slot)
+             * @param capacity Number of slots
+             */
+            void Setup(Slot* slots, uint32_t* liveMap, size_t capacity)
+            {
+                this->slots = slots;
+                this->liveMap = liveMap;
+                this->capacity = capacity;
+                this->count = 0;
+                this->freeList = nullptr;
+
+                for (size_t word = 0; word < ((capacity + 31) >> 5); word++)
+                {
+                    this->liveMap[word] = 0;
+                }
+
+                // Chain slots in address order, so objects are handed out front to back
+                for (size_t slot = capacity; slot > 0; slot--)
+                {
+                    this->slots[slot - 1].Next = this->freeList;
+                    this->freeList = &this->slots[slot - 1];
+                }
+            }
+
+            /** @brief Get index of a slot holding object
+             * @param object Pooled object
+             * @return Slot index or capacity if object is not from this pool
+             */
+            size_t GetIndex(const Type* object) const
+            {
+                const Slot* slot = reinterpret_cast<const Slot*>(object);
+
+                if (slot >= this->slots && slot < this->slots + this->capacity)
+                {
+                    size_t index = slot - this->slots;
+
+                    if (reinterpret_cast<const Type*>(&this->slots[index]) == object)
+                    {
+                        return index;
+                    }
+                }
+
+                return this->capacity;
+            }
+
+        public:
+
+            /** @brief Iterator over live objects
+             */
+            class Iterator
+            {
+            private:
+                /** @brief Iterated pool
+                 */
+                PoolBase<Type>* pool;
+
+                /** @brief Current slot index
+                 */
+                size_t index;
+
+                /** @brief Move to the nearest live slot at or after current index
+                 */
+                void SkipFree()
+                {
+                    while (this->index < this->pool->capacity)
+                    {
+                        uint32_t bits = this->pool->liveMap[this->index >> 5] >> (this->index & 31);
+
+                        if (bits != 0)
+                        {
+                            this->index += __builtin_ctzl(bits);
+                            return;
+                        }
+
+                        this->index = (this->index | 31) + 1;
+                    }
+
+                    this->index = this->pool->capacity;
+                }
+
+            public:
+                /** @brief Construct iterator
+                 * @param pool Iterated pool
+                 * @param index Starting slot index
+                 */
+                Iterator(PoolBase<Type>* pool, size_t index) : pool(pool), index(index)
+                {
+                    this->SkipFree();
+                }
+
+                /** @brief Get current object
+                 * @return Pooled object
+                 */
+                Type& operator*() const
                 {
-                    Memory::SimpleMalloc::InitializeZone((void*)address, size),
-                    size
-                };
-                #endif
+                    return *reinterpret_cast<Type*>(&this->pool->slots[this->index]);
+                }
+
+                /** @brief Access current object
+                 * @return Pooled object
+                 */
+                Type* operator->() const
+                {
+                    return reinterpret_cast<Type*>(&this->pool->slots[this->index]);
+                }
+
+                /** @brief Move to the next live object
+                 * @return Iterator
+                 */
+                Iterator& operator++()
+                {
+                    this->index++;
+                    this->SkipFree();
+                    return *this;
+                }
+
+                /** @brief Compare iterators
+                 * @param other Other iterator
+                 * @return true if iterators point to different slot
+                 */
+                bool operator!=(const Iterator& other) const
+                {
+                    return this->index != other.index;
+                }
+            };
+
+            /** @brief Disable copy constructor
+             */
+            PoolBase(const PoolBase&) = delete;
+
+            /** @brief Disable assignment operator
+             */
+            PoolBase& operator=(const PoolBase&) = delete;
+
+            /** @brief Construct new object in a free slot
+             * @param args Constructor arguments
+             * @return Pointer to the new object or nullptr if pool is full
+             */
+            template<typename ...Args>
+            Type* Acquire(Args&&... args)
+            {
+                Slot* slot = this->freeList;
+
+                if (slot != nullptr)
+                {
+                    size_t index = slot - this->slots;
+                    this->freeList = slot->Next;
+                    this->liveMap[index >> 5] |= 1UL << (index & 31);
+                    this->count++;
+                    return new (static_cast<void*>(slot->Data)) Type(static_cast<Args&&>(args)...);
+                }
+
+                return nullptr;
             }
-            
+
+            /** @brief Destroy object and return its slot to the pool
+             * @param object Object acquired from this pool
+             */
+            void Release(Type* object)
+            {
+                size_t index = this->GetIndex(object);
+
+                if (index < this->capacity && (this->liveMap[index >> 5] & (1UL << (index & 31))) != 0)
+                {
+                    object->~Type();
+                    this->liveMap[index >> 5] &= ~(1UL << (index & 31));
+                    this->slots[index].Next = this->freeList;
+                    this->freeList = &this->slots[index];
+                    this->count--;
+                }
+            }
+
+            /** @brief Destroy all live objects
+             */
+            void Clear()
+            {
+                for (auto it = this->begin(); it != this->end(); ++it)
+                {
+                    this->Release(&(*it));
+                }
+            }
+
+            /** @brief Check whether object belongs to this pool and is alive
+             * @param object Object to check
+             * @return true if object is live object of this pool
+             */
+            bool Owns(const Type* object) const
+            {
+                size_t index = this->GetIndex(object);
+                return index < this->capacity && (this->liveMap[index >> 5] & (1UL << (index & 31))) != 0;
+            }
+
+            /** @brief Gets number of live objects
+             * @return Number of objects
+             */
+            size_t GetCount() const
+            {
+                return this->count;
+            }
+
+            /** @brief Gets maximal number of objects
+             * @return Number of slots
+             */
+            size_t GetCapacity() const
+            {
+                return this->capacity;
+            }
+
+            /** @brief Check whether there is no free slot left
+             * @return true if pool is full
+             */
+            bool IsFull() const
+            {
+                return this->freeList == nullptr;
+            }
+
+            /** @brief Get iterator pointing to the first live object
+             * @return Iterator
+             */
+            Iterator begin()
+            {
+                return Iterator(this, 0);
+            }
+
+            /** @brief Get iterator pointing past the last live object
+             * @return Iterator
+             */
+            Iterator end()
+            {
+                return Iterator(this, this->capacity);
+            }
+        };
+
+        /** @brief Fixed size object pool
+         * @details Storage is part of the pool object, so pool placed in a memory zone keeps its objects there as well.
+         * @code {.cpp}
+         * // Up to 128 bullets
+         * SRL::Memory::Pool<Bullet, 128> bullets;
+         *
+         * // Spawn
+         * Bullet* bullet = bullets.Acquire(position, velocity);
+         *
+         * // Update all live bullets
+         * for (Bullet& bullet : bullets)
+         * {
+         *      bullet.Update();
+         * }
+         *
+         * // Despawn
+         * bullets.Release(bullet);
+         * @endcode
+         * @tparam Type Pooled object type
+         * @tparam Capacity Maximal number of objects
+         */
+        template<typename Type, size_t Capacity>
+        class Pool : public PoolBase<Type>
+        {
+        private:
+            /** @brief Slot array
+             */
+            typename PoolBase<Type>::Slot storage[Capacity];
+
+            /** @brief Bitmap of live slots
+             */
+            uint32_t live[(Capacity + 31) >> 5];
+
         public:
+            /** @brief Construct empty pool
+             */
+            Pool()
+            {
+                this->Setup(this->storage, this->live, Capacity);
+            }
 
-            /** @brief Check whether pointer is in range of the memory zone
-             * @param ptr Pointer to check
-             * @return true if pointer belongs to the current memory zone
+            /** @brief Destroy pool and all its live objects
              */
-            inline static bool InRange(void* ptr)
+            ~Pool()
             {
-                return Memory::InZone(LowWorkRam::zone, ptr);
+                this->Clear();
             }
+        };
 
-            /** @brief Check whether pointer is in range of the memory zone
-             * @param zoneAddress Zone address to check
-             * @return true if pointer belongs to the current memory zone
+        /** @brief Object pool with capacity set at runtime
+         * @details Storage is allocated from specified memory zone.
+         * @code {.cpp}
+         * // Particles are kept in low work RAM
+         * SRL::Memory::DynamicPool<Particle> particles(512, SRL::Memory::Zone::LWRam);
+         * @endcode
+         * @tparam Type Pooled object type
+         */
+        template<typename Type>
+        class DynamicPool : public PoolBase<Type>
+        {
+        private:
+            /** @brief Allocated storage
+             */
+            void* storage;
+
+        public:
+            /** @brief Construct empty pool
+             * @param capacity Maximal number of objects
+             * @param zone Memory zone to allocate storage in
              */
-            inline static bool InRange(uint32_t zoneAddress)
+            DynamicPool(size_t capacity, const Memory::Zone zone = Memory::Zone::HWRam)
             {
-                return Memory::InZone(LowWorkRam::zone, (void*)zoneAddress);
+                size_t slotsSize = capacity * sizeof(typename PoolBase<Type>::Slot);
+                this->storage = Memory::Malloc(slotsSize + (((capacity + 31) >> 5) * sizeof(uint32_t)), zone);
+
+                if (this->storage != nullptr)
+                {
+                    this->Setup(
+                        reinterpret_cast<typename PoolBase<Type>::Slot*>(this->storage),
+                        reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(this->storage) + slotsSize),
+                        capacity);
+                }
             }
 
-            /** @brief Free allocated memory
-             * @param ptr Pointer to allocated memory
+            /** @brief Destroy pool, all its live objects and release storage
              */
-            inline static void Free(void* ptr)
+            ~DynamicPool()
             {
-                #if defined(USE_TLSF_ALLOCATOR)
-                tlsf_free(LowWorkRam::Zone.Address, ptr);
-                #else
-                Memory::SimpleMalloc::Free(LowWorkRam::zone, ptr);
-                #endif
+                this->Clear();
+                Memory::Free(this->storage);
             }
+        };
 
-            /** @brief Allocate some memory
+        /** @brief Compacting heap of movable blocks
+         * @details Blocks are accessed through handles instead of pointers, so the heap can slide them together and merge
+         * fragmented free space into one block. Compaction is done incrementally by Compact(), which can be called every frame
+         * with a time budget. Blocks are moved by Memory::Copy(), so large blocks are moved by DMA.<br/>
+         * Pointer returned by Get() is valid only until next Compact() or Malloc() call. Pinned blocks are never moved.
+         * @code {.cpp}
+         * // 256KB of low work RAM for decompressed assets
+         * SRL::Memory::MovableHeap assets(256 * 1024, 64);
+         *
+         * SRL::Memory::MovableHeap::Handle tiles = assets.Malloc(32768);
+         *
+         * // Block cannot move while it is in use
+         * uint8_t* data = reinterpret_cast<uint8_t*>(assets.Pin(tiles));
+         * Decompress(data);
+         * assets.Unpin(tiles);
+         *
+         * // Spend at most 500 microseconds per frame moving blocks
+         * assets.Compact(500);
+         * @endcode
+         */
+        class MovableHeap
+        {
+        public:
+            /** @brief Handle of a movable block
+             */
+            using Handle = uint16_t;
+
+            /** @brief Handle that does not point to any block
+             */
+            static constexpr Handle InvalidHandle = 0;
+
+        private:
+            /** @brief Header of a block in the heap
+             */
+            struct BlockHeader
+            {
+                /** @brief Size of the block including header
+                 */
+                size_t Size;
+
+                /** @brief Handle that owns the block (InvalidHandle if block is free)
+                 */
+                Handle Owner;
+            };
+
+            /** @brief Entry of the handle table
+             */
+            struct HandleEntry
+            {
+                /** @brief Block of the handle (nullptr if handle is not used)
+                 */
+                BlockHeader* Block;
+
+                /** @brief Number of active pins
+                 */
+                uint16_t Pins;
+
+                /** @brief Next unused handle (InvalidHandle terminates the list)
+                 */
+                Handle NextFree;
+            };
+
+            /** @brief Smallest block that is split off as free space
+             */
+            static constexpr size_t MinimalBlock = sizeof(BlockHeader) + 4;
+
+            /** @brief Allocated storage (handle table followed by blocks)
+             */
+            void* storage;
+
+            /** @brief Handle table
+             */
+            HandleEntry* handles;
+
+            /** @brief First block of the heap
+             */
+            BlockHeader* first;
+
+            /** @brief End of the last block of the heap
+             */
+            BlockHeader* end;
+
+            /** @brief First unused handle
+             */
+            Handle freeHandles;
+
+            /** @brief Number of allocated blocks
+             */
+            size_t count;
+
+            /** @brief Get block that follows specified block
+             * @param block Block in the heap
+             * @return Next block or end of the heap
+             */
+            inline static BlockHeader* GetNext(BlockHeader* block)
+            {
+                return reinterpret_cast<BlockHeader*>(reinterpret_cast<uint8_t*>(block) + block->Size);
+            }
+
+            /** @brief Merge all free blocks that follow specified free block into it
+             * @param block Free block
+             */
+            void MergeFree(BlockHeader* block)
+            {
+                BlockHeader* next = MovableHeap::GetNext(block);
+
+                while (next != this->end && next->Owner == MovableHeap::InvalidHandle)
+                {
+                    block->Size += next->Size;
+                    next = MovableHeap::GetNext(block);
+                }
+            }
+
+            /** @brief Find free block large enough and take it
+             * @param size Size of the block including header
+             * @param owner Handle that will own the block
+             * @return Allocated block or nullptr if there is no large enough free block
+             */
+            BlockHeader* TakeFree(size_t size, Handle owner)
+            {
+                for (BlockHeader* block = this->first; block != this->end; block = MovableHeap::GetNext(block))
+                {
+                    if (block->Owner != MovableHeap::InvalidHandle)
+                    {
+                        continue;
+                    }
+
+                    this->MergeFree(block);
+
+                    if (block->Size >= size)
+                    {
+                        if (block->Size - size >= MovableHeap::MinimalBlock)
+                        {
+                            BlockHeader* rest = reinterpret_cast<BlockHeader*>(reinterpret_cast<uint8_t*>(block) + size);
+                            rest->Size = block->Size - size;
+                            rest->Owner = MovableHeap::InvalidHandle;
+                            block->Size = size;
+                        }
+
+                        block->Owner = owner;
+                        return block;
+                    }
+                }
+
+                return nullptr;
+            }
+
+            /** @brief Move allocated blocks towards start of the heap
+             * @param ticks Number of timer ticks moving can take
+             * @param limited Stop moving blocks once time runs out, otherwise all blocks are moved
+             * @return true if there is nothing left to move
+             */
+            bool CompactBlocks(const uint16_t ticks, const bool limited)
+            {
+                const uint16_t start = TIM_FRT_GET_16();
+                bool moved = false;
+                BlockHeader* block = this->first;
+
+                while (block != this->end)
+                {
+                    if (block->Owner != MovableHeap::InvalidHandle)
+                    {
+                        block = MovableHeap::GetNext(block);
+                        continue;
+                    }
+
+                    this->MergeFree(block);
+                    BlockHeader* next = MovableHeap::GetNext(block);
+
+                    if (next == this->end)
+                    {
+                        break;
+                    }
+
+                    if (this->handles[next->Owner - 1].Pins > 0)
+                    {
+                        // Pinned block stays, try the free space after it
+                        block = MovableHeap::GetNext(next);
+                        continue;
+                    }
+
+                    if (moved && limited && static_cast<uint16_t>(TIM_FRT_GET_16() - start) >= ticks)
+                    {
+                        return false;
+                    }
+
+                    moved = true;
+                    block = this->Slide(block, next);
+                }
+
+                return true;
+            }
+
+            /** @brief Slide block down into free block in front of it
+             * @details Copy is done in chunks not larger than the free block, so source and destination never overlap
+             * @param hole Free block
+             * @param block Allocated block right after the free block
+             * @return Free block that is now behind the moved block
+             */
+            BlockHeader* Slide(BlockHeader* hole, BlockHeader* block)
+            {
+                size_t distance = hole->Size;
+                size_t remaining = block->Size;
+                uint8_t* destination = reinterpret_cast<uint8_t*>(hole);
+
+                while (remaining > 0)
+                {
+                    size_t chunk = remaining < distance ? remaining : distance;
+                    Memory::Copy(destination, destination + distance, chunk);
+                    destination += chunk;
+                    remaining -= chunk;
+                }
+
+                BlockHeader* moved = hole;
+                this->handles[moved->Owner - 1].Block = moved;
+
+                BlockHeader* freed = MovableHeap::GetNext(moved);
+                freed->Size = distance;
+                freed->Owner = MovableHeap::InvalidHandle;
+                this->MergeFree(freed);
+                return freed;
+            }
+
+        public:
+            /** @brief Construct empty heap
+             * @param size Number of bytes available for blocks and their headers
+             * @param handleCount Maximal number of allocated blocks
+             * @param zone Memory zone to allocate heap in
+             */
+            MovableHeap(size_t size, size_t handleCount, const Memory::Zone zone = Memory::Zone::LWRam) : count(0)
+            {
+                size = size & ~3;
+                handleCount = handleCount < 0xFFFF ? handleCount : 0xFFFE;
+                size_t tableSize = ((handleCount * sizeof(HandleEntry)) + 3) & ~3;
+                this->storage = Memory::Malloc(tableSize + size, zone);
+
+                if (this->storage == nullptr || size < MovableHeap::MinimalBlock)
+                {
+                    this->handles = nullptr;
+                    this->first = nullptr;
+                    this->end = nullptr;
+                    this->freeHandles = MovableHeap::InvalidHandle;
+                    return;
+                }
+
+                this->handles = reinterpret_cast<HandleEntry*>(this->storage);
+                this->first = reinterpret_cast<BlockHeader*>(reinterpret_cast<uint8_t*>(this->storage) + tableSize);
+                this->end = reinterpret_cast<BlockHeader*>(reinterpret_cast<uint8_t*>(this->first) + size);
+                this->first->Size = size;
+                this->first->Owner = MovableHeap::InvalidHandle;
+
+                for (size_t handle = 0; handle < handleCount; handle++)
+                {
+                    this->handles[handle].Block = nullptr;
+                    this->handles[handle].Pins = 0;
+                    this->handles[handle].NextFree = handle + 1 < handleCount ? handle + 2 : MovableHeap::InvalidHandle;
+                }
+
+                this->freeHandles = handleCount > 0 ? 1 : MovableHeap::InvalidHandle;
+            }
+
+            /** @brief Destroy heap and release its storage
+             */
+            ~MovableHeap()
+            {
+                Memory::Free(this->storage);
+            }
+
+            MovableHeap(const MovableHeap&) = delete;
+            MovableHeap& operator=(const MovableHeap&) = delete;
+
+            /** @brief Allocate movable block
+             * @note If free space is too fragmented, whole heap is compacted first, which can take a while
              * @param size Number of bytes to allocate
-             * @return Pointer to the allocated space in memory
+             * @return Handle of the block or InvalidHandle if there is not enough space or handles
+             */
+            Handle Malloc(size_t size)
+            {
+                Handle handle = this->freeHandles;
+
+                if (handle == MovableHeap::InvalidHandle)
+                {
+                    return MovableHeap::InvalidHandle;
+                }
+
+                size = sizeof(BlockHeader) + ((size + 3) & ~3);
+                size = size > MovableHeap::MinimalBlock ? size : MovableHeap::MinimalBlock;
+                BlockHeader* block = this->TakeFree(size, handle);
+
+                if (block == nullptr && this->GetFreeSpace() >= size)
+                {
+                    this->CompactBlocks(0, false);
+                    block = this->TakeFree(size, handle);
+                }
+
+                if (block == nullptr)
+                {
+                    return MovableHeap::InvalidHandle;
+                }
+
+                HandleEntry& entry = this->handles[handle - 1];
+                this->freeHandles = entry.NextFree;
+                entry.Block = block;
+                entry.Pins = 0;
+                this->count++;
+                return handle;
+            }
+
+            /** @brief Free movable block
+             * @param handle Handle of the block
+             */
+            void Free(Handle handle)
+            {
+                if (!this->IsValid(handle))
+                {
+                    return;
+                }
+
+                HandleEntry& entry = this->handles[handle - 1];
+                entry.Block->Owner = MovableHeap::InvalidHandle;
+                this->MergeFree(entry.Block);
+                entry.Block = nullptr;
+                entry.Pins = 0;
+                entry.NextFree = this->freeHandles;
+                this->freeHandles = handle;
+                this->count--;
+            }
+
+            /** @brief Move allocated blocks towards start of the heap
+             * @details Blocks are moved one by one until the time budget runs out, time is measured by the free running timer
+             * like in SRL::AssetLoader. Next block is not moved when the budget is already spent, but at least one block
+             * is moved on each call, so a block taking longer than the budget to move still gets compacted.
+             * @note Timer is 16 bit, longer budgets are cut to what it can measure
+             * @param microseconds Time budget in microseconds
+             * @return true if there is nothing left to move
+             */
+            bool Compact(uint32_t microseconds)
+            {
+                const uint32_t ticks = static_cast<uint32_t>(TIM_FRT_MCR_TO_CNT(microseconds));
+                return this->CompactBlocks(static_cast<uint16_t>(ticks < 0xffff ? ticks : 0xffff), true);
+            }
+
+            /** @brief Check whether handle points to an allocated block
+             * @param handle Handle of the block
+             * @return true if block is allocated
+             */
+            bool IsValid(Handle handle) const
+            {
+                return handle != MovableHeap::InvalidHandle && this->handles != nullptr && this->handles[handle - 1].Block != nullptr;
+            }
+
+            /** @brief Get current address of the block
+             * @param handle Handle of the block
+             * @return Pointer to the block data, valid until next Compact() or Malloc() call
+             */
+            void* Get(Handle handle) const
+            {
+                return this->IsValid(handle) ? reinterpret_cast<void*>(this->handles[handle - 1].Block + 1) : nullptr;
+            }
+
+            /** @brief Prevent block from being moved
+             * @details Pins are counted, block is movable again after the same number of Unpin() calls
+             * @param handle Handle of the block
+             * @return Pointer to the block data, valid until the block is unpinned
              */
-            inline static void* Malloc(size_t size)
+            void* Pin(Handle handle)
             {
-                #if defined(USE_TLSF_ALLOCATOR)
-                return tlsf_malloc(LowWorkRam::Zone.Address, size);
-                #else
-                return Memory::SimpleMalloc::Malloc(LowWorkRam::zone, size);
-                #endif
+                if (!this->IsValid(handle))
+                {
+                    return nullptr;
+                }
+
+                this->handles[handle - 1].Pins++;
+                return reinterpret_cast<void*>(this->handles[handle - 1].Block + 1);
             }
 
-           /** @brief Reallocate existing memory
-            * @param ptr Pointer to the existing allocated memory
-            * @param size New size in number of bytes that should be allocated
-            * @return Pointer to the allocated space in memory
-            */
-            inline static void* Realloc(void* ptr, size_t size)
+            /** @brief Allow block to be moved again
+             * @param handle Handle of the block
+             */
+            void Unpin(Handle handle)
             {
-                #if defined(USE_TLSF_ALLOCATOR)
-                return tlsf_realloc(LowWorkRam::Zone.Address, ptr, size);
-                #else
-                return Memory::SimpleMalloc::Realloc(LowWorkRam::zone, ptr, size);
-                #endif
+                if (this->IsValid(handle) && this->handles[handle - 1].Pins > 0)
+                {
+                    this->handles[handle - 1].Pins--;
+                }
             }
 
-            /** @brief Gets total size of the free space in the memory zone
-             * @return Number of bytes
+            /** @brief Gets size of the block
+             * @param handle Handle of the block
+             * @return Number of usable bytes
              */
-            static size_t GetFreeSpace()
+            size_t GetSize(Handle handle) const
             {
-                #if defined(USE_TLSF_ALLOCATOR)
-                return 0;
-                #else
-                return Memory::SimpleMalloc::GetReport(LowWorkRam::zone).FreeSize;
-                #endif
+                return this->IsValid(handle) ? this->handles[handle - 1].Block->Size - sizeof(BlockHeader) : 0;
             }
 
-            /** @brief Gets report on the allocator state
-             * @return Current state of the allocator
+            /** @brief Gets number of allocated blocks
+             * @return Number of blocks
              */
-            static const Report GetReport()
+            size_t GetCount() const
             {
-                #if defined(USE_TLSF_ALLOCATOR)
-                return Report { 0, 0, 0, LowWorkRam::Zone.Size, 0};
-                #else
-                return Memory::SimpleMalloc::GetReport(LowWorkRam::zone);
-                #endif
+                return this->count;
             }
 
-            /** @brief Gets total size of the memory zone
+            /** @brief Gets total size of the free space including headers of free blocks
              * @return Number of bytes
              */
-            inline static size_t GetSize()
+            size_t GetFreeSpace() const
             {
-                return LowWorkRam::zone.Size;
+                size_t size = 0;
+
+                for (BlockHeader* block = this->first; block != this->end; block = MovableHeap::GetNext(block))
+                {
+                    size += block->Owner == MovableHeap::InvalidHandle ? block->Size : 0;
+                }
+
+                return size;
             }
-            
-            /** @brief Gets total size of the used space in the memory zone
+
+            /** @brief Gets size of the largest block that can be allocated without compaction
              * @return Number of bytes
              */
-            static size_t GetUsedSpace()
+            size_t GetLargestFreeBlock() const
             {
-                #if defined(USE_TLSF_ALLOCATOR)
-                return 0;
-                #else
-                auto report = Memory::SimpleMalloc::GetReport(LowWorkRam::zone);
-                return report.TotalSize - report.FreeSize;
-                #endif
+                size_t largest = 0;
+                size_t run = 0;
+
+                for (BlockHeader* block = this->first; block != this->end; block = MovableHeap::GetNext(block))
+                {
+                    run = block->Owner == MovableHeap::InvalidHandle ? run + block->Size : 0;
+                    largest = run > largest ? run : largest;
+                }
+
+                return largest > sizeof(BlockHeader) ? largest - sizeof(BlockHeader) : 0;
             }
         };
 
-        /** @brief Malloc for expansion cart RAM
+        /** @brief Smallest number of bytes that is transferred by DMA instead of CPU
          */
-        class CartRam
+        static constexpr size_t DmaThreshold = 512;
+
+        /** @brief Handle of asynchronous memory transfer
+         * @details Only one DMA transfer runs at a time, starting a new one waits for the previous one to finish.
+         * DMA is used only on the master CPU, slave CPU copies by CPU and always gets a completed transfer.
+         * Transfer should be waited on by the CPU that started it, only its cache is purged.
+         * @code {.cpp}
+         * // Start upload and do something else in the meantime
+         * SRL::Memory::Transfer transfer = SRL::Memory::CopyAsync(destination, source, size);
+         * UpdateLogic();
+         *
+         * // Make sure data are there
+         * transfer.Wait();
+         * @endcode
+         */
+        class Transfer
         {
         private:
-
-            /** @brief Memory class needs to be able to see private members to initialize zones
+            /** @brief Memory class needs to be able to create transfers
              */
             friend class Memory;
 
-            /** @brief Memory zone
+            /** @brief Transfer identifier (0 if transfer was done by CPU)
              */
-            inline static Memory::MemoryZone zone;
+            uint32_t id;
 
-            /** @brief Initialize memory zone
+            /** @brief Transfer destination
              */
-            inline static void Initialize()
-            {
-                // TODO: Implement
-            }
-            
+            void* destination;
+
+            /** @brief Construct transfer handle
+             * @param id Transfer identifier
+             * @param destination Transfer destination
+             */
+            Transfer(uint32_t id, void* destination) : id(id), destination(destination) {}
+
         public:
 
-            /** @brief Check whether pointer is in range of the memory zone
-             * @param ptr Pointer to check
-             * @return true if pointer belongs to the current memory zone
+            /** @brief Construct handle of already completed transfer
              */
-            inline static bool InRange(void* ptr)
+            Transfer() : id(0), destination(nullptr) {}
+
+            /** @brief Check whether transfer has finished
+             * @return true if all data were transferred
+             */
+            bool IsComplete() const
             {
-                return CartRam::InRange(reinterpret_cast<uint32_t>(ptr));
+                return this->id == 0 || this->id != Memory::lastTransfer || !slDMAStatus();
             }
 
-            /** @brief Check whether pointer is in range of the memory zone
-             * @param zoneAddress Address in the memory zone where object should be allocated
-             * @return true if pointer belongs to the current memory zone
+            /** @brief Wait until transfer finishes
+             * @note Cache is purged if destination is in cached memory, so CPU does not read stale data
              */
-            inline static bool InRange(uint32_t zoneAddress)
+            void Wait() const
             {
-                return false;
+                if (this->id != 0)
+                {
+                    if (!this->IsComplete())
+                    {
+                        slDMAWait();
+                    }
+
+                    if (Memory::IsCached(this->destination))
+                    {
+                        slCashPurge();
+                    }
+                }
             }
+        };
 
-            /** @brief Free allocated memory
-             * @param ptr Pointer to allocated memory
-             */
-            inline static void Free(void* ptr)
+    private:
+
+        /** @brief Identifier of the last started DMA transfer
+         * @note Written only by the master CPU
+         */
+        inline static uint32_t lastTransfer = 0;
+
+        /** @brief Fill pattern used by DMA, must stay valid while transfer runs
+         * @note Written only by the master CPU
+         */
+        inline static uint32_t fillPattern = 0;
+
+        /** @brief Check whether DMA can be used by the current CPU
+         * @details Each CPU has its own DMA controller, but transfer state above is shared, so only the master CPU uses DMA
+         * @return true if running on the master CPU
+         */
+        inline static bool CanUseDma()
+        {
+            return ZoneLock::GetCpu() == 0;
+        }
+
+        /** @brief Check whether address is accessed through CPU cache
+         * @param address Address to check
+         * @return true if address is in cached area
+         */
+        inline static bool IsCached(const void* address)
+        {
+            return (reinterpret_cast<uintptr_t>(address) & 0xF0000000) == 0;
+        }
+
+        /** @brief Copy memory by CPU
+         * @details Uses widest access both pointers allow, main loop is unrolled
+         * @param destination Destination address
+         * @param source Source address
+         * @param length Number of bytes to copy
+         */
+        inline static void CopyCpu(void* destination, const void* source, size_t length)
+        {
+            uint8_t* to = reinterpret_cast<uint8_t*>(destination);
+            const uint8_t* from = reinterpret_cast<const uint8_t*>(source);
+            uintptr_t alignment = reinterpret_cast<uintptr_t>(to) ^ reinterpret_cast<uintptr_t>(from);
+
+            if ((alignment & 3) == 0)
+            {
+                for (; (reinterpret_cast<uintptr_t>(to) & 3) != 0 && length > 0; length--)
+                {
+                    *to++ = *from++;
+                }
+
+                uint32_t* to32 = reinterpret_cast<uint32_t*>(to);
+                const uint32_t* from32 = reinterpret_cast<const uint32_t*>(from);
+
+                for (; length >= 32; length -= 32)
+                {
+                    uint32_t a = from32[0], b = from32[1], c = from32[2], d = from32[3];
+                    uint32_t e = from32[4], f = from32[5], g = from32[6], h = from32[7];
+                    to32[0] = a; to32[1] = b; to32[2] = c; to32[3] = d;
+                    to32[4] = e; to32[5] = f; to32[6] = g; to32[7] = h;
+                    to32 += 8;
+                    from32 += 8;
+                }
+
+                for (; length >= 4; length -= 4)
+                {
+                    *to32++ = *from32++;
+                }
+
+                to = reinterpret_cast<uint8_t*>(to32);
+                from = reinterpret_cast<const uint8_t*>(from32);
+            }
+            else if ((alignment & 1) == 0)
             {
-                // TODO implement
+                if ((reinterpret_cast<uintptr_t>(to) & 1) != 0 && length > 0)
+                {
+                    *to++ = *from++;
+                    length--;
+                }
+
+                uint16_t* to16 = reinterpret_cast<uint16_t*>(to);
+                const uint16_t* from16 = reinterpret_cast<const uint16_t*>(from);
+
+                for (; length >= 2; length -= 2)
+                {
+                    *to16++ = *from16++;
+                }
+
+                to = reinterpret_cast<uint8_t*>(to16);
+                from = reinterpret_cast<const uint8_t*>(from16);
             }
 
-            /** @brief Allocate some memory
-             * @param size Number of bytes to allocate
-             * @return Pointer to the allocated space in memory
-             */
-            inline static void* Malloc(size_t size)
+            for (; length > 0; length--)
             {
-                return nullptr;
+                *to++ = *from++;
             }
+        }
 
-            /** @brief Reallocate existing memory
-             * @param ptr Pointer to the existing allocated memory
-             * @param size New size in number of bytes that should be allocated
-             * @return Pointer to the allocated space in memory
-             */
-            inline static void* Realloc(void* ptr, size_t size)
+        /** @brief Fill memory by CPU
+         * @details Main loop writes 32 bytes at a time
+         * @param destination Destination address
+         * @param value Value to fill with
+         * @param length Number of bytes to fill
+         */
+        inline static void FillCpu(void* destination, const uint8_t value, size_t length)
+        {
+            uint8_t* to = reinterpret_cast<uint8_t*>(destination);
+
+            for (; (reinterpret_cast<uintptr_t>(to) & 3) != 0 && length > 0; length--)
             {
-                return nullptr;
+                *to++ = value;
             }
 
-            /** @brief Gets total size of the free space in the memory zone
-             * @return Number of bytes
-             */
-            inline static size_t GetFreeSpace()
+            uint32_t pattern = value * 0x01010101UL;
+            uint32_t* to32 = reinterpret_cast<uint32_t*>(to);
+
+            for (; length >= 32; length -= 32)
             {
-                return 0;
+                to32[0] = pattern; to32[1] = pattern; to32[2] = pattern; to32[3] = pattern;
+                to32[4] = pattern; to32[5] = pattern; to32[6] = pattern; to32[7] = pattern;
+                to32 += 8;
             }
 
-            /** @brief Gets report on the allocator state
-             * @return Current state of the allocator
-             */
-            static const Report GetReport()
+            for (; length >= 4; length -= 4)
             {
-                #if defined(USE_TLSF_ALLOCATOR)
-                return Report { 0, 0, 0, 0, 0};
-                #else
-                return Report { 0, 0, 0, 0, 0};
-                #endif
+                *to32++ = pattern;
             }
 
-            /** @brief Gets total size of the memory zone
-             * @return Number of bytes
-             */
-            inline static size_t GetSize()
+            to = reinterpret_cast<uint8_t*>(to32);
+
+            for (; length > 0; length--)
             {
-                return 0;
+                *to++ = value;
             }
-            
-            /** @brief Gets total size of the used space in the memory zone
-             * @return Number of bytes
-             */
-            inline static size_t GetUsedSpace()
+        }
+
+        /** @brief Get handle of DMA transfer that was just started
+         * @param destination Transfer destination
+         * @return Transfer handle
+         */
+        inline static Transfer StartTransfer(void* destination)
+        {
+            // Identifier 0 is reserved for transfers done by CPU
+            if (++Memory::lastTransfer == 0)
             {
-                return 0;
+                Memory::lastTransfer = 1;
             }
-        };
 
-        /** @brief Det memory to some value
+            return Transfer(Memory::lastTransfer, destination);
+        }
+
+        /** @brief Get number of bytes before address gets 4 byte aligned
+         * @param address Address
+         * @return Number of bytes
+         */
+        inline static size_t GetMisalignment(const void* address)
+        {
+            return (4 - (reinterpret_cast<uintptr_t>(address) & 3)) & 3;
+        }
+
+    public:
+
+        /** @brief Copy memory
+         * @details Small or misaligned blocks are copied by CPU, large blocks by DMA on the master CPU.
+         * @param destination Destination address
+         * @param source Source address
+         * @param length Number of bytes to copy
+         * @return Handle of the DMA transfer
+         */
+        inline static Transfer CopyAsync(void* destination, const void* source, size_t length)
+        {
+            size_t head = Memory::GetMisalignment(destination);
+
+            if (length < Memory::DmaThreshold + head || Memory::GetMisalignment(source) != head || !Memory::CanUseDma())
+            {
+                Memory::CopyCpu(destination, source, length);
+                return Transfer();
+            }
+
+            // Bytes before and after aligned part are copied by CPU
+            size_t body = (length - head) & ~static_cast<size_t>(3);
+            uint8_t* to = reinterpret_cast<uint8_t*>(destination);
+            const uint8_t* from = reinterpret_cast<const uint8_t*>(source);
+            Memory::CopyCpu(to, from, head);
+            Memory::CopyCpu(to + head + body, from + head + body, length - head - body);
+
+            slDMAWait();
+            slDMACopy(const_cast<uint8_t*>(from + head), to + head, body);
+            return Memory::StartTransfer(destination);
+        }
+
+        /** @brief Fill memory with a value
+         * @details Small blocks are filled by CPU, large blocks by DMA on the master CPU.
+         * @param destination Destination address
+         * @param value Value to fill with
+         * @param length Number of bytes to fill
+         * @return Handle of the DMA transfer
+         */
+        inline static Transfer FillAsync(void* destination, const uint8_t value, size_t length)
+        {
+            size_t head = Memory::GetMisalignment(destination);
+
+            if (length < Memory::DmaThreshold + head || !Memory::CanUseDma())
+            {
+                Memory::FillCpu(destination, value, length);
+                return Transfer();
+            }
+
+            // Bytes before and after aligned part are filled by CPU
+            size_t body = (length - head) & ~static_cast<size_t>(3);
+            uint8_t* to = reinterpret_cast<uint8_t*>(destination);
+            Memory::FillCpu(to, value, head);
+            Memory::FillCpu(to + head + body, value, length - head - body);
+
+            // DMA reads the same source word over and over
+            slDMAWait();
+            Memory::fillPattern = value * 0x01010101UL;
+            slDMAXCopy(&Memory::fillPattern, to + head, body >> 2, Sfix_Dinc_Long);
+            return Memory::StartTransfer(destination);
+        }
+
+        /** @brief Copy memory
+         * @details Small or misaligned blocks are copied by CPU, large blocks by DMA.
+         * @param destination Destination address
+         * @param source Source address
+         * @param length Number of bytes to copy
+         */
+        inline static void Copy(void* destination, const void* source, size_t length)
+        {
+            Memory::CopyAsync(destination, source, length).Wait();
+        }
+
+        /** @brief Fill memory with a value
+         * @details Small blocks are filled by CPU, large blocks by DMA.
+         * @param destination Destination address
+         * @param value Value to fill with
+         * @param length Number of bytes to fill
+         */
+        inline static void Fill(void* destination, const uint8_t value, size_t length)
+        {
+            Memory::FillAsync(destination, value, length).Wait();
+        }
+
+        /** @brief Set memory to some value
          * @param destination Destination to set
          * @param value Value to set
          * @param length Data length to set
          */
         inline static void MemSet(void* destination, const uint8_t value, const size_t length)
         {
-            for (size_t i = 0; i < length; i++)
-            {
-                *(((uint8_t*)destination) + i) = value;
-            }
+            Memory::Fill(destination, value, length);
         }
 
         /** @brief Initialize memory
@@ -792,12 +3871,22 @@ namespace SRL
         inline static void Initialize()
         {
             // Memset SGL workarea until the DMA transfer list location, if we go over it, it will corrupt the DMA transfer list
-            Memory::MemSet(&_heap_end, 0, reinterpret_cast<uint32_t>(TransList) - reinterpret_cast<uint32_t>(&_heap_end));
+            // SGL is not initialized yet, so this cannot use DMA
+            Memory::FillCpu(&_heap_end, 0, reinterpret_cast<uintptr_t>(TransList) - reinterpret_cast<uintptr_t>(&_heap_end));
 
             // Initialize memory zones
+            Memory::Telemetry::Reset();
             Memory::HighWorkRam::Initialize();
             Memory::LowWorkRam::Initialize();
             Memory::CartRam::Initialize();
+
+            // Zones were reset, previous per-frame arena is gone
+            Memory::FrameArena::storage = nullptr;
+            Memory::FrameArena::Release();
+
+#if defined(SRL_FRAME_ARENA_SIZE) && (SRL_FRAME_ARENA_SIZE > 0)
+            Memory::FrameArena::Initialize(SRL_FRAME_ARENA_SIZE, Memory::Zone::SRL_FRAME_ARENA_ZONE, SRL_FRAME_ARENA_BUFFERS);
+#endif
         }
 
         /** @brief Gets total size of the used space in the memory zone
@@ -844,6 +3933,28 @@ namespace SRL
             }
         }
 
+        /** @brief Gets size of the largest block that can be allocated in the memory zone
+         * @param zone Memory zone
+         * @return Number of bytes
+         */
+        inline static size_t GetLargestFreeBlock(const Zone zone)
+        {
+            switch (zone)
+            {
+            case Zone::HWRam:
+                return HighWorkRam::GetLargestFreeBlock();
+
+            case Zone::LWRam:
+                return LowWorkRam::GetLargestFreeBlock();
+
+            case Zone::CartRam:
+                return CartRam::GetLargestFreeBlock();
+
+            default:
+                return 0;
+            }
+        }
+
         /** @brief Gets total size of the memory zone
          * @param zone Memory zone
          * @return Number of bytes
@@ -871,7 +3982,12 @@ namespace SRL
          */
         inline static void Free(void* ptr)
         {
-            if (HighWorkRam::InRange(ptr))
+            if (FrameArena::InRange(ptr))
+            {
+                // Per-frame arena memory is released on synchronization
+                return;
+            }
+            else if (HighWorkRam::InRange(ptr))
             {
                 HighWorkRam::Free(ptr);
             }
@@ -888,20 +4004,21 @@ namespace SRL
         /** @brief Allocate some memory in specified zone
          * @param size Number of bytes to allocate
          * @param zone Memory zone
+         * @param tag Allocation category used by telemetry
          * @return Pointer to the allocated space in memory
          */
-        inline static void* Malloc(size_t size, const SRL::Memory::Zone zone)
+        inline static void* Malloc(size_t size, const SRL::Memory::Zone zone, const SRL::Memory::AllocationTag tag = 0)
         {
             switch (zone)
             {
             case SRL::Memory::Zone::CartRam:
-                return SRL::Memory::CartRam::Malloc(size);
+                return SRL::Memory::CartRam::Malloc(size, tag);
 
             case SRL::Memory::Zone::LWRam:
-                return SRL::Memory::LowWorkRam::Malloc(size);
+                return SRL::Memory::LowWorkRam::Malloc(size, tag);
 
             default:
-                return SRL::Memory::HighWorkRam::Malloc(size);
+                return SRL::Memory::HighWorkRam::Malloc(size, tag);
             }
         }
 
@@ -910,7 +4027,7 @@ namespace SRL
          * @param address Address in the memory where object should be allocated
          * @return Pointer to the allocated space in memory
          */
-        inline static void* PlacementMalloc(size_t size, uint32_t address)
+        inline static void* PlacementMalloc(size_t size, uintptr_t address)
         {
             // Figure out what malloc we have to use
             if (SRL::Memory::HighWorkRam::InRange(address))
@@ -1029,14 +4146,68 @@ namespace SRL
  * }
  * @endcode
  */
-#define autonew new(reinterpret_cast<uint32_t>(this))
+#define autonew new(reinterpret_cast<uintptr_t>(this))
+
+/** @relates SRL::Memory
+ * @brief @c new keyword for per-frame arena
+ * @details Object is valid only until the end of current frame (or next frame if arena is double buffered).
+ * Objects allocated this way must not be deleted, their destructor is not called.
+ * @code {.cpp}
+ * void Update()
+ * {
+ *      // Temporary array, released on next SRL::Core::Synchronize()
+ *      Vector3D* points = framenew Vector3D[64];
+ * }
+ * @endcode
+ */
+#define framenew new (SRL::Memory::Frame)
+
+/** @brief Allocate some memory in per-frame arena
+ * @param size Number of bytes to allocate
+ * @param tag Per-frame arena tag
+ * @return Pointer to the allocated space in memory
+ */
+inline void* operator new(size_t size, [[maybe_unused]] const SRL::Memory::FrameTag& tag)
+{
+    return SRL::Memory::FrameArena::Malloc(size);
+}
+
+/** @brief Allocate some memory in per-frame arena
+ * @param size Number of bytes to allocate
+ * @param tag Per-frame arena tag
+ * @return Pointer to the allocated space in memory
+ */
+inline void* operator new[](size_t size, [[maybe_unused]] const SRL::Memory::FrameTag& tag)
+{
+    return SRL::Memory::FrameArena::Malloc(size);
+}
+
+/** @brief Allocate some memory in linear arena
+ * @param size Number of bytes to allocate
+ * @param arena Arena to allocate from
+ * @return Pointer to the allocated space in memory
+ */
+inline void* operator new(size_t size, SRL::Memory::Arena& arena)
+{
+    return arena.Malloc(size);
+}
+
+/** @brief Allocate some memory in linear arena
+ * @param size Number of bytes to allocate
+ * @param arena Arena to allocate from
+ * @return Pointer to the allocated space in memory
+ */
+inline void* operator new[](size_t size, SRL::Memory::Arena& arena)
+{
+    return arena.Malloc(size);
+}
 
 /** @brief Allocate some memory
  * @param size Number of bytes to allocate
  * @param zoneAddress Address in the memory zone where object should be allocated
  * @return Pointer to the allocated space in memory
  */
-inline void* operator new(size_t size, uint32_t zoneAddress)
+inline void* operator new(size_t size, uintptr_t zoneAddress)
 {
     return SRL::Memory::PlacementMalloc(size, zoneAddress);
 }
@@ -1046,7 +4217,7 @@ inline void* operator new(size_t size, uint32_t zoneAddress)
  * @param zoneAddress Address in the memory zone where object should be allocated
  * @return Pointer to the allocated space in memory
  */
-inline void* operator new[](size_t size, uint32_t zoneAddress)
+inline void* operator new[](size_t size, uintptr_t zoneAddress)
 {
     return SRL::Memory::PlacementMalloc(size, zoneAddress);
 }
@@ -1080,6 +4251,28 @@ inline void* operator new(size_t size, const SRL::Memory::Zone zone)
     }
 }
 
+/** @brief Allocate some memory with telemetry tag
+ * @param size Number of bytes to allocate
+ * @param zone Memory zone
+ * @param tag Allocation category used by telemetry
+ * @return Pointer to the allocated space in memory
+ */
+inline void* operator new(size_t size, const SRL::Memory::Zone zone, const SRL::Memory::AllocationTag tag)
+{
+    return SRL::Memory::Malloc(size, zone, tag);
+}
+
+/** @brief Allocate some memory for array with telemetry tag
+ * @param size Number of bytes to allocate
+ * @param zone Memory zone
+ * @param tag Allocation category used by telemetry
+ * @return Pointer to the allocated space in memory
+ */
+inline void* operator new[](size_t size, const SRL::Memory::Zone zone, const SRL::Memory::AllocationTag tag)
+{
+    return SRL::Memory::Malloc(size, zone, tag);
+}
+
 /** @brief Free allocated memory
  * @param ptr Pointer to allocated memory
  */
@@ -0,0 +1,306 @@
+#pragma once
+
+#include "srl_memory.hpp"
+#include "srl_debug.hpp"
+#include <memory_resource>
+
+namespace SRL
+{
+    /** @brief Out of memory handler of memory resources
+     * @details std::pmr containers expect allocation to either succeed or throw, they never check for nullptr.
+     * Exceptions are disabled, so memory resources call this handler instead, it shows assert screen in debug build and halts.
+     * @param bytes Number of bytes that could not be allocated
+     * @param alignment Alignment that was requested
+     */
+    [[noreturn]] inline void MemoryResourceOutOfMemory(size_t bytes, size_t alignment)
+    {
+        Debug::Assert("Memory resource is out of memory!\nCould not allocate %d bytes aligned to %d", static_cast<int>(bytes), static_cast<int>(alignment));
+
+        while (1);
+    }
+
+    /** @brief Memory resource allocating from a memory zone
+     * @details Allocation never returns nullptr, MemoryResourceOutOfMemory() is called when the zone is full
+     * @note This header is not part of srl.hpp, std::pmr needs the project to link libstdc++ (@c SRL_CUSTOM_LDFLAGS = -lstdc++)
+     * @code {.cpp}
+     * #include <srl_memory_resource.hpp>
+     * #include <vector>
+     *
+     * // Cold data in low work RAM
+     * std::pmr::vector<LevelEntry> entries(&SRL::LowWorkRamResource);
+     *
+     * // Temporary list that lives only during current frame
+     * std::pmr::vector<Sprite*> visible(&SRL::FrameArenaResource);
+     * @endcode
+     */
+    class ZoneResource : public std::pmr::memory_resource
+    {
+    private:
+        /** @brief Memory zone
+         */
+        Memory::Zone zone;
+
+        /** @brief Allocation tag used by telemetry
+         */
+        Memory::AllocationTag tag;
+
+        /** @brief Alignment guaranteed by zone allocators
+         */
+        static constexpr size_t NaturalAlignment = 4;
+
+    protected:
+        /** @brief Allocate memory
+         * @details Larger alignments are made by allocating more and storing original address in front of the aligned block
+         * @param bytes Number of bytes to allocate
+         * @param alignment Alignment of the returned address
+         * @return Pointer to the allocated space in memory, never nullptr
+         */
+        void* do_allocate(size_t bytes, size_t alignment) override
+        {
+            if (alignment <= ZoneResource::NaturalAlignment)
+            {
+                void* ptr = Memory::Malloc(bytes, this->zone, this->tag);
+
+                if (ptr == nullptr)
+                {
+                    MemoryResourceOutOfMemory(bytes, alignment);
+                }
+
+                return ptr;
+            }
+
+            void* block = Memory::Malloc(bytes + alignment + sizeof(void*), this->zone, this->tag);
+
+            if (block == nullptr)
+            {
+                MemoryResourceOutOfMemory(bytes, alignment);
+            }
+
+            size_t aligned = (reinterpret_cast<size_t>(block) + sizeof(void*) + alignment - 1) & ~(alignment - 1);
+            reinterpret_cast<void**>(aligned)[-1] = block;
+            return reinterpret_cast<void*>(aligned);
+        }
+
+        /** @brief Free memory
+         * @param ptr Allocated memory
+         * @param bytes Number of bytes that were allocated
+         * @param alignment Alignment the memory was allocated with
+         */
+        void do_deallocate(void* ptr, size_t bytes, size_t alignment) override
+        {
+            if (ptr != nullptr && alignment > ZoneResource::NaturalAlignment)
+            {
+                ptr = reinterpret_cast<void**>(ptr)[-1];
+            }
+
+            Memory::Free(ptr);
+        }
+
+        /** @brief Check whether memory allocated by one resource can be freed by the other
+         * @param other Other resource
+         * @return true only for the same resource (RTTI is not available to compare zones)
+         */
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+
+    public:
+        /** @brief Construct memory resource
+         * @param zone Memory zone to allocate from
+         * @param tag Allocation tag used by telemetry
+         */
+        constexpr ZoneResource(const Memory::Zone zone, const Memory::AllocationTag tag = 0) : zone(zone), tag(tag) { }
+
+        /** @brief Gets memory zone
+         * @return Memory zone
+         */
+        Memory::Zone GetZone() const
+        {
+            return this->zone;
+        }
+    };
+
+    /** @brief Memory resource allocating from a linear arena
+     * @details Deallocation does nothing, memory is released by resetting the arena.
+     * MemoryResourceOutOfMemory() is called when the arena is full.
+     */
+    class ArenaResource : public std::pmr::memory_resource
+    {
+    private:
+        /** @brief Arena to allocate from (nullptr for the per-frame arena)
+         */
+        Memory::Arena* arena;
+
+    protected:
+        /** @brief Allocate memory
+         * @param bytes Number of bytes to allocate
+         * @param alignment Alignment of the returned address
+         * @return Pointer to the allocated space in memory, never nullptr
+         */
+        void* do_allocate(size_t bytes, size_t alignment) override
+        {
+            alignment = alignment < 4 ? 4 : alignment;
+            void* ptr = this->arena != nullptr ? this->arena->Malloc(bytes, alignment) : Memory::FrameArena::Malloc(bytes, alignment);
+
+            if (ptr == nullptr)
+            {
+                MemoryResourceOutOfMemory(bytes, alignment);
+            }
+
+            return ptr;
+        }
+
+        /** @brief Does nothing, arena memory cannot be freed one by one
+         */
+        void do_deallocate(void*, size_t, size_t) override
+        {
+        }
+
+        /** @brief Check whether memory allocated by one resource can be freed by the other
+         * @param other Other resource
+         * @return true only for the same resource
+         */
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+
+    public:
+        /** @brief Construct memory resource for the per-frame arena
+         * @note Containers using it must not outlive the frame (or two frames when the arena is double buffered)
+         */
+        constexpr ArenaResource() : arena(nullptr) { }
+
+        /** @brief Construct memory resource for an arena
+         * @param arena Arena to allocate from
+         */
+        constexpr ArenaResource(Memory::Arena& arena) : arena(&arena) { }
+    };
+
+    /** @brief Memory resource serving fixed size blocks from an object pool
+     * @details Meant for node based containers (std::pmr::list, std::pmr::map), where every allocation has the same size.
+     * Requests larger than the block or made when the pool is full are passed to the upstream resource,
+     * MemoryResourceOutOfMemory() is called when there is no upstream resource.
+     * @tparam BlockSize Size of a pool block in bytes
+     */
+    template<size_t BlockSize>
+    class PoolResource : public std::pmr::memory_resource
+    {
+    private:
+        /** @brief Pool block
+         */
+        struct Block
+        {
+            /** @brief Block storage
+             */
+            alignas(void*) uint8_t Data[BlockSize];
+        };
+
+        /** @brief Pool of blocks
+         */
+        Memory::DynamicPool<Block> pool;
+
+        /** @brief Resource used for requests the pool cannot serve
+         */
+        std::pmr::memory_resource* upstream;
+
+    protected:
+        /** @brief Allocate memory
+         * @param bytes Number of bytes to allocate
+         * @param alignment Alignment of the returned address
+         * @return Pointer to the allocated space in memory, never nullptr
+         */
+        void* do_allocate(size_t bytes, size_t alignment) override
+        {
+            if (bytes <= BlockSize && alignment <= alignof(Block))
+            {
+                Block* block = this->pool.Acquire();
+
+                if (block != nullptr)
+                {
+                    return block;
+                }
+            }
+
+            if (this->upstream == nullptr)
+            {
+                MemoryResourceOutOfMemory(bytes, alignment);
+            }
+
+            return this->upstream->allocate(bytes, alignment);
+        }
+
+        /** @brief Free memory
+         * @param ptr Allocated memory
+         * @param bytes Number of bytes that were allocated
+         * @param alignment Alignment the memory was allocated with
+         */
+        void do_deallocate(void* ptr, size_t bytes, size_t alignment) override
+        {
+            Block* block = reinterpret_cast<Block*>(ptr);
+
+            if (this->pool.Owns(block))
+            {
+                this->pool.Release(block);
+            }
+            else if (this->upstream != nullptr)
+            {
+                this->upstream->deallocate(ptr, bytes, alignment);
+            }
+        }
+
+        /** @brief Check whether memory allocated by one resource can be freed by the other
+         * @param other Other resource
+         * @return true only for the same resource
+         */
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+
+    public:
+        /** @brief Construct memory resource
+         * @param capacity Number of blocks in the pool
+         * @param zone Memory zone to allocate pool storage in
+         * @param upstream Resource for requests the pool cannot serve (nullptr to call MemoryResourceOutOfMemory())
+         */
+        PoolResource(size_t capacity, const Memory::Zone zone, std::pmr::memory_resource* upstream = nullptr) :
+            pool(capacity, zone),
+            upstream(upstream)
+        {
+        }
+
+        /** @brief Gets number of blocks in use
+         * @return Number of blocks
+         */
+        size_t GetCount() const
+        {
+            return this->pool.GetCount();
+        }
+
+        /** @brief Gets number of blocks in the pool
+         * @return Number of blocks
+         */
+        size_t GetCapacity() const
+        {
+            return this->pool.GetCapacity();
+        }
+    };
+
+    /** @brief Memory resource for fast system RAM
+     */
+    inline ZoneResource HighWorkRamResource(Memory::Zone::HWRam);
+
+    /** @brief Memory resource for slower system RAM
+     */
+    inline ZoneResource LowWorkRamResource(Memory::Zone::LWRam);
+
+    /** @brief Memory resource for expansion cart RAM
+     */
+    inline ZoneResource CartRamResource(Memory::Zone::CartRam);
+
+    /** @brief Memory resource for the per-frame arena
+     */
+    inline ArenaResource FrameArenaResource;
+}
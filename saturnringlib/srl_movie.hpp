@@ -0,0 +1,541 @@
+#pragma once
+
+#include "srl_base.hpp"
+#include "srl_memory.hpp"
+#include "srl_cd.hpp"
+#include "srl_core.hpp"
+#include "srl_vdp1.hpp"
+
+extern "C" {
+    #include <sgl_cpk.h>
+}
+
+namespace SRL
+{
+    /** @brief Cinepak movie player
+     * @details Plays Cinepak (FILM/CPK) files from CD using the SGL Cinepak library (CPK).
+     * Frames are decoded as RGB555 pixels either into two VDP1 textures or into two areas of a VDP2 bitmap.
+     * While one buffer is displayed, next frame is decoded into the other one, buffers are swapped once that frame is due.<br/>
+     * When the movie has sound, CPK plays it from sound RAM and uses its position as the movie clock,
+     * frames that are decoded too late for their time are dropped to keep the picture in sync with the sound.
+     * Dropped frames are reported by GetDroppedFrames().
+     * @note Movie::Update() must be called every frame, CPK clock is driven from SRL::Core::OnVblank.
+     * Movie takes one GFS file handle for as long as it exists (see @c SRL_MAX_CD_BACKGROUND_JOBS).
+     * @code {.cpp}
+     * SRL::Cd::File file("INTRO.CPK");
+     * SRL::Movie movie(file);
+     *
+     * // Decode into VDP1 textures and show them with a sprite
+     * movie.DecodeToTextures();
+     * movie.Start();
+     *
+     * while (!movie.IsFinished())
+     * {
+     *     movie.Update();
+     *     SRL::Scene2D::DrawSprite(movie.GetTexture(), SRL::Math::Types::Vector3D(0.0, 0.0, 500.0));
+     *     SRL::Core::Synchronize();
+     * }
+     * @endcode
+     * @code {.cpp}
+     * // Decode into 512x512 RGB555 bitmap of NBG0, frames are at rows 0 and 256, scroll shows the one being displayed
+     * uint8_t* bitmap = (uint8_t*)SRL::VDP2::NBG0::GetCellAddress();
+     * movie.DecodeToBitmap(bitmap, bitmap + (256 * 512 * 2), 512 * 2);
+     * movie.Start();
+     *
+     * while (!movie.IsFinished())
+     * {
+     *     movie.Update();
+     *     SRL::Math::Types::Vector2D position(0.0, movie.GetFrontIndex() * 256.0);
+     *     SRL::VDP2::NBG0::SetPosition(position);
+     *     SRL::Core::Synchronize();
+     * }
+     * @endcode
+     */
+    class Movie
+    {
+    public:
+        /** @brief Default size of the ring buffer for movie data in bytes
+         */
+        static constexpr int32_t DefaultBufferSize = 200 * 1024;
+
+        /** @brief Default PCM buffer for movie sound in sound RAM (end of sound RAM, after SGL sound driver data)
+         */
+        inline static uint16_t* const DefaultPcmAddress = reinterpret_cast<uint16_t*>(0x25A78000);
+
+        /** @brief Default size of the PCM buffer in samples per channel
+         */
+        static constexpr int32_t DefaultPcmSamples = 4096;
+
+        /** @brief Playback status
+         */
+        enum class Status : int8_t
+        {
+            /** @brief Playback stopped on error
+             */
+            Error = CPK_STAT_PLAY_ERR_STOP,
+
+            /** @brief Movie was not started yet or was stopped
+             */
+            Stopped = CPK_STAT_PLAY_STOP,
+
+            /** @brief Playback is paused
+             */
+            Paused = CPK_STAT_PLAY_PAUSE,
+
+            /** @brief Movie was started, buffering data
+             */
+            Starting = CPK_STAT_PLAY_START,
+
+            /** @brief Movie header is being processed
+             */
+            Header = CPK_STAT_PLAY_HEADER,
+
+            /** @brief Movie is playing
+             */
+            Playing = CPK_STAT_PLAY_TIME,
+
+            /** @brief Whole movie was played
+             */
+            Ended = CPK_STAT_PLAY_END
+        };
+
+    private:
+        /** @brief CPK library was initialized
+         */
+        inline static bool initialized = false;
+
+        /** @brief Movie file
+         */
+        Cd::File* file;
+
+        /** @brief File was opened by the movie
+         */
+        bool ownsHandle;
+
+        /** @brief CPK movie handle
+         */
+        CpkHn handle;
+
+        /** @brief CPK work area
+         */
+        uint32_t* work;
+
+        /** @brief Ring buffer for movie data
+         */
+        uint32_t* buffer;
+
+        /** @brief Movie frame width in pixels
+         */
+        uint16_t width;
+
+        /** @brief Movie frame height in pixels
+         */
+        uint16_t height;
+
+        /** @brief Frame buffers, displayed one is at frontIndex
+         */
+        void* frames[2];
+
+        /** @brief VDP1 texture of each frame buffer (-1 when decoding into bitmap)
+         */
+        int32_t textures[2];
+
+        /** @brief Index of displayed frame buffer
+         */
+        uint8_t frontIndex;
+
+        /** @brief Line size of frame buffers in bytes
+         */
+        int32_t lineSize;
+
+        /** @brief Number of displayed frames
+         */
+        uint32_t displayedFrames;
+
+        /** @brief Initialize CPK library and hook its clock into v-blank
+         * @return true on success
+         */
+        static bool Initialize()
+        {
+            if (!Movie::initialized && CPK_Init())
+            {
+                SRL::Core::OnVblank += Movie::VblankHandling;
+                Movie::initialized = true;
+            }
+
+            return Movie::initialized;
+        }
+
+        /** @brief Advance CPK clock
+         */
+        static void VblankHandling()
+        {
+            CPK_VblIn();
+        }
+
+        /** @brief Point CPK at frame buffer that is not displayed
+         */
+        void SetDecodeBuffer()
+        {
+            CPK_SetDecodeAddr(this->handle, this->frames[this->frontIndex ^ 1], this->lineSize);
+        }
+
+    public:
+        /** @brief disable default constructor
+         */
+        Movie() = delete;
+
+        /** @brief Open movie and read its header
+         * @param file Cinepak movie file
+         * @param bufferSize Size of the ring buffer for movie data in bytes
+         * @param zone Memory zone to take the ring buffer and CPK work area from
+         * @param pcmAddress PCM buffer in sound RAM
+         * @param pcmSamples Size of the PCM buffer in samples per channel (multiple of 4096, up to 65536)
+         */
+        Movie(
+            Cd::File& file,
+            const int32_t bufferSize = Movie::DefaultBufferSize,
+            const Memory::Zone zone = Memory::Zone::LWRam,
+            uint16_t* const pcmAddress = Movie::DefaultPcmAddress,
+            const int32_t pcmSamples = Movie::DefaultPcmSamples) :
+            file(&file),
+            ownsHandle(false),
+            handle(nullptr),
+            work(nullptr),
+            buffer(nullptr),
+            width(0),
+            height(0),
+            frames{ nullptr, nullptr },
+            textures{ -1, -1 },
+            frontIndex(0),
+            lineSize(0),
+            displayedFrames(0)
+        {
+            if (!file.Exists() || !Movie::Initialize())
+            {
+                return;
+            }
+
+            if (!file.IsOpen())
+            {
+                if (!file.Open())
+                {
+                    return;
+                }
+
+                this->ownsHandle = true;
+            }
+
+            // CPK reads through the handle on its own, it must not be given to other files
+            if (!Cd::HandlePool::Pin(file))
+            {
+                return;
+            }
+
+            this->work = reinterpret_cast<uint32_t*>(Memory::Malloc(CPK_15WORK_BSIZE, zone));
+            this->buffer = reinterpret_cast<uint32_t*>(Memory::Malloc(bufferSize, zone));
+
+            if (this->work == nullptr || this->buffer == nullptr)
+            {
+                return;
+            }
+
+            CpkCreatePara parameters;
+            CPK_PARA_WORK_ADDR(&parameters) = this->work;
+            CPK_PARA_WORK_SIZE(&parameters) = CPK_15WORK_BSIZE;
+            CPK_PARA_BUF_ADDR(&parameters) = this->buffer;
+            CPK_PARA_BUF_SIZE(&parameters) = bufferSize;
+            CPK_PARA_PCM_ADDR(&parameters) = pcmAddress;
+            CPK_PARA_PCM_SIZE(&parameters) = pcmSamples;
+
+            this->handle = CPK_CreateGfsMovie(&parameters, file.Handle);
+
+            if (this->handle == nullptr)
+            {
+                return;
+            }
+
+            CPK_SetColor(this->handle, CPK_COLOR_15BIT);
+
+            // Header must be known before frame buffers can be sized
+            CPK_PreloadHeader(this->handle);
+            CpkHeader* header = CPK_GetHeader(this->handle);
+
+            if (header == nullptr || (header->c_type != CPK_CTYPE_CVID && header->c_type != CPK_CTYPE_NONE))
+            {
+                CPK_DestroyGfsMovie(this->handle);
+                this->handle = nullptr;
+                return;
+            }
+
+            this->width = header->width;
+            this->height = header->height;
+        }
+
+        /** @brief Stop playback and release movie resources
+         * @note VDP1 textures allocated by DecodeToTextures() stay allocated until VDP1 texture heap is reset
+         */
+        ~Movie()
+        {
+            if (this->handle != nullptr)
+            {
+                CPK_Stop(this->handle);
+                CPK_DestroyGfsMovie(this->handle);
+            }
+
+            Cd::HandlePool::Unpin(*this->file);
+
+            if (this->ownsHandle)
+            {
+                this->file->Close();
+            }
+
+            Memory::Free(this->buffer);
+            Memory::Free(this->work);
+        }
+
+        Movie(const Movie&) = delete;
+        Movie& operator=(const Movie&) = delete;
+
+        /** @brief Check whether movie was opened
+         * @return true if movie can be played
+         */
+        bool IsValid() const
+        {
+            return this->handle != nullptr;
+        }
+
+        /** @brief Gets movie frame width
+         * @return Width in pixels
+         */
+        uint16_t GetWidth() const
+        {
+            return this->width;
+        }
+
+        /** @brief Gets movie frame height
+         * @return Height in pixels
+         */
+        uint16_t GetHeight() const
+        {
+            return this->height;
+        }
+
+        /** @brief Check whether movie has sound
+         * @return true if movie has sound
+         */
+        bool HasSound() const
+        {
+            return this->IsValid() && CPK_GetHeader(this->handle)->sound_channel > 0;
+        }
+
+        /** @brief Decode frames into two newly allocated VDP1 RGB555 textures
+         * @details Texture width is movie width rounded up to multiple of 8.
+         * @return true if textures were allocated
+         */
+        bool DecodeToTextures()
+        {
+            if (!this->IsValid())
+            {
+                return false;
+            }
+
+            const uint16_t textureWidth = (this->width + 7) & ~7;
+
+            for (int32_t index = 0; index < 2; index++)
+            {
+                this->textures[index] = VDP1::TryAllocateTexture(textureWidth, this->height, CRAM::TextureColorMode::RGB555, 0);
+
+                if (this->textures[index] < 0)
+                {
+                    return false;
+                }
+
+                this->frames[index] = VDP1::Textures[this->textures[index]].GetData();
+            }
+
+            this->lineSize = textureWidth * sizeof(uint16_t);
+            this->SetDecodeBuffer();
+            return true;
+        }
+
+        /** @brief Decode frames into VDP2 bitmap (or any other memory)
+         * @param front Start of first frame buffer, displayed before the first frame arrives
+         * @param back Start of second frame buffer, first frame is decoded there
+         * @param lineSize Size of one line of the bitmap in bytes (2 bytes per pixel)
+         * @return true if movie can be decoded into the buffers
+         */
+        bool DecodeToBitmap(void* front, void* back, const int32_t lineSize)
+        {
+            if (!this->IsValid() || front == nullptr || back == nullptr || lineSize < this->width * (int32_t)sizeof(uint16_t))
+            {
+                return false;
+            }
+
+            this->frames[0] = front;
+            this->frames[1] = back;
+            this->textures[0] = -1;
+            this->textures[1] = -1;
+            this->lineSize = lineSize;
+            this->SetDecodeBuffer();
+            return true;
+        }
+
+        /** @brief Start playback from the beginning
+         * @return true if movie was started
+         */
+        bool Start()
+        {
+            if (!this->IsValid() || this->lineSize == 0)
+            {
+                return false;
+            }
+
+            this->frontIndex = 0;
+            this->displayedFrames = 0;
+            this->SetDecodeBuffer();
+            CPK_Start(this->handle);
+            return true;
+        }
+
+        /** @brief Stop playback
+         */
+        void Stop()
+        {
+            if (this->IsValid())
+            {
+                CPK_Stop(this->handle);
+            }
+        }
+
+        /** @brief Pause or resume playback
+         * @param pause true to pause, false to resume
+         * @return true if playback state was changed
+         */
+        bool Pause(const bool pause)
+        {
+            return this->IsValid() && CPK_Pause(this->handle, pause ? CPK_PAUSE_ON_AT_ONCE : CPK_PAUSE_OFF);
+        }
+
+        /** @brief Set sound volume
+         * @param volume Volume level (0 to 7)
+         */
+        void SetVolume(const int32_t volume)
+        {
+            if (this->IsValid())
+            {
+                CPK_SetVolume(this->handle, SRL::Math::Max<int32_t>(0, SRL::Math::Min<int32_t>(volume, 7)));
+            }
+        }
+
+        /** @brief Set sound pan
+         * @param pan Pan (0 to 31)
+         */
+        void SetPan(const int32_t pan)
+        {
+            if (this->IsValid())
+            {
+                CPK_SetPan(this->handle, SRL::Math::Max<int32_t>(0, SRL::Math::Min<int32_t>(pan, 31)));
+            }
+        }
+
+        /** @brief Read and decode movie data, swap frame buffers once decoded frame is due
+         * @note Must be called every frame while movie plays
+         * @return true if a new frame is displayed
+         */
+        bool Update()
+        {
+            if (!this->IsValid() || this->lineSize == 0)
+            {
+                return false;
+            }
+
+            CPK_Task(this->handle);
+
+            if (!CPK_IsDispTime(this->handle))
+            {
+                return false;
+            }
+
+            // Decoded frame becomes the displayed one, next frame goes into the buffer that was displayed until now
+            this->frontIndex ^= 1;
+            this->SetDecodeBuffer();
+            CPK_CompleteDisp(this->handle);
+            this->displayedFrames++;
+            return true;
+        }
+
+        /** @brief Gets playback status
+         * @return Playback status
+         */
+        Status GetStatus() const
+        {
+            return this->IsValid() ? static_cast<Status>(CPK_GetPlayStatus(this->handle)) : Status::Error;
+        }
+
+        /** @brief Check whether playback ended
+         * @return true if movie was played to the end, failed or could not be opened
+         */
+        bool IsFinished() const
+        {
+            const Status status = this->GetStatus();
+            return status == Status::Ended || status == Status::Error;
+        }
+
+        /** @brief Gets index of displayed frame buffer
+         * @return 0 for first buffer, 1 for second buffer
+         */
+        uint8_t GetFrontIndex() const
+        {
+            return this->frontIndex;
+        }
+
+        /** @brief Gets displayed frame buffer
+         * @return Start of the frame buffer
+         */
+        void* GetFrontBuffer() const
+        {
+            return this->frames[this->frontIndex];
+        }
+
+        /** @brief Gets VDP1 texture with displayed frame
+         * @return Texture index or -1 if frames are not decoded into textures
+         */
+        int32_t GetTexture() const
+        {
+            return this->textures[this->frontIndex];
+        }
+
+        /** @brief Gets playback position
+         * @return Time from the start of the movie in milliseconds
+         */
+        int32_t GetTime() const
+        {
+            if (!this->IsValid())
+            {
+                return 0;
+            }
+
+            const int32_t time = CPK_GetTime(this->handle);
+            const int32_t scale = CPK_GetTimeScale(this->handle);
+            return scale > 0 ? ((time / scale) * 1000) + (((time % scale) * 1000) / scale) : 0;
+        }
+
+        /** @brief Gets number of frames displayed since start
+         * @return Number of frames
+         */
+        uint32_t GetDisplayedFrames() const
+        {
+            return this->displayedFrames;
+        }
+
+        /** @brief Gets number of frames dropped to keep up with the movie clock
+         * @details Frame is dropped when it could not be read or decoded before its display time ended.
+         * @return Number of dropped frames
+         */
+        uint32_t GetDroppedFrames() const
+        {
+            return this->IsValid() ? (*reinterpret_cast<CpkWork**>(this->handle))->status.CntLossFrame : 0;
+        }
+    };
+}
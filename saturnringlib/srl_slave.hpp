@@ -50,6 +50,8 @@ namespace SRL
             ITask() : done(false) {}
 
             /** @brief Abstract method that defines the task's behavior
+             * @note Memory can be allocated and freed here, zone allocators are shared with master CPU (see SRL::Memory::ZoneLock).
+             * Arenas, pools, movable heaps and the per-frame arena are not locked and must not be used from both CPUs at once.
              */
             virtual void Do() = 0;
         };
@@ -0,0 +1,569 @@
+#pragma once
+
+#include "srl_base.hpp"
+#include "srl_memory.hpp"
+#include "srl_cd.hpp"
+
+extern "C" {
+    #include <sega_stm.h>
+}
+
+namespace SRL
+{
+    /** @brief Interleaved CD stream
+     * @details Plays a file made of sectors of several channels (video, music, level data, ...) mixed together,
+     * so all of them arrive at full drive speed without seeking between files.<br/>
+     * File is read by the SGL stream library (STM) into the CD block buffer, its transfer function then moves every sector
+     * into the ring buffer of the channel the sector belongs to.
+     * Each sector starts with a 4 byte header: channel number, flags and number of payload bytes (big-endian),
+     * rest of the sector is payload. Files are made by tools/scripts/srl_interleave.py.<br/>
+     * Sectors of channels that were not opened are dropped. When a ring buffer of any open channel cannot take another sector,
+     * transfer waits and the drive pauses once the CD block buffer is full, so ring sizes should follow channel data rates.
+     * @note Sectors are transferred in SRL::Core::Synchronize() or by calling Stream::Update().
+     * Only one stream can be playing at a time. Stream takes one GFS file handle out of SRL::Cd::HandlePool
+     * (see @c SRL_MAX_CD_BACKGROUND_JOBS).
+     * @code {.cpp}
+     * SRL::Cd::File file("INTRO.ILV");
+     * SRL::Stream stream(file);
+     *
+     * // Channel numbers are assigned when the file is made by srl_interleave.py
+     * SRL::Stream::Channel* video = stream.OpenChannel(0, 64 * 1024);
+     * SRL::Stream::Channel* music = stream.OpenChannel(1, 16 * 1024, SRL::Memory::Zone::LWRam);
+     * stream.Start();
+     *
+     * while (!video->IsEnded())
+     * {
+     *     int32_t size;
+     *     const uint8_t* data = video->GetData(size);
+     *     ...
+     *     video->Skip(used);
+     *     SRL::Core::Synchronize();
+     * }
+     * @endcode
+     */
+    class Stream
+    {
+    public:
+        /** @brief Size of stream sector in bytes
+         */
+        static constexpr int32_t SectorSize = 2048;
+
+        /** @brief Size of sector header in bytes
+         */
+        static constexpr int32_t HeaderSize = 4;
+
+        /** @brief Number of payload bytes in a sector
+         */
+        static constexpr int32_t PayloadSize = Stream::SectorSize - Stream::HeaderSize;
+
+        /** @brief Number of channels stream can have
+         */
+        static constexpr uint8_t MaxChannels = 16;
+
+        /** @brief Stream statistics
+         */
+        struct Statistics
+        {
+            /** @brief Number of sectors moved into channel ring buffers
+             */
+            uint32_t Sectors;
+
+            /** @brief Number of sectors dropped, because their channel was not open
+             */
+            uint32_t Skipped;
+
+            /** @brief Number of times data waited in CD block buffer, because a ring buffer was full
+             */
+            uint32_t Stalls;
+        };
+
+        /** @brief Ring buffer receiving data of one channel
+         */
+        class Channel
+        {
+        private:
+            /** @brief Stream writes into the buffer
+             */
+            friend class Stream;
+
+            /** @brief Buffer storage
+             */
+            uint8_t* buffer;
+
+            /** @brief Size of the buffer in bytes
+             */
+            int32_t capacity;
+
+            /** @brief Offset of the first byte to read
+             */
+            int32_t readIndex;
+
+            /** @brief Offset of the next byte to write
+             */
+            int32_t writeIndex;
+
+            /** @brief Number of bytes in the buffer
+             */
+            int32_t length;
+
+            /** @brief Last sector of the channel was received
+             */
+            bool ended;
+
+            /** @brief Append bytes of one data word
+             * @param word Data word as read from the CD block
+             * @param bytes Number of bytes from the start of the word to append (1 to 4)
+             */
+            void Push(const uint32_t word, const int32_t bytes)
+            {
+                if (bytes == 4 && (this->writeIndex & 3) == 0)
+                {
+                    // Capacity is a multiple of 4, so aligned word never crosses the end of the buffer
+                    *reinterpret_cast<uint32_t*>(this->buffer + this->writeIndex) = word;
+                    this->writeIndex += 4;
+
+                    if (this->writeIndex == this->capacity)
+                    {
+                        this->writeIndex = 0;
+                    }
+                }
+                else
+                {
+                    const uint8_t* source = reinterpret_cast<const uint8_t*>(&word);
+
+                    for (int32_t byte = 0; byte < bytes; byte++)
+                    {
+                        this->buffer[this->writeIndex] = source[byte];
+
+                        if (++this->writeIndex == this->capacity)
+                        {
+                            this->writeIndex = 0;
+                        }
+                    }
+                }
+
+                this->length += bytes;
+            }
+
+            /** @brief Release buffer and forget all data
+             */
+            void Release()
+            {
+                if (this->buffer != nullptr)
+                {
+                    Memory::Free(this->buffer);
+                }
+
+                *this = Channel();
+            }
+
+        public:
+            /** @brief Construct channel without buffer
+             */
+            Channel() : buffer(nullptr), capacity(0), readIndex(0), writeIndex(0), length(0), ended(false)
+            {
+            }
+
+            /** @brief Check whether channel was opened
+             * @return true if channel has a buffer
+             */
+            bool IsOpen() const
+            {
+                return this->buffer != nullptr;
+            }
+
+            /** @brief Gets number of bytes ready to be read
+             * @return Number of bytes
+             */
+            int32_t GetAvailable() const
+            {
+                return this->length;
+            }
+
+            /** @brief Gets number of bytes buffer can still take
+             * @return Number of bytes
+             */
+            int32_t GetFree() const
+            {
+                return this->capacity - this->length;
+            }
+
+            /** @brief Gets size of the buffer
+             * @return Number of bytes
+             */
+            int32_t GetCapacity() const
+            {
+                return this->capacity;
+            }
+
+            /** @brief Check whether whole channel was received and read
+             * @return true if there is nothing more to read
+             */
+            bool IsEnded() const
+            {
+                return this->ended && this->length == 0;
+            }
+
+            /** @brief Gets data ready to be used in place, without copying
+             * @details Only data up to the end of the buffer are returned, rest is returned after Skip()
+             * @param size Number of bytes returned data have
+             * @return Pointer to data
+             */
+            const uint8_t* GetData(int32_t& size) const
+            {
+                size = SRL::Math::Min<int32_t>(this->length, this->capacity - this->readIndex);
+                return this->buffer + this->readIndex;
+            }
+
+            /** @brief Drop data from the start of the buffer
+             * @param size Number of bytes to drop
+             * @return Number of bytes dropped
+             */
+            int32_t Skip(int32_t size)
+            {
+                size = SRL::Math::Max<int32_t>(SRL::Math::Min<int32_t>(size, this->length), 0);
+                this->readIndex += size;
+
+                if (this->readIndex >= this->capacity)
+                {
+                    this->readIndex -= this->capacity;
+                }
+
+                this->length -= size;
+                return size;
+            }
+
+            /** @brief Copy data out of the buffer
+             * @param size Number of bytes to read
+             * @param destination Buffer to copy data into
+             * @return Number of bytes read
+             */
+            int32_t Read(int32_t size, void* destination)
+            {
+                uint8_t* target = reinterpret_cast<uint8_t*>(destination);
+                int32_t currentlyRead = 0;
+                size = SRL::Math::Max<int32_t>(SRL::Math::Min<int32_t>(size, this->length), 0);
+
+                while (currentlyRead < size)
+                {
+                    int32_t available;
+                    const uint8_t* data = this->GetData(available);
+                    available = SRL::Math::Min<int32_t>(available, size - currentlyRead);
+
+                    Memory::Copy(target + currentlyRead, data, available);
+                    currentlyRead += this->Skip(available);
+                }
+
+                return currentlyRead;
+            }
+        };
+
+    private:
+        /** @brief Sector is the last one of its channel
+         */
+        static constexpr uint8_t EndOfChannel = 0x01;
+
+        /** @brief STM work area
+         */
+        inline static uint32_t work[STM_WORK_SIZE(SRL_MAX_CD_STREAMS, SRL_MAX_CD_STREAMS) / sizeof(uint32_t)];
+
+        /** @brief STM initialization status
+         */
+        inline static bool isInitialized = false;
+
+        /** @brief Stream being transferred
+         */
+        inline static Stream* playing = nullptr;
+
+        /** @brief STM stream group
+         */
+        StmGrpHn group;
+
+        /** @brief STM stream reading the file
+         */
+        StmHn handle;
+
+        /** @brief Slot of Cd::HandlePool reserved for the stream (-1 if none)
+         */
+        int32_t handleSlot;
+
+        /** @brief Channel ring buffers
+         */
+        Channel channels[Stream::MaxChannels];
+
+        /** @brief Stream statistics
+         */
+        Statistics statistics;
+
+        /** @brief Initialize SGL stream library
+         * @return true if library is ready
+         */
+        static bool Initialize()
+        {
+            if (!Stream::isInitialized && Cd::Initialize())
+            {
+                Stream::isInitialized = STM_Init(SRL_MAX_CD_STREAMS, SRL_MAX_CD_STREAMS, Stream::work);
+            }
+
+            return Stream::isInitialized;
+        }
+
+        /** @brief Gets number of sectors that can be transferred without overflowing any ring buffer
+         * @details Channel of a sector is known only after its transfer started, so every open channel must have room for it
+         * @param sectorCount Number of sectors waiting in CD block buffer
+         * @return Number of sectors
+         */
+        int32_t GetTransferableSectors(int32_t sectorCount) const
+        {
+            for (const Channel& channel : this->channels)
+            {
+                if (channel.IsOpen() && !channel.ended)
+                {
+                    sectorCount = SRL::Math::Min<int32_t>(sectorCount, channel.GetFree() / Stream::PayloadSize);
+                }
+            }
+
+            return sectorCount;
+        }
+
+        /** @brief Move sectors from CD block into channel ring buffers
+         * @note Called by STM_ExecServer()
+         * @param object Stream
+         * @param stm STM stream
+         * @param sectorCount Number of sectors waiting in CD block buffer
+         * @return Number of sectors transferred
+         */
+        static int32_t Transfer(void* object, StmHn stm, int32_t sectorCount)
+        {
+            Stream* stream = reinterpret_cast<Stream*>(object);
+            sectorCount = stream->GetTransferableSectors(sectorCount);
+
+            if (sectorCount <= 0)
+            {
+                stream->statistics.Stalls++;
+                return 0;
+            }
+
+            // Source is CD block data register (increment is 0) or memory
+            int32_t increment;
+            const uint32_t* source = STM_StartTrans(stm, &increment);
+            increment = increment != 0 ? 1 : 0;
+
+            for (int32_t sector = 0; sector < sectorCount; sector++)
+            {
+                const uint32_t header = *source;
+                const uint8_t* headerBytes = reinterpret_cast<const uint8_t*>(&header);
+                source += increment;
+
+                Channel* channel = headerBytes[0] < Stream::MaxChannels ? &stream->channels[headerBytes[0]] : nullptr;
+                int32_t payload = SRL::Math::Min<int32_t>((headerBytes[2] << 8) | headerBytes[3], Stream::PayloadSize);
+
+                if (channel == nullptr || !channel->IsOpen())
+                {
+                    channel = nullptr;
+                    stream->statistics.Skipped++;
+                }
+                else
+                {
+                    channel->ended = (headerBytes[1] & Stream::EndOfChannel) != 0;
+                    stream->statistics.Sectors++;
+                }
+
+                // Whole sector must be read, bytes after the payload are padding
+                for (int32_t word = 0; word < Stream::PayloadSize / 4; word++)
+                {
+                    const uint32_t data = *source;
+                    source += increment;
+
+                    if (channel != nullptr && payload > 0)
+                    {
+                        channel->Push(data, SRL::Math::Min<int32_t>(payload, 4));
+                        payload -= 4;
+                    }
+                }
+            }
+
+            return sectorCount;
+        }
+
+    public:
+        /** @brief disable default constructor
+         */
+        Stream() = delete;
+
+        /** @brief Open interleaved file
+         * @param file File made by srl_interleave.py
+         */
+        Stream(Cd::File& file) : group(nullptr), handle(nullptr), handleSlot(-1), statistics({ 0, 0, 0 })
+        {
+            if (file.Exists() && Stream::Initialize())
+            {
+                // STM opens the file through GFS, handle must not be kept by other file
+                this->handleSlot = Cd::HandlePool::Reserve();
+                this->group = STM_OpenGrp();
+
+                if (this->group != nullptr)
+                {
+                    // Sectors are told apart by their header, not by CD-ROM XA subheader
+                    StmKey key;
+                    STM_KEY_FN(&key) = STM_KEY_NONE;
+                    STM_KEY_CN(&key) = STM_KEY_NONE;
+                    STM_KEY_SMMSK(&key) = STM_KEY_NONE;
+                    STM_KEY_SMVAL(&key) = STM_KEY_NONE;
+                    STM_KEY_CIMSK(&key) = STM_KEY_NONE;
+                    STM_KEY_CIVAL(&key) = STM_KEY_NONE;
+
+                    // Identifier from Cd::PathIndex is valid only in its own directory
+                    this->handle = file.WithIdentifier([this, &key](const int32_t identifier) {
+                        return STM_OpenFid(this->group, identifier, &key, STM_LOOP_NOREAD);
+                    });
+
+                    if (this->handle == nullptr)
+                    {
+                        STM_CloseGrp(this->group);
+                        this->group = nullptr;
+                        Cd::HandlePool::Unreserve(this->handleSlot);
+                        this->handleSlot = -1;
+                    }
+                    else
+                    {
+                        STM_SetTrFunc(this->handle, Stream::Transfer, this);
+                    }
+                }
+            }
+        }
+
+        /** @brief Close stream and release channel buffers
+         */
+        ~Stream()
+        {
+            this->Stop();
+
+            if (this->handle != nullptr)
+            {
+                STM_Close(this->handle);
+                STM_CloseGrp(this->group);
+            }
+
+            Cd::HandlePool::Unreserve(this->handleSlot);
+
+            for (Channel& channel : this->channels)
+            {
+                channel.Release();
+            }
+        }
+
+        Stream(const Stream&) = delete;
+        Stream& operator=(const Stream&) = delete;
+
+        /** @brief Check whether file was opened
+         * @return true if stream can be played
+         */
+        bool IsValid() const
+        {
+            return this->handle != nullptr;
+        }
+
+        /** @brief Create ring buffer for a channel
+         * @param number Channel number
+         * @param size Size of the buffer in bytes (at least one sector payload)
+         * @param zone Memory zone to take the buffer from
+         * @return Channel or nullptr if buffer could not be allocated
+         */
+        Channel* OpenChannel(uint8_t number, int32_t size, const Memory::Zone zone = Memory::Zone::HWRam)
+        {
+            if (number >= Stream::MaxChannels)
+            {
+                return nullptr;
+            }
+
+            Channel& channel = this->channels[number];
+            channel.Release();
+
+            size = (SRL::Math::Max<int32_t>(size, Stream::PayloadSize) + 3) & ~3;
+            channel.buffer = reinterpret_cast<uint8_t*>(Memory::Malloc(size, zone));
+            channel.capacity = channel.buffer != nullptr ? size : 0;
+            return channel.IsOpen() ? &channel : nullptr;
+        }
+
+        /** @brief Gets channel
+         * @param number Channel number
+         * @return Channel or nullptr if channel was not opened
+         */
+        Channel* GetChannel(uint8_t number)
+        {
+            return number < Stream::MaxChannels && this->channels[number].IsOpen() ? &this->channels[number] : nullptr;
+        }
+
+        /** @brief Start or resume moving sectors into channels
+         * @return true if stream is playing
+         */
+        bool Start()
+        {
+            if (Stream::playing == this)
+            {
+                return true;
+            }
+            else if (Stream::playing != nullptr || !this->IsValid() || !STM_SetExecGrp(this->group))
+            {
+                return false;
+            }
+
+            Stream::playing = this;
+            return true;
+        }
+
+        /** @brief Stop moving sectors into channels
+         * @note Drive keeps reading until the CD block buffer is full, playback continues from there after Start()
+         */
+        void Stop()
+        {
+            if (Stream::playing == this)
+            {
+                Stream::playing = nullptr;
+            }
+        }
+
+        /** @brief Check whether stream is playing
+         * @return true if sectors are being moved into channels
+         */
+        bool IsPlaying() const
+        {
+            return Stream::playing == this;
+        }
+
+        /** @brief Check whether whole file was read and moved into channels
+         * @return true if stream is finished
+         */
+        bool IsFinished() const
+        {
+            return this->IsValid() && STM_IsComplete(this->handle);
+        }
+
+        /** @brief Gets stream statistics
+         * @return Stream statistics
+         */
+        const Statistics& GetStatistics() const
+        {
+            return this->statistics;
+        }
+
+        /** @brief Reset stream statistics
+         */
+        void ResetStatistics()
+        {
+            this->statistics = { 0, 0, 0 };
+        }
+
+        /** @brief Read sectors and move them into channels of the playing stream
+         * @note Called from SRL::Core::Synchronize(), call it more often when channels are consumed faster than once per frame
+         */
+        static void Update()
+        {
+            if (Stream::playing != nullptr)
+            {
+                STM_ExecServer();
+            }
+        }
+    };
+}
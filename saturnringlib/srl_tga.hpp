@@ -691,100 +691,109 @@ namespace SRL::Bitmap
             // Open file
             if (read == file->Size.Bytes)
             {
-                // Load file
-                uint8_t* data = stream;
-
-                // Load header, this is a bit complicated since the header not only is not aligned, but is also little endian
-                TgaHeader header;
-                header.ImageIdLength = *(data);
-                header.HasPalette = *(data + 1);
-                header.ImageType = *(data + 2);
-                header.Palette.PaletteStart = SRL::Endian::DeserializeUint16(data + 3);
-                header.Palette.PaletteLength = SRL::Endian::DeserializeUint16(data + 5);
-                header.Palette.PaletteColorDepth = *(data + 7);
-                header.Image.Origin.X = SRL::Endian::DeserializeUint16(data + 8);
-                header.Image.Origin.Y = SRL::Endian::DeserializeUint16(data + 10);
-                header.Image.Size.X = SRL::Endian::DeserializeUint16(data + 12);
-                header.Image.Size.Y = SRL::Endian::DeserializeUint16(data + 14);
-                header.Image.PixelColorDepth = *(data + 16);
-                header.Image.Descriptor.Value = *(data + 17);
-
-                // Lets check whether the header makes sense
-                if (header.Image.Size.X == 0 || header.Image.Size.Y == 0)
-                {
-                    // Image has no size or is too big
-                    SRL::Debug::Assert("Image has no size or is too big!\nWidth=%d\nHeight=%d", header.Image.Size.X, header.Image.Size.Y);
-                }
+                this->Decode(stream, settings);
+            }
+            else
+            {
+                SRL::Debug::Assert("File size does not match!.");
+            }
 
-                // Check format
-                if (!TGA::IsFormatValid(&header))
-                {
-                    // We do not know how to read this type
-                    SRL::Debug::Assert("Image is of unsupported type!");
-                }
+            // Clear allocated memory
+            delete stream;
+        }
 
-                // Set TGA object stuff
-                this->width = (size_t)header.Image.Size.X;
-                this->height = (size_t)header.Image.Size.Y;
-
-                // Pixel read order
-                uint8_t origin = header.Image.Descriptor.Data.Origin;
-                ForRange xLoop = { 0, 0, 0 };
-                ForRange yLoop = { 0, 0, 0 };
-
-                if (origin == TgaOrigin::TopLeft || origin == TgaOrigin::TopRight) {
-                    yLoop.Start = 0; // start bottom, step upward
-                    yLoop.Step = 1;
-                    yLoop.End = this->height;
-                } else {
-                    yLoop.Start = this->height - 1; // start at top, step downward
-                    yLoop.Step = -1;
-                    yLoop.End = -1;
-                }
+        /** @brief Decode image data
+         * @param stream Whole TGA file
+         * @param settings Loader settings
+         */
+        void Decode(uint8_t* stream, LoaderSettings* settings)
+        {
+            // Load file
+            uint8_t* data = stream;
+
+            // Load header, this is a bit complicated since the header not only is not aligned, but is also little endian
+            TgaHeader header;
+            header.ImageIdLength = *(data);
+            header.HasPalette = *(data + 1);
+            header.ImageType = *(data + 2);
+            header.Palette.PaletteStart = SRL::Endian::DeserializeUint16(data + 3);
+            header.Palette.PaletteLength = SRL::Endian::DeserializeUint16(data + 5);
+            header.Palette.PaletteColorDepth = *(data + 7);
+            header.Image.Origin.X = SRL::Endian::DeserializeUint16(data + 8);
+            header.Image.Origin.Y = SRL::Endian::DeserializeUint16(data + 10);
+            header.Image.Size.X = SRL::Endian::DeserializeUint16(data + 12);
+            header.Image.Size.Y = SRL::Endian::DeserializeUint16(data + 14);
+            header.Image.PixelColorDepth = *(data + 16);
+            header.Image.Descriptor.Value = *(data + 17);
+
+            // Lets check whether the header makes sense
+            if (header.Image.Size.X == 0 || header.Image.Size.Y == 0)
+            {
+                // Image has no size or is too big
+                SRL::Debug::Assert("Image has no size or is too big!\nWidth=%d\nHeight=%d", header.Image.Size.X, header.Image.Size.Y);
+            }
 
-                if (origin == TgaOrigin::TopLeft || origin == TgaOrigin::BottomLeft) {
-                    xLoop.Start = 0;
-                    xLoop.Step = 1;
-                    xLoop.End = this->width;
-                } else {
-                    xLoop.Start = this->width - 1;
-                    xLoop.Step = -1;
-                    xLoop.End = -1;
-                }
+            // Check format
+            if (!TGA::IsFormatValid(&header))
+            {
+                // We do not know how to read this type
+                SRL::Debug::Assert("Image is of unsupported type!");
+            }
 
-                // Data stream should now be pointing to after the header
-                switch (static_cast<TgaTypes>(header.ImageType))
-                {
-                case TGA::TgaTypes::TgaPaletted:
-                    this->palette = this->DecodePalette(stream, &header, settings->TransparentColorIndex);
-                    this->DecodePaletted(stream, &header, xLoop, yLoop);
-                    break;
+            // Set TGA object stuff
+            this->width = (size_t)header.Image.Size.X;
+            this->height = (size_t)header.Image.Size.Y;
+
+            // Pixel read order
+            uint8_t origin = header.Image.Descriptor.Data.Origin;
+            ForRange xLoop = { 0, 0, 0 };
+            ForRange yLoop = { 0, 0, 0 };
+
+            if (origin == TgaOrigin::TopLeft || origin == TgaOrigin::TopRight) {
+                yLoop.Start = 0; // start bottom, step upward
+                yLoop.Step = 1;
+                yLoop.End = this->height;
+            } else {
+                yLoop.Start = this->height - 1; // start at top, step downward
+                yLoop.Step = -1;
+                yLoop.End = -1;
+            }
 
-                case TGA::TgaTypes::TgaRlePaletted:
-                    this->palette = this->DecodePalette(stream, &header, settings->TransparentColorIndex);
-                    this->DecodeRlePaletted(stream, &header, xLoop, yLoop);
-                    break;
+            if (origin == TgaOrigin::TopLeft || origin == TgaOrigin::BottomLeft) {
+                xLoop.Start = 0;
+                xLoop.Step = 1;
+                xLoop.End = this->width;
+            } else {
+                xLoop.Start = this->width - 1;
+                xLoop.Step = -1;
+                xLoop.End = -1;
+            }
 
-                case TGA::TgaTypes::TgaTrueColor:
-                    this->DecodeTrueColor(stream, &header, xLoop, yLoop, settings->TransparentColor);
-                    break;
+            // Data stream should now be pointing to after the header
+            switch (static_cast<TgaTypes>(header.ImageType))
+            {
+            case TGA::TgaTypes::TgaPaletted:
+                this->palette = this->DecodePalette(stream, &header, settings->TransparentColorIndex);
+                this->DecodePaletted(stream, &header, xLoop, yLoop);
+                break;
 
-                case TGA::TgaTypes::TgaRleTrueColor:
-                    this->DecodeTrueColorRle(stream, &header, xLoop, yLoop, settings->TransparentColor);
-                    break;
+            case TGA::TgaTypes::TgaRlePaletted:
+                this->palette = this->DecodePalette(stream, &header, settings->TransparentColorIndex);
+                this->DecodeRlePaletted(stream, &header, xLoop, yLoop);
+                break;
 
-                default:
-                    SRL::Debug::Assert("Image is of unsupported type '%d'!\nCould not decode the image.", header.ImageType);
-                    break;
-                }
-            }
-            else
-            {
-                SRL::Debug::Assert("File size does not match!.");
-            }
+            case TGA::TgaTypes::TgaTrueColor:
+                this->DecodeTrueColor(stream, &header, xLoop, yLoop, settings->TransparentColor);
+                break;
 
-            // Clear allocated memory
-            delete stream;
+            case TGA::TgaTypes::TgaRleTrueColor:
+                this->DecodeTrueColorRle(stream, &header, xLoop, yLoop, settings->TransparentColor);
+                break;
+
+            default:
+                SRL::Debug::Assert("Image is of unsupported type '%d'!\nCould not decode the image.", header.ImageType);
+                break;
+            }
         }
 
     public:
@@ -798,6 +807,15 @@ namespace SRL::Bitmap
             this->LoadData(data, &settings);
         }
 
+        /** @brief Construct RGB555 TGA image from TGA file already loaded in memory
+         * @param data Whole TGA file
+         * @param settings TGA loader settings
+         */
+        TGA(uint8_t* data, TGA::LoaderSettings settings = TGA::LoaderSettings()) : imageData(nullptr), palette(nullptr)
+        {
+            this->Decode(data, &settings);
+        }
+
         /** @brief Construct RGB555 TGA image from file
          * @param filename TGA file name
          * @param settings TGA loader settings
@@ -216,8 +216,7 @@ namespace SRL
             if (id >= 0)
             {
                 // Copy data over to the VDP1
-                slDMACopy(data, VDP1::Textures[id].GetData(), dataSize);
-                slDMAWait();
+                Memory::Copy(VDP1::Textures[id].GetData(), data, dataSize);
                 return id;
             }
 
@@ -0,0 +1,822 @@
+// Host stand-in for the SGL file system (GFS) backed by a local directory
+// Implements the GFS functions used by saturnringlib/srl_cd.hpp. Directory tables work like on the console:
+// file identifiers are indexes into the current directory table, records point to files by their frame address.
+
+#include "gfs_host.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <strings.h>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+extern "C"
+{
+    #include <sega_gfs.h>
+}
+
+namespace
+{
+    /** @brief Allocator for host containers
+     * @details srl_memory.hpp replaces global new and delete with its zone allocators,
+     * tables of the stand-in must not take memory the loaders would have on the console
+     */
+    template<typename Type>
+    struct HostAllocator
+    {
+        using value_type = Type;
+
+        HostAllocator() = default;
+
+        template<typename Other>
+        HostAllocator(const HostAllocator<Other>&) { }
+
+        Type* allocate(size_t count)
+        {
+            return static_cast<Type*>(std::malloc(count * sizeof(Type)));
+        }
+
+        void deallocate(Type* ptr, size_t)
+        {
+            std::free(ptr);
+        }
+
+        template<typename Other>
+        bool operator==(const HostAllocator<Other>&) const
+        {
+            return true;
+        }
+    };
+
+    using HostString = std::basic_string<char, std::char_traits<char>, HostAllocator<char>>;
+
+    template<typename Type>
+    using HostVector = std::vector<Type, HostAllocator<Type>>;
+
+    /** @brief Frame address of the first directory (behind the ISO 9660 volume descriptors)
+     */
+    constexpr int32_t FirstFrame = 166;
+
+    /** @brief Frame address of the end of 74 minute disc
+     */
+    constexpr int32_t LastFrame = 333000;
+
+    /** @brief Maximal number of open files GFS supports
+     */
+    constexpr int32_t MaxHandles = 24;
+
+    /** @brief File or directory on the disc
+     */
+    struct Entry
+    {
+        /** @brief Path on the host
+         */
+        HostString Path;
+
+        /** @brief Name as stored in directory record
+         */
+        HostString Name;
+
+        /** @brief Frame address of the first sector
+         */
+        int32_t Frame;
+
+        /** @brief Size in bytes
+         */
+        int32_t Size;
+
+        /** @brief Entry is a directory
+         */
+        bool IsDirectory;
+
+        /** @brief Parent directory
+         */
+        int32_t Parent;
+
+        /** @brief Files and directories in the directory
+         */
+        HostVector<int32_t> Children;
+    };
+
+    /** @brief Open file
+     */
+    struct Handle
+    {
+        /** @brief Handle is used
+         */
+        bool Used;
+
+        /** @brief File entry
+         */
+        int32_t File;
+
+        /** @brief File identifier the file was opened with
+         */
+        int32_t Identifier;
+
+        /** @brief Access pointer in sectors
+         */
+        int32_t Position;
+
+        /** @brief Buffer of the background read
+         */
+        uint8_t* Destination;
+
+        /** @brief Number of sectors left to read in the background
+         */
+        int32_t Pending;
+
+        /** @brief Number of bytes background read can still write into the buffer
+         */
+        int32_t Space;
+
+        /** @brief Number of bytes transferred by the background read
+         */
+        int32_t Transferred;
+
+        /** @brief Host time the next sector of the background read arrives at (throttled mode)
+         */
+        std::chrono::steady_clock::time_point Arrival;
+    };
+
+    GfsHost::Settings settings;
+    GfsHost::Statistics statistics;
+    HostVector<Entry> entries;
+    std::unordered_map<int32_t, int32_t, std::hash<int32_t>, std::equal_to<int32_t>, HostAllocator<std::pair<const int32_t, int32_t>>> entryByFrame;
+    Handle handles[MaxHandles];
+    int32_t openMax = 0;
+    int32_t pickup = FirstFrame;
+    GfsDirTbl* current = nullptr;
+
+    /** @brief Measures time spent inside GFS function
+     */
+    struct HostTimer
+    {
+        std::chrono::steady_clock::time_point Start = std::chrono::steady_clock::now();
+
+        ~HostTimer()
+        {
+            statistics.HostNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->Start).count();
+        }
+    };
+
+    /** @brief Number of sectors taken by given number of bytes
+     */
+    int32_t ToSectors(const int64_t bytes)
+    {
+        return static_cast<int32_t>((bytes + settings.SectorSize - 1) / settings.SectorSize);
+    }
+
+    /** @brief Time in microseconds to read one sector
+     */
+    int64_t SectorTime()
+    {
+        return 1000000 / std::max(settings.SectorsPerSecond, 1);
+    }
+
+    /** @brief Move pickup to a frame
+     * @return Seek time in microseconds
+     */
+    int64_t Seek(const int32_t frame)
+    {
+        if (frame == pickup)
+        {
+            return 0;
+        }
+
+        const int64_t distance = std::abs(frame - pickup);
+        statistics.Seeks++;
+        pickup = frame;
+        return settings.MinimalSeek + ((settings.FullSeek - settings.MinimalSeek) * distance) / LastFrame;
+    }
+
+    /** @brief Count drive time of a read, in throttled mode wait for it
+     * @param frame Frame address of the first sector
+     * @param sectors Number of sectors read
+     * @param wait Sleep for the drive time
+     */
+    void Access(const int32_t frame, const int32_t sectors, const bool wait)
+    {
+        const int64_t time = Seek(frame) + (sectors * SectorTime());
+        pickup = frame + sectors;
+        statistics.Reads++;
+        statistics.Sectors += sectors;
+        statistics.DriveMicroseconds += time;
+
+        if (wait && settings.Throttle)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(time));
+        }
+    }
+
+    /** @brief Copy file data from the host file
+     * @return Number of bytes copied
+     */
+    int32_t Copy(const Entry& file, const int32_t sector, void* destination, const int32_t size)
+    {
+        const int64_t offset = static_cast<int64_t>(sector) * settings.SectorSize;
+        const int32_t length = static_cast<int32_t>(std::max<int64_t>(0, std::min<int64_t>(size, file.Size - offset)));
+        std::FILE* stream = std::fopen(file.Path.c_str(), "rb");
+
+        if (stream == nullptr)
+        {
+            return GFS_ERR_CDRD;
+        }
+
+        const bool success = std::fseek(stream, offset, SEEK_SET) == 0 &&
+            std::fread(destination, 1, length, stream) == static_cast<size_t>(length);
+
+        std::fclose(stream);
+        return success ? length : GFS_ERR_CDRD;
+    }
+
+    /** @brief Gets record of a file in the current directory table
+     * @return Record or nullptr if identifier is not valid
+     */
+    CdcFile* GetRecord(const int32_t fid)
+    {
+        if (current == nullptr || fid < 0 || fid >= GFS_DIRTBL_NDIR(current))
+        {
+            return nullptr;
+        }
+
+        if (GFS_DIRTBL_TYPE(current) == GFS_DIR_NAME)
+        {
+            return &GFS_DIR_REC(&GFS_DIRTBL_DIRNAME(current)[fid]);
+        }
+
+        return &GFS_DIR_REC(&GFS_DIRTBL_DIRID(current)[fid]);
+    }
+
+    /** @brief Gets entry of a file in the current directory table
+     * @return Entry index or -1 if identifier is not valid
+     */
+    int32_t GetEntry(const int32_t fid)
+    {
+        const CdcFile* record = GetRecord(fid);
+
+        if (record == nullptr)
+        {
+            return -1;
+        }
+
+        const auto found = entryByFrame.find(CDC_FILE_FAD(record));
+        return found != entryByFrame.end() ? found->second : -1;
+    }
+
+    /** @brief Gets open file
+     * @return Handle or nullptr if handle is not valid
+     */
+    Handle* GetHandle(GfsHn gfs)
+    {
+        Handle* handle = reinterpret_cast<Handle*>(gfs);
+        return handle >= handles && handle < handles + MaxHandles && handle->Used ? handle : nullptr;
+    }
+
+    /** @brief Fill directory table with records of a directory
+     * @return Number of records
+     */
+    int32_t FillTable(const int32_t directory, GfsDirTbl* table)
+    {
+        const Entry& entry = entries[directory];
+        HostVector<int32_t> records = { directory, entry.Parent };
+        records.insert(records.end(), entry.Children.begin(), entry.Children.end());
+
+        const int32_t count = std::min<int32_t>(records.size(), GFS_DIRTBL_NDIR(table));
+
+        for (int32_t index = 0; index < count; index++)
+        {
+            const Entry& record = entries[records[index]];
+            CdcFile file = {};
+            file.fad = record.Frame;
+            file.size = record.Size;
+            file.atr = (record.IsDirectory ? GFS_ATR_DIR : GFS_ATR_FORM1) | (index == count - 1 ? GFS_ATR_END_TBL : 0);
+
+            if (GFS_DIRTBL_TYPE(table) == GFS_DIR_NAME)
+            {
+                GfsDirName& name = GFS_DIRTBL_DIRNAME(table)[index];
+                name.dirrec = file;
+                std::memset(name.fname, 0, GFS_FNAME_LEN);
+
+                // Current and parent directory are named 0x00 and 0x01 on ISO 9660 disc
+                if (index == 1)
+                {
+                    name.fname[0] = 1;
+                }
+                else if (index > 1)
+                {
+                    std::memcpy(name.fname, record.Name.c_str(), std::min<size_t>(record.Name.size(), GFS_FNAME_LEN));
+                }
+            }
+            else
+            {
+                GFS_DIRTBL_DIRID(table)[index].dirrec = file;
+            }
+        }
+
+        return count;
+    }
+
+    /** @brief Add directory and everything in it
+     * @return Entry index
+     */
+    int32_t Scan(const HostString& path, const HostString& name, const int32_t parent)
+    {
+        const int32_t index = entries.size();
+        entries.push_back({ path, name, 0, settings.SectorSize, true, parent < 0 ? index : parent, {} });
+
+        DIR* directory = opendir(path.c_str());
+
+        if (directory == nullptr)
+        {
+            return index;
+        }
+
+        HostVector<std::pair<HostString, HostString>> children;
+
+        for (dirent* item = readdir(directory); item != nullptr; item = readdir(directory))
+        {
+            HostString childName = item->d_name;
+
+            if (childName == "." || childName == "..")
+            {
+                continue;
+            }
+
+            if (childName.size() > GFS_FNAME_LEN)
+            {
+                std::fprintf(stderr, "gfs_host: '%s/%s' skipped, name is longer than %d characters\n", path.c_str(), childName.c_str(), GFS_FNAME_LEN);
+                continue;
+            }
+
+            std::transform(childName.begin(), childName.end(), childName.begin(), [](unsigned char character) { return std::toupper(character); });
+            children.emplace_back(childName, path + "/" + item->d_name);
+        }
+
+        closedir(directory);
+
+        // Records are sorted by name on ISO 9660 disc
+        std::sort(children.begin(), children.end());
+
+        for (const auto& [childName, childPath] : children)
+        {
+            struct stat info;
+
+            if (stat(childPath.c_str(), &info) != 0)
+            {
+                continue;
+            }
+
+            int32_t child;
+
+            if (S_ISDIR(info.st_mode))
+            {
+                child = Scan(childPath, childName, index);
+            }
+            else
+            {
+                child = entries.size();
+                entries.push_back({ childPath, childName + ";1", 0, static_cast<int32_t>(info.st_size), false, index, {} });
+            }
+
+            entries[index].Children.push_back(child);
+        }
+
+        return index;
+    }
+}
+
+namespace GfsHost
+{
+    bool Mount(const char* directory, const Settings& driveSettings)
+    {
+        struct stat info;
+
+        if (stat(directory, &info) != 0 || !S_ISDIR(info.st_mode))
+        {
+            return false;
+        }
+
+        settings = driveSettings;
+        entries.clear();
+        entryByFrame.clear();
+        Scan(directory, "", -1);
+
+        // Directories go first, files follow in the order of directory records
+        int32_t frame = FirstFrame;
+
+        for (Entry& entry : entries)
+        {
+            if (entry.IsDirectory)
+            {
+                entry.Frame = frame++;
+            }
+        }
+
+        for (Entry& entry : entries)
+        {
+            if (!entry.IsDirectory)
+            {
+                entry.Frame = frame;
+                frame += std::max(ToSectors(entry.Size), 1);
+            }
+        }
+
+        for (int32_t index = 0; index < static_cast<int32_t>(entries.size()); index++)
+        {
+            entryByFrame[entries[index].Frame] = index;
+        }
+
+        pickup = FirstFrame;
+        current = nullptr;
+        ResetStatistics();
+        return true;
+    }
+
+    const Statistics& GetStatistics()
+    {
+        return statistics;
+    }
+
+    void ResetStatistics()
+    {
+        statistics = {};
+    }
+}
+
+extern "C"
+{
+    int32_t GFS_Init(int32_t open_max, [[maybe_unused]] void* work, GfsDirTbl* dirtbl)
+    {
+        HostTimer timer;
+
+        if (entries.empty())
+        {
+            return GFS_ERR_CDNODISC;
+        }
+        else if (open_max <= 0 || open_max > MaxHandles)
+        {
+            return GFS_ERR_OPENMAX;
+        }
+
+        openMax = open_max;
+
+        for (Handle& handle : handles)
+        {
+            handle.Used = false;
+        }
+
+        current = dirtbl;
+        Access(entries[0].Frame, 1, true);
+        FillTable(0, dirtbl);
+
+        // SRL::Cd::Initialize() only tests for success
+        return GFS_ERR_OK;
+    }
+
+    int32_t GFS_LoadDir(int32_t fid, GfsDirTbl* dirtbl)
+    {
+        HostTimer timer;
+
+        // Negative identifier loads root directory, SRL::Cd::ChangeDir(nullptr) relies on it
+        const int32_t entry = fid < 0 ? 0 : GetEntry(fid);
+
+        if (entry < 0)
+        {
+            return GFS_ERR_FID;
+        }
+        else if (!entries[entry].IsDirectory)
+        {
+            return GFS_ERR_DIR;
+        }
+
+        Access(entries[entry].Frame, 1, true);
+        return FillTable(entry, dirtbl);
+    }
+
+    int32_t GFS_SetDir(GfsDirTbl* dirtbl)
+    {
+        current = dirtbl;
+        return GFS_ERR_OK;
+    }
+
+    int32_t GFS_NameToId(int8_t* fname)
+    {
+        if (fname == nullptr)
+        {
+            return GFS_ERR_NONAME;
+        }
+        else if (current == nullptr || GFS_DIRTBL_TYPE(current) != GFS_DIR_NAME)
+        {
+            return GFS_ERR_DIRTBL;
+        }
+
+        const char* name = reinterpret_cast<const char*>(fname);
+        const size_t length = std::strcspn(name, ";");
+
+        for (int32_t fid = 0; fid < GFS_DIRTBL_NDIR(current); fid++)
+        {
+            const char* record = reinterpret_cast<const char*>(GFS_DIRTBL_DIRNAME(current)[fid].fname);
+            size_t recordLength = 0;
+
+            // Names filling the whole record are not terminated
+            while (recordLength < GFS_FNAME_LEN && record[recordLength] != '\0' && record[recordLength] != ';')
+            {
+                recordLength++;
+            }
+
+            if (recordLength == length && strncasecmp(record, name, length) == 0)
+            {
+                return fid;
+            }
+
+            if ((GFS_DIR_ATR(&GFS_DIRTBL_DIRNAME(current)[fid]) & GFS_ATR_END_TBL) != 0)
+            {
+                break;
+            }
+        }
+
+        return GFS_ERR_NEXIST;
+    }
+
+    int8_t* GFS_IdToName(int32_t fid)
+    {
+        if (GetRecord(fid) == nullptr || GFS_DIRTBL_TYPE(current) != GFS_DIR_NAME)
+        {
+            return nullptr;
+        }
+
+        return GFS_DIRTBL_DIRNAME(current)[fid].fname;
+    }
+
+    int32_t GFS_GetDirInfo(int32_t fid, GfsDirId* dirrec)
+    {
+        const CdcFile* record = GetRecord(fid);
+
+        if (record == nullptr)
+        {
+            return GFS_ERR_FID;
+        }
+
+        dirrec->dirrec = *record;
+        return GFS_ERR_OK;
+    }
+
+    GfsHn GFS_Open(int32_t fid)
+    {
+        HostTimer timer;
+        const int32_t entry = GetEntry(fid);
+
+        if (entry < 0 || entries[entry].IsDirectory)
+        {
+            return nullptr;
+        }
+
+        for (int32_t index = 0; index < openMax; index++)
+        {
+            if (!handles[index].Used)
+            {
+                handles[index] = { true, entry, fid, 0, nullptr, 0, 0, 0, {} };
+                return reinterpret_cast<GfsHn>(&handles[index]);
+            }
+        }
+
+        return nullptr;
+    }
+
+    void GFS_Close(GfsHn gfs)
+    {
+        Handle* handle = GetHandle(gfs);
+
+        if (handle != nullptr)
+        {
+            handle->Used = false;
+        }
+    }
+
+    int32_t GFS_Seek(GfsHn gfs, int32_t ofs, int32_t org)
+    {
+        Handle* handle = GetHandle(gfs);
+
+        if (handle == nullptr)
+        {
+            return GFS_ERR_HNDL;
+        }
+
+        const int32_t sectors = ToSectors(entries[handle->File].Size);
+        int32_t position;
+
+        switch (org)
+        {
+        case GFS_SEEK_SET:
+            position = ofs;
+            break;
+
+        case GFS_SEEK_CUR:
+            position = handle->Position + ofs;
+            break;
+
+        case GFS_SEEK_END:
+            position = sectors + ofs;
+            break;
+
+        default:
+            return GFS_ERR_ORG;
+        }
+
+        if (position < 0 || position > sectors)
+        {
+            return GFS_ERR_SEEK;
+        }
+
+        handle->Position = position;
+        return position;
+    }
+
+    int32_t GFS_Tell(GfsHn gfs)
+    {
+        Handle* handle = GetHandle(gfs);
+        return handle != nullptr ? handle->Position : GFS_ERR_HNDL;
+    }
+
+    bool GFS_IsEof(GfsHn gfs)
+    {
+        Handle* handle = GetHandle(gfs);
+        return handle == nullptr || handle->Position >= ToSectors(entries[handle->File].Size);
+    }
+
+    int32_t GFS_ByteToSct(GfsHn gfs, int32_t nbyte)
+    {
+        return GetHandle(gfs) != nullptr ? ToSectors(nbyte) : GFS_ERR_HNDL;
+    }
+
+    void GFS_GetFileSize(GfsHn gfs, int32_t* sctsz, int32_t* nsct, int32_t* lstsz)
+    {
+        Handle* handle = GetHandle(gfs);
+        const int32_t size = handle != nullptr ? entries[handle->File].Size : 0;
+        const int32_t sectors = ToSectors(size);
+
+        if (sctsz != nullptr) *sctsz = settings.SectorSize;
+        if (nsct != nullptr) *nsct = sectors;
+        if (lstsz != nullptr) *lstsz = size - ((sectors - 1) * settings.SectorSize);
+    }
+
+    void GFS_GetFileInfo(GfsHn gfs, int32_t* fid, int32_t* fn, int32_t* fsize, int32_t* atr)
+    {
+        Handle* handle = GetHandle(gfs);
+
+        if (handle != nullptr)
+        {
+            if (fid != nullptr) *fid = handle->Identifier;
+            if (fn != nullptr) *fn = 0;
+            if (fsize != nullptr) *fsize = entries[handle->File].Size;
+            if (atr != nullptr) *atr = GFS_ATR_FORM1;
+        }
+    }
+
+    int32_t GFS_Fread(GfsHn gfs, int32_t nsct, void* buf, int32_t bsize)
+    {
+        HostTimer timer;
+        Handle* handle = GetHandle(gfs);
+
+        if (handle == nullptr)
+        {
+            return GFS_ERR_HNDL;
+        }
+        else if (handle->Pending > 0)
+        {
+            return GFS_ERR_FBUSY;
+        }
+
+        const Entry& file = entries[handle->File];
+        const int32_t size = bsize == GFS_BUFSIZ_INF ? nsct * settings.SectorSize : std::min(nsct * settings.SectorSize, bsize);
+        const int32_t read = Copy(file, handle->Position, buf, size);
+
+        if (read > 0)
+        {
+            Access(file.Frame + handle->Position, ToSectors(read), true);
+            handle->Position += ToSectors(read);
+        }
+
+        return read;
+    }
+
+    int32_t GFS_Load(int32_t fid, int32_t ofs, void* buf, int32_t bsize)
+    {
+        HostTimer timer;
+        const int32_t entry = GetEntry(fid);
+
+        if (entry < 0 || entries[entry].IsDirectory)
+        {
+            return GFS_ERR_FID;
+        }
+
+        const Entry& file = entries[entry];
+        const int32_t size = bsize == GFS_BUFSIZ_INF ? file.Size : bsize;
+        const int32_t read = Copy(file, ofs, buf, size);
+
+        if (read > 0)
+        {
+            Access(file.Frame + ofs, ToSectors(read), true);
+        }
+
+        return read;
+    }
+
+    int32_t GFS_NwFread(GfsHn gfs, int32_t nsct, void* buf, int32_t bsize)
+    {
+        HostTimer timer;
+        Handle* handle = GetHandle(gfs);
+
+        if (handle == nullptr)
+        {
+            return GFS_ERR_HNDL;
+        }
+        else if (handle->Pending > 0)
+        {
+            return GFS_ERR_FBUSY;
+        }
+
+        const Entry& file = entries[handle->File];
+        handle->Destination = reinterpret_cast<uint8_t*>(buf);
+        handle->Pending = std::min(nsct, ToSectors(file.Size) - handle->Position);
+        handle->Space = bsize == GFS_BUFSIZ_INF ? handle->Pending * settings.SectorSize : bsize;
+        handle->Transferred = 0;
+
+        // Data start arriving after the seek
+        const int64_t seek = Seek(file.Frame + handle->Position);
+        statistics.DriveMicroseconds += seek;
+        handle->Arrival = std::chrono::steady_clock::now() + std::chrono::microseconds(seek + SectorTime());
+        return GFS_ERR_OK;
+    }
+
+    int32_t GFS_NwExecOne(GfsHn gfs)
+    {
+        HostTimer timer;
+        Handle* handle = GetHandle(gfs);
+
+        if (handle == nullptr)
+        {
+            return GFS_ERR_HNDL;
+        }
+
+        const Entry& file = entries[handle->File];
+        const auto now = std::chrono::steady_clock::now();
+
+        // Without throttling everything arrives at once, otherwise only sectors the drive would have read by now
+        while (handle->Pending > 0 && (!settings.Throttle || handle->Arrival <= now))
+        {
+            const int32_t size = std::min(settings.SectorSize, handle->Space - handle->Transferred);
+            const int32_t read = size > 0 ? Copy(file, handle->Position, handle->Destination + handle->Transferred, size) : 0;
+
+            if (read < 0)
+            {
+                handle->Pending = 0;
+                return read;
+            }
+
+            Access(file.Frame + handle->Position, 1, false);
+            handle->Transferred += read;
+            handle->Position++;
+            handle->Pending--;
+            handle->Arrival += std::chrono::microseconds(SectorTime());
+        }
+
+        return GFS_ERR_OK;
+    }
+
+    bool GFS_NwIsComplete(GfsHn gfs)
+    {
+        Handle* handle = GetHandle(gfs);
+        return handle == nullptr || handle->Pending == 0;
+    }
+
+    int32_t GFS_NwStop(GfsHn gfs)
+    {
+        Handle* handle = GetHandle(gfs);
+
+        if (handle == nullptr)
+        {
+            return GFS_ERR_HNDL;
+        }
+
+        handle->Pending = 0;
+        return GFS_ERR_OK;
+    }
+
+    void GFS_NwGetStat(GfsHn gfs, int32_t* amode, int32_t* ndata)
+    {
+        Handle* handle = GetHandle(gfs);
+
+        if (amode != nullptr) *amode = handle != nullptr && handle->Pending > 0 ? GFS_NWSTAT_FREAD : GFS_NWSTAT_NOACT;
+        if (ndata != nullptr) *ndata = handle != nullptr ? handle->Transferred : 0;
+    }
+}
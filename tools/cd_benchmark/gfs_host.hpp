@@ -0,0 +1,79 @@
+#pragma once
+
+// Host stand-in for the SGL file system (GFS) backed by a local directory
+// Directory is laid out as a disc: every file gets a frame address, reads are timed by a simple drive model
+// (seek time growing with distance of the pickup, fixed transfer rate), so loaders can be run and measured on the host.
+
+#include <cstdint>
+
+namespace GfsHost
+{
+    /** @brief Drive model
+     */
+    struct Settings
+    {
+        /** @brief Number of bytes in a sector (2048 for Mode 1 / Mode 2 Form 1)
+         */
+        int32_t SectorSize = 2048;
+
+        /** @brief Number of sectors read per second (150 for double speed drive)
+         */
+        int32_t SectorsPerSecond = 150;
+
+        /** @brief Time of the shortest seek in microseconds
+         */
+        int32_t MinimalSeek = 20000;
+
+        /** @brief Time of the seek across the whole disc in microseconds
+         */
+        int32_t FullSeek = 300000;
+
+        /** @brief Sleep for the simulated time, so reads take as long as on the console
+         * @details When disabled, simulated time is only counted
+         */
+        bool Throttle = false;
+    };
+
+    /** @brief Drive statistics
+     */
+    struct Statistics
+    {
+        /** @brief Number of reads (GFS_Fread(), GFS_Load() and transfers of GFS_NwFread())
+         */
+        uint64_t Reads;
+
+        /** @brief Number of times pickup had to move
+         */
+        uint64_t Seeks;
+
+        /** @brief Number of sectors read
+         */
+        uint64_t Sectors;
+
+        /** @brief Time the drive would need on the console in microseconds
+         */
+        uint64_t DriveMicroseconds;
+
+        /** @brief Time spent inside GFS functions on the host in nanoseconds (file access, copying, throttling)
+         */
+        uint64_t HostNanoseconds;
+    };
+
+    /** @brief Use a directory as the disc
+     * @note Names are turned to upper case, file names get ";1" version like on ISO 9660 disc.
+     * Names longer than GFS_FNAME_LEN characters are skipped.
+     * @param directory Root directory of the disc
+     * @param settings Drive model
+     * @return false if directory cannot be read
+     */
+    bool Mount(const char* directory, const Settings& settings = Settings());
+
+    /** @brief Gets drive statistics
+     * @return Statistics since last reset
+     */
+    const Statistics& GetStatistics();
+
+    /** @brief Reset drive statistics
+     */
+    void ResetStatistics();
+}
@@ -0,0 +1,465 @@
+// Host benchmark of CD loaders
+// Runs SRL file loaders and decoders against a directory served by the GFS stand-in (gfs_host.cxx).
+// Time spent in file access is measured separately from decoding, drive time on the console is estimated by the drive model.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <pthread.h>
+#include <strings.h>
+#include <sys/mman.h>
+
+#include "gfs_host.hpp"
+
+#include <srl_cd.hpp>
+#include <srl_tga.hpp>
+#include <srl_sound.hpp>
+#include <srl_tilemap_interfaces.hpp>
+
+extern "C"
+{
+    // DMA transfer table of SGL work area, memory is cleared from the end of the heap up to it
+    const void* TransList = reinterpret_cast<const void*>(0x060FB800);
+
+    // SGL functions used by the memory copy routines, DMA is done by the CPU here
+    void slDMACopy(void* source, void* destination, uint32_t size)
+    {
+        memcpy(destination, source, size);
+    }
+
+    void slDMAXCopy(void* source, void* destination, uint32_t count, [[maybe_unused]] uint16_t mode)
+    {
+        // Only fixed source and incrementing destination with long units is used (Sfix_Dinc_Long)
+        for (uint32_t word = 0; word < count; word++)
+        {
+            memcpy(reinterpret_cast<uint32_t*>(destination) + word, source, sizeof(uint32_t));
+        }
+    }
+
+    void slDMAWait()
+    {
+    }
+
+    bool slDMAStatus()
+    {
+        return false;
+    }
+
+    void slCashPurge()
+    {
+    }
+}
+
+namespace SRL
+{
+    /** @brief Console memory map on the host
+     * @details Loaders pick memory zone by address of the object they are called on (autonew),
+     * so work RAM is mapped at the console addresses and loaders run on a stack inside high work RAM.
+     * Heap limits come from the linker (_heap_start, _heap_end), same as on the console.
+     */
+    struct ConsoleMemory
+    {
+        /** @brief High work RAM
+         */
+        static constexpr uintptr_t HighWorkRam = 0x06000000;
+
+        /** @brief Low work RAM
+         */
+        static constexpr uintptr_t LowWorkRam = 0x00200000;
+
+        /** @brief Size of each work RAM
+         */
+        static constexpr size_t WorkRamSize = 0x100000;
+
+        /** @brief Page with identifier of the expansion cart (reads as no cart)
+         */
+        static constexpr uintptr_t CartIdPage = 0x24FFF000;
+
+        /** @brief Stack of the loaders takes place of the program image, which lives in the host address space here
+         */
+        static constexpr uintptr_t Stack = 0x06004000;
+
+        /** @brief Stack size, up to the start of the heap
+         */
+        static constexpr size_t StackSize = 0x1C000;
+
+        /** @brief Map memory at fixed address
+         * @return true on success
+         */
+        static bool Map(const uintptr_t address, const size_t size)
+        {
+            void* mapped = mmap(reinterpret_cast<void*>(address), size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+            return mapped == reinterpret_cast<void*>(address);
+        }
+
+        /** @brief Map work RAM and initialize memory zones
+         * @return true on success
+         */
+        static bool Initialize()
+        {
+            if (!ConsoleMemory::Map(ConsoleMemory::HighWorkRam, ConsoleMemory::WorkRamSize) ||
+                !ConsoleMemory::Map(ConsoleMemory::LowWorkRam, ConsoleMemory::WorkRamSize) ||
+                !ConsoleMemory::Map(ConsoleMemory::CartIdPage, 0x1000))
+            {
+                return false;
+            }
+
+            Memory::Initialize();
+            return true;
+        }
+    };
+
+    /** @brief Measured load of a single file
+     */
+    struct LoadResult
+    {
+        /** @brief Loader did its job
+         */
+        bool Success = true;
+
+        /** @brief Host time of the whole load in nanoseconds
+         */
+        uint64_t Total = 0;
+
+        /** @brief Drive statistics of the load
+         */
+        GfsHost::Statistics Drive = {};
+    };
+
+    /** @brief Loader of one file type
+     */
+    struct Loader
+    {
+        /** @brief File extension (upper case)
+         */
+        const char* Extension;
+
+        /** @brief Loader name
+         */
+        const char* Name;
+
+        /** @brief Load file from current directory
+         * @return true on success
+         */
+        bool (*Load)(const char* name);
+    };
+
+    class CdBenchmark
+    {
+    private:
+
+        /** @brief Load file into work RAM without decoding it
+         */
+        static bool LoadRaw(const char* name)
+        {
+            Cd::File file(name);
+            uint8_t* data = new uint8_t[file.Size.Bytes];
+            const bool success = data != nullptr && file.LoadBytes(0, file.Size.Bytes, data) == file.Size.Bytes;
+            delete[] data;
+            return success;
+        }
+
+        /** @brief Load and decode TGA image
+         */
+        static bool LoadTga(const char* name)
+        {
+            // Loader stack is in high work RAM, so image data are allocated there
+            Bitmap::TGA image(name);
+            return image.GetData() != nullptr;
+        }
+
+        /** @brief Wave sound telling whether samples were loaded
+         */
+        struct WaveSound : public Sound::Pcm::WaveSound
+        {
+            using Sound::Pcm::WaveSound::WaveSound;
+
+            bool IsLoaded() const
+            {
+                return this->data != nullptr;
+            }
+        };
+
+        /** @brief Load and convert wave sound
+         */
+        static bool LoadWave(const char* name)
+        {
+            CdBenchmark::WaveSound sound(name);
+            return sound.IsLoaded();
+        }
+
+        /** @brief Load CubeTile tilemap
+         */
+        static bool LoadCubeTile(const char* name)
+        {
+            Tilemap::Interfaces::CubeTile tilemap(name);
+            return tilemap.GetCellData() != nullptr;
+        }
+
+        /** @brief Known loaders, raw load is used for unknown extensions
+         * @note CubeTile files have no extension of their own, their loader has to be picked by --loader option
+         */
+        inline static const Loader loaders[] = {
+            { "", "Raw", CdBenchmark::LoadRaw },
+            { "TGA", "TGA", CdBenchmark::LoadTga },
+            { "WAV", "Wave", CdBenchmark::LoadWave },
+            { "", "CubeTile", CdBenchmark::LoadCubeTile },
+        };
+
+        /** @brief Files to load
+         */
+        inline static char** files = nullptr;
+
+        /** @brief Loader of each file (nullptr to pick by extension)
+         */
+        inline static const Loader** fileLoaders = nullptr;
+
+        /** @brief Number of files to load
+         */
+        inline static int fileCount = 0;
+
+        /** @brief Number of loads of each file
+         */
+        inline static int repeat = 1;
+
+        /** @brief Benchmark succeeded
+         */
+        inline static bool success = true;
+
+        /** @brief Pick loader by file extension
+         */
+        static const Loader& GetLoader(const char* name)
+        {
+            const char* extension = strrchr(name, '.');
+
+            for (const Loader& loader : CdBenchmark::loaders)
+            {
+                if (extension != nullptr && loader.Extension[0] != '\0' && strcasecmp(extension + 1, loader.Extension) == 0)
+                {
+                    return loader;
+                }
+            }
+
+            return CdBenchmark::loaders[0];
+        }
+
+        /** @brief Load file given by path from the root of the disc
+         * @param path Path separated by '/'
+         * @param loader Loader to use
+         * @return Measured load
+         */
+        static LoadResult Run(const char* path, const Loader& loader)
+        {
+            char name[256];
+            std::snprintf(name, sizeof(name), "%s", path);
+
+            // Enter directories of the path
+            char* fileName = name;
+            Cd::ChangeDir(static_cast<const char*>(nullptr));
+
+            for (char* separator = strchr(fileName, '/'); separator != nullptr; separator = strchr(fileName, '/'))
+            {
+                *separator = '\0';
+                Cd::ChangeDir(fileName);
+                fileName = separator + 1;
+            }
+
+            LoadResult result;
+
+            if (!Cd::File(fileName).Exists())
+            {
+                result.Success = false;
+                return result;
+            }
+
+            GfsHost::ResetStatistics();
+            const auto start = std::chrono::steady_clock::now();
+            result.Success = loader.Load(fileName);
+            result.Total = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+            result.Drive = GfsHost::GetStatistics();
+            return result;
+        }
+
+        /** @brief Load all files and print results
+         */
+        static void* Main(void*)
+        {
+            std::printf("%-24s %-8s %10s %10s %10s %10s %6s %6s %8s\n",
+                "File", "Loader", "Total us", "File us", "Decode us", "Drive ms", "Reads", "Seeks", "Sectors");
+
+            for (int index = 0; index < CdBenchmark::fileCount; index++)
+            {
+                const Loader& loader = CdBenchmark::fileLoaders[index] != nullptr ?
+                    *CdBenchmark::fileLoaders[index] :
+                    CdBenchmark::GetLoader(CdBenchmark::files[index]);
+                LoadResult sum;
+
+                for (int pass = 0; pass < CdBenchmark::repeat && sum.Success; pass++)
+                {
+                    const LoadResult result = CdBenchmark::Run(CdBenchmark::files[index], loader);
+                    sum.Success = result.Success;
+                    sum.Total += result.Total;
+                    sum.Drive.Reads += result.Drive.Reads;
+                    sum.Drive.Seeks += result.Drive.Seeks;
+                    sum.Drive.Sectors += result.Drive.Sectors;
+                    sum.Drive.DriveMicroseconds += result.Drive.DriveMicroseconds;
+                    sum.Drive.HostNanoseconds += result.Drive.HostNanoseconds;
+                }
+
+                if (!sum.Success)
+                {
+                    std::printf("%-24s %-8s failed\n", CdBenchmark::files[index], loader.Name);
+                    CdBenchmark::success = false;
+                    continue;
+                }
+
+                // Time spent outside of the GFS stand-in is the cost of the loader itself
+                const uint64_t count = CdBenchmark::repeat;
+                const uint64_t file = sum.Drive.HostNanoseconds / count;
+                const uint64_t total = sum.Total / count;
+
+                std::printf("%-24s %-8s %10.1f %10.1f %10.1f %10.1f %6lu %6lu %8lu\n",
+                    CdBenchmark::files[index],
+                    loader.Name,
+                    total / 1000.0,
+                    file / 1000.0,
+                    (total - std::min(file, total)) / 1000.0,
+                    sum.Drive.DriveMicroseconds / (count * 1000.0),
+                    static_cast<unsigned long>(sum.Drive.Reads / count),
+                    static_cast<unsigned long>(sum.Drive.Seeks / count),
+                    static_cast<unsigned long>(sum.Drive.Sectors / count));
+            }
+
+            return nullptr;
+        }
+
+    public:
+
+        /** @brief Find loader by name
+         * @param name Loader name
+         * @return Loader or nullptr if there is no such loader
+         */
+        static const Loader* FindLoader(const char* name)
+        {
+            for (const Loader& loader : CdBenchmark::loaders)
+            {
+                if (strcasecmp(name, loader.Name) == 0)
+                {
+                    return &loader;
+                }
+            }
+
+            return nullptr;
+        }
+
+        /** @brief Run benchmark on the console stack
+         * @param paths Files to load
+         * @param pathLoaders Loader of each file (nullptr to pick by extension)
+         * @param count Number of files
+         * @param passes Number of loads of each file
+         * @return true if all files were loaded
+         */
+        static bool Start(char** paths, const Loader** pathLoaders, const int count, const int passes)
+        {
+            CdBenchmark::files = paths;
+            CdBenchmark::fileLoaders = pathLoaders;
+            CdBenchmark::fileCount = count;
+            CdBenchmark::repeat = passes;
+
+            pthread_attr_t attributes;
+            pthread_t thread;
+            pthread_attr_init(&attributes);
+            pthread_attr_setstack(&attributes, reinterpret_cast<void*>(ConsoleMemory::Stack), ConsoleMemory::StackSize);
+
+            if (pthread_create(&thread, &attributes, CdBenchmark::Main, nullptr) != 0)
+            {
+                std::fprintf(stderr, "Loader thread could not be started\n");
+                return false;
+            }
+
+            pthread_join(thread, nullptr);
+            pthread_attr_destroy(&attributes);
+            return CdBenchmark::success;
+        }
+    };
+}
+
+static void PrintUsage(const char* program)
+{
+    std::fprintf(stderr,
+        "Usage: %s <directory> [options] <file>...\n"
+        "  <directory>          directory used as the disc\n"
+        "  <file>               path from the root of the disc (DIR/FILE.TGA)\n"
+        "  --loader <name>      load following files with Raw, TGA, Wave or CubeTile loader (Auto picks by extension)\n"
+        "  --repeat <count>     load each file count times, results are averaged\n"
+        "  --speed <factor>     drive speed (1 single, 2 double speed)\n"
+        "  --throttle           wait for the drive, loads take as long as on the console\n",
+        program);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    // Global new takes memory from console zones, host tables use the C heap
+    GfsHost::Settings settings;
+    char** files = static_cast<char**>(std::calloc(argc, sizeof(char*)));
+    const SRL::Loader** loaders = static_cast<const SRL::Loader**>(std::calloc(argc, sizeof(SRL::Loader*)));
+    const SRL::Loader* loader = nullptr;
+    int fileCount = 0;
+    int repeat = 1;
+
+    for (int index = 2; index < argc; index++)
+    {
+        if (strcmp(argv[index], "--loader") == 0 && index + 1 < argc)
+        {
+            index++;
+            loader = SRL::CdBenchmark::FindLoader(argv[index]);
+
+            if (loader == nullptr && strcasecmp(argv[index], "Auto") != 0)
+            {
+                PrintUsage(argv[0]);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[index], "--repeat") == 0 && index + 1 < argc)
+        {
+            repeat = std::max(std::atoi(argv[++index]), 1);
+        }
+        else if (strcmp(argv[index], "--speed") == 0 && index + 1 < argc)
+        {
+            settings.SectorsPerSecond = 75 * std::max(std::atoi(argv[++index]), 1);
+        }
+        else if (strcmp(argv[index], "--throttle") == 0)
+        {
+            settings.Throttle = true;
+        }
+        else
+        {
+            loaders[fileCount] = loader;
+            files[fileCount++] = argv[index];
+        }
+    }
+
+    if (!SRL::ConsoleMemory::Initialize())
+    {
+        std::fprintf(stderr, "Console memory map could not be created\n");
+        return 1;
+    }
+
+    if (!GfsHost::Mount(argv[1], settings) || !SRL::Cd::Initialize())
+    {
+        std::fprintf(stderr, "Directory '%s' could not be mounted\n", argv[1]);
+        return 1;
+    }
+
+    std::printf("Disc: %s, drive %dx, %s\n\n", argv[1], settings.SectorsPerSecond / 75, settings.Throttle ? "throttled" : "not throttled");
+    const bool success = SRL::CdBenchmark::Start(files, loaders, fileCount, repeat);
+    std::free(files);
+    std::free(loaders);
+    return success ? 0 : 1;
+}
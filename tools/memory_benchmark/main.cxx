@@ -0,0 +1,485 @@
+// Host benchmark of SRL memory allocators
+// Replays allocation traces recorded by SRL::Logger::LogMemoryTrace() (or a synthetic workload) against every allocator
+// on fake memory zones and reports throughput, worst case latency and fragmentation.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <srl_memory.hpp>
+
+extern "C"
+{
+    // SGL functions used by the memory copy routines, DMA is done by the CPU here
+    void slDMACopy(void* source, void* destination, uint32_t size)
+    {
+        std::memcpy(destination, source, size);
+    }
+
+    void slDMAXCopy(void* source, void* destination, uint32_t count, [[maybe_unused]] uint16_t mode)
+    {
+        // Only fixed source and incrementing destination with long units is used (Sfix_Dinc_Long)
+        for (uint32_t word = 0; word < count; word++)
+        {
+            std::memcpy(reinterpret_cast<uint32_t*>(destination) + word, source, sizeof(uint32_t));
+        }
+    }
+
+    void slDMAWait()
+    {
+    }
+
+    bool slDMAStatus()
+    {
+        return false;
+    }
+
+    void slCashPurge()
+    {
+    }
+}
+
+/** @brief Allocator for host containers
+ * @details srl_memory.hpp replaces global new and delete with its zone allocators, which do not exist on the host,
+ * so containers of the benchmark itself take memory from the C heap
+ */
+template<typename Type>
+struct HostAllocator
+{
+    using value_type = Type;
+
+    HostAllocator() = default;
+
+    template<typename Other>
+    HostAllocator(const HostAllocator<Other>&) { }
+
+    Type* allocate(size_t count)
+    {
+        return static_cast<Type*>(std::malloc(count * sizeof(Type)));
+    }
+
+    void deallocate(Type* ptr, size_t)
+    {
+        std::free(ptr);
+    }
+
+    template<typename Other>
+    bool operator==(const HostAllocator<Other>&) const
+    {
+        return true;
+    }
+};
+
+/** @brief Vector using the C heap
+ */
+template<typename Type>
+using HostVector = std::vector<Type, HostAllocator<Type>>;
+
+namespace SRL
+{
+    /** @brief Recorded allocator call
+     */
+    struct TraceEntry
+    {
+        /** @brief Operation ('M' malloc, 'F' free, 'R' realloc)
+         */
+        char Operation;
+
+        /** @brief Memory zone
+         */
+        uint8_t Zone;
+
+        /** @brief Returned or freed address on the console
+         */
+        uint32_t Address;
+
+        /** @brief Original address of reallocation on the console
+         */
+        uint32_t Previous;
+
+        /** @brief Requested size
+         */
+        uint32_t Size;
+    };
+
+    /** @brief Result of trace replay
+     */
+    struct BenchmarkResult
+    {
+        /** @brief Number of replayed calls
+         */
+        size_t Operations = 0;
+
+        /** @brief Total time spent in allocator in nanoseconds
+         */
+        uint64_t TotalTime = 0;
+
+        /** @brief Slowest call of each operation in nanoseconds (malloc, free, realloc)
+         */
+        uint64_t WorstTime[3] = { 0, 0, 0 };
+
+        /** @brief Allocations that failed in replay but succeeded on the console
+         */
+        size_t FailedAllocations = 0;
+
+        /** @brief Highest fragmentation in percent seen during replay
+         */
+        uint32_t PeakFragmentation = 0;
+
+        /** @brief Fragmentation in percent at the end of replay
+         */
+        uint32_t Fragmentation = 0;
+
+        /** @brief Report of each zone at the end of replay
+         */
+        Memory::Report Reports[3];
+    };
+
+    /** @brief Runs allocators of SRL::Memory on fake zones
+     */
+    class MemoryBenchmark
+    {
+    private:
+        /** @brief Number of calls between fragmentation samples
+         */
+        static constexpr size_t SampleInterval = 64;
+
+        /** @brief Get fragmentation of a zone
+         * @tparam Allocator Allocator under test
+         * @param zone Fake zone
+         * @return Fragmentation in percent
+         */
+        template<typename Allocator>
+        static uint32_t GetFragmentation(const Memory::MemoryZone& zone)
+        {
+            size_t freeSpace = Allocator::GetFreeSize(zone);
+
+            if (freeSpace == 0)
+            {
+                return 0;
+            }
+
+            // Same clamp as Memory::Telemetry::GetFragmentation(), SimpleMalloc largest block can exceed counted free space
+            size_t largest = std::min(Allocator::GetLargestFreeBlock(zone), freeSpace);
+            return 100 - static_cast<uint32_t>((largest * 100) / freeSpace);
+        }
+
+    public:
+        /** @brief Replay trace with one allocator
+         * @tparam Allocator Allocator under test
+         * @param trace Recorded calls
+         * @param zoneSizes Size of each fake zone
+         * @return Replay result
+         */
+        template<typename Allocator>
+        static BenchmarkResult Run(const HostVector<TraceEntry>& trace, const size_t (&zoneSizes)[3])
+        {
+            using Clock = std::chrono::steady_clock;
+
+            BenchmarkResult result;
+            HostVector<uint64_t> storage[3];
+            Memory::MemoryZone zones[3];
+            std::unordered_map<uint64_t, void*, std::hash<uint64_t>, std::equal_to<uint64_t>, HostAllocator<std::pair<const uint64_t, void*>>> live;
+
+            for (size_t zone = 0; zone < 3; zone++)
+            {
+                storage[zone].resize(zoneSizes[zone] / sizeof(uint64_t));
+                zones[zone] = Memory::MemoryZone { Allocator::InitializeZone(storage[zone].data(), zoneSizes[zone]), zoneSizes[zone] };
+            }
+
+            for (const TraceEntry& entry : trace)
+            {
+                if (entry.Operation == 'R' && entry.Address == 0)
+                {
+                    // Reallocation failed on the console and left the block as it was
+                    continue;
+                }
+
+                Memory::MemoryZone& zone = zones[entry.Zone];
+                uint64_t key = (static_cast<uint64_t>(entry.Zone) << 32) | entry.Address;
+                uint64_t previousKey = (static_cast<uint64_t>(entry.Zone) << 32) | entry.Previous;
+                void* previous = nullptr;
+                void* ptr = nullptr;
+                size_t operation = 0;
+
+                if (entry.Operation == 'F' || entry.Operation == 'R')
+                {
+                    auto found = live.find(entry.Operation == 'F' ? key : previousKey);
+
+                    if (found != live.end())
+                    {
+                        previous = found->second;
+                        live.erase(found);
+                    }
+                    else if (entry.Operation == 'F')
+                    {
+                        // Block allocated before recording started
+                        continue;
+                    }
+                }
+
+                auto start = Clock::now();
+
+                switch (entry.Operation)
+                {
+                case 'M':
+                    ptr = Allocator::Malloc(zone, entry.Size);
+                    break;
+
+                case 'F':
+                    Allocator::Free(zone, previous);
+                    operation = 1;
+                    break;
+
+                default:
+                    ptr = Allocator::Realloc(zone, previous, entry.Size);
+                    operation = 2;
+                    break;
+                }
+
+                uint64_t time = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+                result.TotalTime += time;
+                result.WorstTime[operation] = std::max(result.WorstTime[operation], time);
+                result.Operations++;
+
+                if (entry.Operation != 'F')
+                {
+                    if (ptr == nullptr && entry.Address != 0)
+                    {
+                        result.FailedAllocations++;
+
+                        // Original block stays alive when reallocation fails
+                        if (previous != nullptr)
+                        {
+                            live[previousKey] = previous;
+                        }
+                    }
+                    else if (ptr != nullptr && entry.Address == 0)
+                    {
+                        // Allocation failed on the console, so the game never used or freed this block
+                        Allocator::Free(zone, ptr);
+                    }
+                    else if (ptr != nullptr)
+                    {
+                        live[key] = ptr;
+                    }
+                }
+
+                if (result.Operations % MemoryBenchmark::SampleInterval == 0)
+                {
+                    result.PeakFragmentation = std::max(result.PeakFragmentation, MemoryBenchmark::GetFragmentation<Allocator>(zone));
+                }
+            }
+
+            for (size_t zone = 0; zone < 3; zone++)
+            {
+                result.Reports[zone] = Allocator::GetReport(zones[zone]);
+                result.Fragmentation = std::max(result.Fragmentation, MemoryBenchmark::GetFragmentation<Allocator>(zones[zone]));
+            }
+
+            result.PeakFragmentation = std::max(result.PeakFragmentation, result.Fragmentation);
+            return result;
+        }
+
+        /** @brief Replay trace with every allocator and print results
+         * @param trace Recorded calls
+         * @param zoneSizes Size of each fake zone
+         */
+        static void RunAll(const HostVector<TraceEntry>& trace, const size_t (&zoneSizes)[3])
+        {
+            std::printf("%-11s %10s %9s %9s %9s %9s %7s %6s %6s\n",
+                "Allocator", "ops/s", "avg ns", "malloc", "free", "realloc", "failed", "frag", "peak");
+
+            MemoryBenchmark::Print("Simple", MemoryBenchmark::Run<Memory::SimpleMalloc>(trace, zoneSizes));
+            MemoryBenchmark::Print("Segregated", MemoryBenchmark::Run<Memory::SegregatedMalloc>(trace, zoneSizes));
+
+#if defined(USE_TLSF_ALLOCATOR)
+            MemoryBenchmark::Print("TLSF", MemoryBenchmark::Run<Memory::TlsfMalloc>(trace, zoneSizes));
+#endif
+        }
+
+        /** @brief Print replay result
+         * @param name Allocator name
+         * @param result Replay result
+         */
+        static void Print(const char* name, const BenchmarkResult& result)
+        {
+            double seconds = result.TotalTime / 1e9;
+
+            std::printf("%-11s %10.0f %9.1f %9llu %9llu %9llu %7zu %5u%% %5u%%\n",
+                name,
+                seconds > 0 ? result.Operations / seconds : 0.0,
+                result.Operations > 0 ? static_cast<double>(result.TotalTime) / result.Operations : 0.0,
+                static_cast<unsigned long long>(result.WorstTime[0]),
+                static_cast<unsigned long long>(result.WorstTime[1]),
+                static_cast<unsigned long long>(result.WorstTime[2]),
+                result.FailedAllocations,
+                result.Fragmentation,
+                result.PeakFragmentation);
+
+            for (size_t zone = 0; zone < 3; zone++)
+            {
+                const Memory::Report& report = result.Reports[zone];
+
+                if (report.UsedBlocks != 0)
+                {
+                    std::printf("    zone %zu: used blocks %zu, free blocks %zu, free %zu of %zu bytes, headers %zu bytes\n",
+                        zone,
+                        report.UsedBlocks,
+                        report.FreeBlocks,
+                        report.FreeSize,
+                        report.TotalSize,
+                        report.AllocationHeaders);
+                }
+            }
+        }
+    };
+}
+
+/** @brief Read trace from log file
+ * @details Lines not containing a trace record (other log messages) are skipped
+ * @param path Path to the log file
+ * @param trace Read calls
+ * @return true on success
+ */
+static bool ReadTrace(const char* path, HostVector<SRL::TraceEntry>& trace)
+{
+    FILE* file = std::fopen(path, "r");
+
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    char line[256];
+
+    while (std::fgets(line, sizeof(line), file) != nullptr)
+    {
+        const char* record = std::strstr(line, "MT ");
+        SRL::TraceEntry entry;
+        unsigned zone;
+
+        if (record != nullptr &&
+            std::sscanf(record, "MT %c %u %x %x %u", &entry.Operation, &zone, &entry.Address, &entry.Previous, &entry.Size) == 5 &&
+            zone < 3 &&
+            std::strchr("MFR", entry.Operation) != nullptr)
+        {
+            entry.Zone = static_cast<uint8_t>(zone);
+            trace.push_back(entry);
+        }
+    }
+
+    std::fclose(file);
+    return true;
+}
+
+/** @brief Generate game-like workload
+ * @details Mostly small short lived objects, some long lived level data and growing buffers
+ * @param count Number of calls
+ * @param seed Random seed
+ * @param trace Generated calls
+ */
+static void GenerateTrace(size_t count, uint32_t seed, HostVector<SRL::TraceEntry>& trace)
+{
+    std::mt19937 random(seed);
+    HostVector<std::pair<uint32_t, uint32_t>> live;
+    uint32_t nextAddress = 0x06000000;
+
+    while (trace.size() < count)
+    {
+        uint32_t roll = random() % 100;
+
+        if (roll < 50 || live.empty())
+        {
+            // Size classes from a few bytes up to 16KB, smaller ones are much more common
+            uint32_t size = 4 + (random() % (16u << (random() % 11)));
+            nextAddress += 4;
+            trace.push_back({ 'M', 0, nextAddress, 0, size });
+            live.emplace_back(nextAddress, size);
+        }
+        else if (roll < 95)
+        {
+            size_t index = random() % live.size();
+            trace.push_back({ 'F', 0, live[index].first, 0, 0 });
+            live[index] = live.back();
+            live.pop_back();
+        }
+        else
+        {
+            size_t index = random() % live.size();
+            uint32_t size = std::min(live[index].second + (live[index].second / 2) + 16, 65536u);
+            nextAddress += 4;
+            trace.push_back({ 'R', 0, nextAddress, live[index].first, size });
+            live[index] = { nextAddress, size };
+        }
+
+        // Keep the live set within the zone
+        while (live.size() > 256)
+        {
+            trace.push_back({ 'F', 0, live.front().first, 0, 0 });
+            live.front() = live.back();
+            live.pop_back();
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    size_t zoneSizes[3] = { 1024 * 1024, 1024 * 1024, 4 * 1024 * 1024 };
+    HostVector<SRL::TraceEntry> trace;
+    const char* path = nullptr;
+    size_t synthetic = 200000;
+    uint32_t seed = 1;
+
+    for (int argument = 1; argument < argc; argument++)
+    {
+        if (std::strcmp(argv[argument], "--zone-size") == 0 && argument + 1 < argc)
+        {
+            size_t size = std::strtoul(argv[++argument], nullptr, 0);
+            std::fill(std::begin(zoneSizes), std::end(zoneSizes), size & ~static_cast<size_t>(7));
+        }
+        else if (std::strcmp(argv[argument], "--synthetic") == 0 && argument + 1 < argc)
+        {
+            synthetic = std::strtoul(argv[++argument], nullptr, 0);
+        }
+        else if (std::strcmp(argv[argument], "--seed") == 0 && argument + 1 < argc)
+        {
+            seed = std::strtoul(argv[++argument], nullptr, 0);
+        }
+        else if (argv[argument][0] != '-')
+        {
+            path = argv[argument];
+        }
+        else
+        {
+            std::printf("Usage: %s [trace.log] [--zone-size bytes] [--synthetic calls] [--seed number]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (path != nullptr)
+    {
+        if (!ReadTrace(path, trace))
+        {
+            std::printf("Cannot open %s\n", path);
+            return 1;
+        }
+
+        std::printf("Trace %s: %zu calls\n", path, trace.size());
+    }
+    else
+    {
+        GenerateTrace(synthetic, seed, trace);
+        std::printf("Synthetic workload: %zu calls, seed %u\n", trace.size(), seed);
+    }
+
+    std::printf("Zones: HWRam %zu, LWRam %zu, CartRam %zu bytes, pointer size %zu\n\n", zoneSizes[0], zoneSizes[1], zoneSizes[2], sizeof(void*));
+    SRL::MemoryBenchmark::RunAll(trace, zoneSizes);
+    return 0;
+}
@@ -0,0 +1,165 @@
+import argparse
+import struct
+import sys
+
+# Compressed file layout (numbers are big-endian, same as Saturn):
+#   Header : magic "SRLZ", decompressed size (u32), compressed block size (u32)
+#   Block  : LZ4 block format
+# Must match SRL::Lz4 in saturnringlib/srl_lz4.hpp
+
+MAGIC = b"SRLZ"
+HEADER = struct.Struct(">4sII")
+MIN_MATCH = 4
+MAX_OFFSET = 65535
+
+# LZ4 block rules: last 5 bytes are always literals and last match must start 12 bytes before the end
+LAST_LITERALS = 5
+MATCH_LIMIT = 12
+
+
+def write_length(output, length):
+    while length >= 255:
+        output.append(255)
+        length -= 255
+
+    output.append(length)
+
+
+def write_sequence(output, literals, match_length, offset):
+    literal_length = len(literals)
+    token = min(literal_length, 15) << 4
+
+    if match_length is not None:
+        token |= min(match_length - MIN_MATCH, 15)
+
+    output.append(token)
+
+    if literal_length >= 15:
+        write_length(output, literal_length - 15)
+
+    output += literals
+
+    if match_length is not None:
+        output += struct.pack("<H", offset)
+
+        if match_length - MIN_MATCH >= 15:
+            write_length(output, match_length - MIN_MATCH - 15)
+
+
+def compress_block(data, depth):
+    """Compress data into LZ4 block, matches are searched in hash chains of given depth"""
+    output = bytearray()
+    size = len(data)
+    head = {}
+    chain = [0] * size
+    anchor = 0
+    position = 0
+    match_end = size - LAST_LITERALS
+
+    def insert(index):
+        key = data[index:index + MIN_MATCH]
+        chain[index] = head.get(key, -1)
+        head[key] = index
+
+    while position < size - MATCH_LIMIT:
+        best_length = 0
+        best_offset = 0
+        candidate = head.get(data[position:position + MIN_MATCH], -1)
+        tries = depth
+
+        while candidate >= 0 and position - candidate <= MAX_OFFSET and tries > 0:
+            length = 0
+            limit = match_end - position
+
+            while length < limit and data[candidate + length] == data[position + length]:
+                length += 1
+
+            if length > best_length:
+                best_length = length
+                best_offset = position - candidate
+
+            candidate = chain[candidate]
+            tries -= 1
+
+        if best_length < MIN_MATCH:
+            insert(position)
+            position += 1
+            continue
+
+        write_sequence(output, data[anchor:position], best_length, best_offset)
+
+        for index in range(position, min(position + best_length, size - MIN_MATCH)):
+            insert(index)
+
+        position += best_length
+        anchor = position
+
+    write_sequence(output, data[anchor:], None, 0)
+    return bytes(output)
+
+
+def decompress_block(block, size):
+    """Reference decoder used to verify output"""
+    output = bytearray()
+    position = 0
+
+    while position < len(block):
+        token = block[position]
+        position += 1
+        length = token >> 4
+
+        if length == 15:
+            while True:
+                extra = block[position]
+                position += 1
+                length += extra
+
+                if extra != 255:
+                    break
+
+        output += block[position:position + length]
+        position += length
+
+        if position >= len(block):
+            break
+
+        offset = block[position] | (block[position + 1] << 8)
+        position += 2
+        length = token & 15
+
+        if length == 15:
+            while True:
+                extra = block[position]
+                position += 1
+                length += extra
+
+                if extra != 255:
+                    break
+
+        for index in range(length + MIN_MATCH):
+            output.append(output[-offset])
+
+    return bytes(output[:size])
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Compress file for SRL::Lz4")
+    parser.add_argument("input", help="File to compress")
+    parser.add_argument("output", help="Compressed file")
+    parser.add_argument("--depth", type=int, default=16, help="Number of match candidates to try (higher is slower and smaller)")
+    args = parser.parse_args()
+
+    with open(args.input, "rb") as file:
+        data = file.read()
+
+    block = compress_block(data, max(args.depth, 1))
+
+    if decompress_block(block, len(data)) != data:
+        sys.exit("srl_compress: verification of '%s' failed" % args.input)
+
+    with open(args.output, "wb") as file:
+        file.write(HEADER.pack(MAGIC, len(data), len(block)))
+        file.write(block)
+
+    ratio = (100.0 * (len(block) + HEADER.size) / len(data)) if len(data) > 0 else 100.0
+    print("srl_compress: %s, %d -> %d bytes (%.1f%%)" % (args.output, len(data), len(block) + HEADER.size, ratio))
@@ -0,0 +1,155 @@
+import argparse
+import os
+import re
+import sys
+
+# Generates file order for the ISO from file access traces recorded by SRL::Logger::LogCdTrace
+# Trace line: "CT <operation> <frame> <identifier> <name> <offset> <size>"
+#   operation : D = change directory, O = open, S = seek, R = read, L = load
+#   name      : ISO name of file or directory, "-" for root directory
+#               files opened through SRL::Cd::PathIndex have full path from root directory, changed directory can be a path
+# Output is a sort file for 'xorrisofs -sort', files with higher weight are placed closer to the start of the disc.
+
+TRACE = re.compile(r"CT ([DOSRL]) (\d+) (-?\d+) (\S+) (-?\d+) (-?\d+)")
+
+
+def normalize(name):
+    """ISO names carry version suffix, compare them without it and case insensitive"""
+    return name.split(";")[0].upper()
+
+
+def collect_files(directory):
+    files = {}
+
+    for root, dirs, names in os.walk(directory):
+        dirs.sort()
+
+        for name in sorted(names):
+            full_path = os.path.join(root, name)
+            files[normalize(os.path.relpath(full_path, directory).replace(os.sep, "/"))] = full_path
+
+    return files
+
+
+def read_session(trace_file):
+    """Read file accesses of one play session as list of (frame, path)"""
+    accesses = []
+    directory = []
+
+    with open(trace_file, "r", errors="replace") as file:
+        for line in file:
+            match = TRACE.search(line)
+
+            if match is None:
+                continue
+
+            operation, frame, identifier, name, offset, size = match.groups()
+
+            if operation == "D":
+                if name == "-" or name.startswith("/"):
+                    directory = []
+
+                for part in name.replace("\\", "/").split("/"):
+                    if part == "..":
+                        directory = directory[:-1]
+                    elif part not in ("", ".", "-"):
+                        directory.append(normalize(part))
+
+                continue
+
+            if name == "-":
+                continue
+
+            if "/" in name:
+                # Full path from root directory
+                accesses.append((int(frame), "/".join(normalize(part) for part in name.split("/") if part)))
+            else:
+                accesses.append((int(frame), "/".join(directory + [normalize(name)])))
+
+    return accesses
+
+
+def analyze(sessions, window):
+    """Get average relative time of first access and co-access affinity of every traced file"""
+    first_access = {}
+    affinity = {}
+
+    for accesses in sessions:
+        if not accesses:
+            continue
+
+        start = accesses[0][0]
+        length = max(accesses[-1][0] - start, 1)
+        seen = set()
+
+        for frame, path in accesses:
+            if path not in seen:
+                seen.add(path)
+                first_access.setdefault(path, []).append((frame - start) / length)
+
+        # Files read shortly after each other should be next to each other on the disc
+        for (frame, path), (next_frame, next_path) in zip(accesses, accesses[1:]):
+            if path != next_path and next_frame - frame <= window:
+                affinity.setdefault(path, {})
+                affinity.setdefault(next_path, {})
+                affinity[path][next_path] = affinity[path].get(next_path, 0) + 1
+                affinity[next_path][path] = affinity[next_path].get(path, 0) + 1
+
+    first_access = {path: sum(times) / len(times) for path, times in first_access.items()}
+    return first_access, affinity
+
+
+def order_files(first_access, affinity):
+    """Chain files greedily by strongest affinity, start new chain with earliest remaining file when chain ends"""
+    remaining = set(first_access)
+    order = []
+
+    def earliest():
+        return min(remaining, key=lambda path: (first_access[path], path))
+
+    current = None
+
+    while remaining:
+        candidates = [(count, path) for path, count in affinity.get(current, {}).items() if path in remaining]
+
+        if candidates:
+            current = max(candidates, key=lambda candidate: (candidate[0], -first_access[candidate[1]]))[1]
+        else:
+            current = earliest()
+
+        remaining.remove(current)
+        order.append(current)
+
+    return order
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Order files on the disc by access traces (see SRL::Cd::SetTraceHandler)")
+    parser.add_argument("traces", nargs="+", help="Log files with traces, one per play session")
+    parser.add_argument("-o", "--output", default="./cd/sort.txt", help="Sort file for xorrisofs")
+    parser.add_argument("--data-dir", default="./cd/data", help="Directory with files of the disc")
+    parser.add_argument("--window", type=int, default=60, help="Frames between accesses to count files as used together")
+    parser.add_argument("--verbose", action="store_true", help="Print resulting order")
+    args = parser.parse_args()
+
+    if not os.path.isdir(args.data_dir):
+        sys.exit("srl_disc_order: '%s' is not a directory" % args.data_dir)
+
+    files = collect_files(args.data_dir)
+    sessions = [read_session(trace) for trace in args.traces]
+    first_access, affinity = analyze(sessions, max(args.window, 0))
+
+    for path in sorted(path for path in first_access if path not in files):
+        print("srl_disc_order: '%s' is not in '%s', ignored" % (path, args.data_dir))
+        del first_access[path]
+
+    order = order_files(first_access, affinity)
+
+    with open(args.output, "w") as file:
+        for index, path in enumerate(order):
+            file.write("%s %d\n" % (files[path], len(order) - index))
+
+            if args.verbose:
+                print("  %4d %-40s %.3f" % (index, path, first_access[path]))
+
+    print("srl_disc_order: %s, %d of %d files ordered from %d sessions" % (args.output, len(order), len(files), len(sessions)))
@@ -0,0 +1,95 @@
+import argparse
+import os
+import struct
+import sys
+
+# Interleaved stream layout (numbers are big-endian, same as Saturn):
+#   Every 2048 byte sector : channel (u8), flags (u8), payload size (u16), payload (up to 2044 bytes, zero padded)
+#   Flags                  : 0x01 = last sector of the channel
+# Channels are mixed by their weight, channel with weight 3 gets 3 sectors for each sector of channel with weight 1.
+# Must match SRL::Stream in saturnringlib/srl_stream.hpp
+
+SECTOR_SIZE = 2048
+HEADER = struct.Struct(">BBH")
+PAYLOAD_SIZE = SECTOR_SIZE - HEADER.size
+MAX_CHANNELS = 16
+END_OF_CHANNEL = 0x01
+
+
+def parse_channel(text):
+    """Parse 'number:file[:weight]'"""
+    parts = text.split(":")
+
+    if len(parts) not in (2, 3):
+        raise argparse.ArgumentTypeError("channel must be number:file[:weight], got '%s'" % text)
+
+    number = int(parts[0])
+    weight = int(parts[2]) if len(parts) == 3 else 1
+
+    if number < 0 or number >= MAX_CHANNELS:
+        raise argparse.ArgumentTypeError("channel number must be 0 to %d" % (MAX_CHANNELS - 1))
+
+    if weight < 1:
+        raise argparse.ArgumentTypeError("channel weight must be at least 1")
+
+    return number, parts[1], weight
+
+
+def interleave(channels):
+    """Yield (channel number, flags, payload) for every sector"""
+    queues = []
+
+    for number, path, weight in channels:
+        with open(path, "rb") as file:
+            data = file.read()
+
+        chunks = [data[offset:offset + PAYLOAD_SIZE] for offset in range(0, len(data), PAYLOAD_SIZE)] or [b""]
+        queues.append([number, weight, chunks, 0])
+
+    # Weighted round robin, every channel gets its share of each cycle until it runs out of data
+    while any(queue[3] < len(queue[2]) for queue in queues):
+        for queue in queues:
+            number, weight, chunks, position = queue
+
+            for _ in range(weight):
+                if position >= len(chunks):
+                    break
+
+                flags = END_OF_CHANNEL if position == len(chunks) - 1 else 0
+                yield number, flags, chunks[position]
+                position += 1
+
+            queue[3] = position
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Interleave files into a stream for SRL::Stream")
+    parser.add_argument("output", help="Interleaved stream file")
+    parser.add_argument("-c", "--channel", dest="channels", action="append", type=parse_channel, required=True,
+                        help="Channel as number:file[:weight], weight is number of sectors per cycle (default 1)")
+    parser.add_argument("--verbose", action="store_true", help="Print sector map")
+    args = parser.parse_args()
+
+    numbers = [number for number, path, weight in args.channels]
+
+    if len(set(numbers)) != len(numbers):
+        sys.exit("srl_interleave: channel numbers must be unique")
+
+    for number, path, weight in args.channels:
+        if not os.path.isfile(path):
+            sys.exit("srl_interleave: '%s' is not a file" % path)
+
+    sectors = 0
+
+    with open(args.output, "wb") as stream:
+        for number, flags, payload in interleave(args.channels):
+            stream.write(HEADER.pack(number, flags, len(payload)))
+            stream.write(payload)
+            stream.write(b"\0" * (PAYLOAD_SIZE - len(payload)))
+
+            if args.verbose:
+                print("  %6d channel %2d %4d bytes%s" % (sectors, number, len(payload), " end" if flags & END_OF_CHANNEL else ""))
+
+            sectors += 1
+
+    print("srl_interleave: %s, %d channels, %d sectors" % (args.output, len(args.channels), sectors))
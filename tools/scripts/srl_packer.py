@@ -0,0 +1,118 @@
+import argparse
+import os
+import struct
+import sys
+
+# Pack file layout (all numbers are big-endian, same as Saturn):
+#   Header   : magic "SRLP", version (u16), reserved (u16), slot count (u32), entry count (u32), TOC sectors (u32)
+#   Slots    : slot count * { path hash (u32), first sector (u32), size in bytes (u32) }, empty slot has sector 0
+#   Entries  : each entry starts at a sector boundary, after the table of contents
+# Slot count is a power of two, runtime finds entry by linear probing from (hash & (slot count - 1)).
+# Must match SRL::Cd::Pack in saturnringlib/srl_cd.hpp
+
+SECTOR_SIZE = 2048
+MAGIC = b"SRLP"
+VERSION = 1
+HEADER = struct.Struct(">4sHHIII")
+SLOT = struct.Struct(">III")
+
+
+def path_hash(path):
+    """FNV-1a hash of upper case path with '/' separators"""
+    value = 2166136261
+
+    for char in path.replace("\\", "/").upper().encode("ascii"):
+        value ^= char
+        value = (value * 16777619) & 0xFFFFFFFF
+
+    return value
+
+
+def sectors(size):
+    return (size + SECTOR_SIZE - 1) // SECTOR_SIZE
+
+
+def collect_files(directory, order_file):
+    files = []
+
+    for root, dirs, names in os.walk(directory):
+        dirs.sort()
+
+        for name in sorted(names):
+            full_path = os.path.join(root, name)
+            files.append((os.path.relpath(full_path, directory).replace(os.sep, "/"), full_path))
+
+    if order_file is not None:
+        # Files listed in order file go first, in that order, rest stay sorted by path
+        with open(order_file, "r") as file:
+            order = [line.strip().upper() for line in file if line.strip() and not line.startswith("#")]
+
+        rank = {path: index for index, path in enumerate(order)}
+        files.sort(key=lambda entry: rank.get(entry[0].upper(), len(order)))
+
+    return files
+
+
+def build_pack(directory, output, order_file=None, verbose=False):
+    files = collect_files(directory, order_file)
+    slot_count = 1
+
+    # Keep table at most half full, so probing stays short
+    while slot_count < len(files) * 2:
+        slot_count *= 2
+
+    toc_sectors = sectors(HEADER.size + (slot_count * SLOT.size))
+    slots = [None] * slot_count
+    sector = toc_sectors
+    hashes = {}
+
+    for path, full_path in files:
+        value = path_hash(path)
+
+        if value in hashes:
+            sys.exit("srl_packer: '%s' and '%s' have same hash 0x%08x, rename one of them" % (hashes[value], path, value))
+
+        hashes[value] = path
+        size = os.path.getsize(full_path)
+        index = value & (slot_count - 1)
+
+        while slots[index] is not None:
+            index = (index + 1) & (slot_count - 1)
+
+        slots[index] = (value, sector, size, full_path)
+
+        if verbose:
+            print("  %-40s 0x%08x sector %6d %8d bytes" % (path, value, sector, size))
+
+        sector += max(sectors(size), 1)
+
+    with open(output, "wb") as pack:
+        pack.write(HEADER.pack(MAGIC, VERSION, 0, slot_count, len(files), toc_sectors))
+
+        for slot in slots:
+            pack.write(SLOT.pack(*slot[:3]) if slot is not None else SLOT.pack(0, 0, 0))
+
+        # Entries in order of their sectors
+        for value, start, size, full_path in sorted((slot for slot in slots if slot is not None), key=lambda slot: slot[1]):
+            pack.write(b"\0" * ((start * SECTOR_SIZE) - pack.tell()))
+
+            with open(full_path, "rb") as file:
+                pack.write(file.read())
+
+        pack.write(b"\0" * ((sector * SECTOR_SIZE) - pack.tell()))
+
+    print("srl_packer: %s, %d files, %d sectors" % (output, len(files), sector))
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Pack directory into a sector aligned SaturnRingLib pack file")
+    parser.add_argument("directory", help="Directory to pack, paths inside the pack are relative to it")
+    parser.add_argument("output", help="Output pack file")
+    parser.add_argument("--order", help="Text file with paths to place first, one per line")
+    parser.add_argument("--verbose", action="store_true", help="Print table of contents")
+    args = parser.parse_args()
+
+    if not os.path.isdir(args.directory):
+        sys.exit("srl_packer: '%s' is not a directory" % args.directory)
+
+    build_pack(args.directory, args.output, args.order, args.verbose)